@@ -0,0 +1,396 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "benchDrivers.h"
+#include "concurrentContainers.h"
+#include "lockFreeList.h"
+#include "lookupCache.h"
+#include "recordArena.h"
+#include "student.h"
+#include "product.h"
+
+/*
+ * benchDrivers.c
+ *
+ * Adapters between the benchmark harness and the containers under test,
+ * plus the synthetic Student/Product record generators. The concurrent
+ * drivers wrap thread-safe containers only: the "threads" suite calls
+ * them from several threads at once.
+ */
+
+
+/* --- OrderedArray --- */
+
+static void* _oa_create(long expected_size, const RecordKind* kind){
+    return oa_create((int)expected_size, kind->compare);
+}
+static int _oa_insert(void* c, void* data){ return oa_insert_sorted((OrderedArray*)c, data); }
+static void* _oa_find(void* c, void* key){ return oa_find_binary((OrderedArray*)c, key); }
+static void* _oa_remove(void* c, void* key){ return oa_remove((OrderedArray*)c, key); }
+static void _oa_destroy(void* c){ oa_free((OrderedArray*)c); }
+static void* _oa_keyed_create(long expected_size, const RecordKind* kind){
+    return oa_create_keyed((int)expected_size, kind->key_of);
+}
+static int _oa_insert_batch(void* c, void** items, int count){ return oa_insert_batch((OrderedArray*)c, items, count); }
+static int _oa_find_batch(void* c, void** keys, int count, void** results){
+    return oa_find_batch((OrderedArray*)c, keys, count, results);
+}
+
+static int _oa_range(void* c, void* low, void* high, VisitFunc visit, void* context){
+    return oa_range((OrderedArray*)c, low, high, visit, context);
+}
+
+/*Starts at capacity 1 so the build phase pays for every doubling*/
+static void* _oa_growable_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    OrderedArray* arr = oa_create(1, kind->compare);
+    if(arr != NULL) oa_set_growth(arr, 1, 0.25f);
+    return arr;
+}
+
+/*Plain OrderedArray plus a hash index: finds skip the binary search*/
+static void* _oa_hashed_create(long expected_size, const RecordKind* kind){
+    OrderedArray* arr = oa_create((int)expected_size, kind->compare);
+    if(arr != NULL && !oa_attach_hash_index(arr, kind->key_of)){
+        oa_free(arr);
+        return NULL;
+    }
+    return arr;
+}
+
+/*Plain OrderedArray behind a lookup cache: hot keys skip the binary search*/
+static void* _oa_cached_create(long expected_size, const RecordKind* kind){
+    OrderedArray* arr = oa_create((int)expected_size, kind->compare);
+    if(arr != NULL && !oa_attach_lookup_cache(arr, LC_DEFAULT_SLOTS, kind->key_of)){
+        oa_free(arr);
+        return NULL;
+    }
+    return arr;
+}
+
+/* --- TieredArray --- */
+
+static void* _ta_create(long expected_size, const RecordKind* kind){
+    return ta_create((int)expected_size, kind->compare);
+}
+static int _ta_insert(void* c, void* data){ return ta_insert_sorted((TieredArray*)c, data); }
+static void* _ta_find(void* c, void* key){ return ta_find((TieredArray*)c, key); }
+static void* _ta_remove(void* c, void* key){ return ta_remove((TieredArray*)c, key); }
+static void _ta_destroy(void* c){ ta_free((TieredArray*)c); }
+static int _ta_range(void* c, void* low, void* high, VisitFunc visit, void* context){
+    return ta_range((TieredArray*)c, low, high, visit, context);
+}
+
+/* --- LinkedList --- */
+
+static void* _list_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return list_create(kind->compare);
+}
+static void* _list_pooled_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return list_create_pooled(kind->compare, LIST_DEFAULT_SLAB_SIZE);
+}
+static void* _list_keyed_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return list_create_keyed(kind->key_of, 0);
+}
+static void* _list_hashed_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    LinkedList* list = list_create_pooled(kind->compare, LIST_DEFAULT_SLAB_SIZE);
+    if(list != NULL && !list_attach_hash_index(list, kind->key_of)){
+        list_free(list);
+        return NULL;
+    }
+    return list;
+}
+static void* _list_cached_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    LinkedList* list = list_create_pooled(kind->compare, LIST_DEFAULT_SLAB_SIZE);
+    if(list != NULL && !list_attach_lookup_cache(list, LC_DEFAULT_SLOTS, kind->key_of)){
+        list_free(list);
+        return NULL;
+    }
+    return list;
+}
+static int _list_insert(void* c, void* data){ return list_insert_sorted((LinkedList*)c, data); }
+static void* _list_find(void* c, void* key){ return list_find_linear((LinkedList*)c, key); }
+static void* _list_remove(void* c, void* key){ return list_remove((LinkedList*)c, key); }
+static void _list_destroy(void* c){ list_free((LinkedList*)c); }
+static int _list_find_batch(void* c, void** keys, int count, void** results){
+    return list_find_batch((LinkedList*)c, keys, count, results);
+}
+static int _list_range(void* c, void* low, void* high, VisitFunc visit, void* context){
+    return list_range((LinkedList*)c, low, high, visit, context);
+}
+
+/* --- UnrolledList --- */
+
+static void* _ul_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return ul_create(kind->compare);
+}
+static int _ul_insert(void* c, void* data){ return ul_insert_sorted((UnrolledList*)c, data); }
+static void* _ul_find(void* c, void* key){ return ul_find((UnrolledList*)c, key); }
+static void* _ul_remove(void* c, void* key){ return ul_remove((UnrolledList*)c, key); }
+static void _ul_destroy(void* c){ ul_free((UnrolledList*)c); }
+static int _ul_range(void* c, void* low, void* high, VisitFunc visit, void* context){
+    return ul_range((UnrolledList*)c, low, high, visit, context);
+}
+
+/* --- SkipList --- */
+
+static void* _sl_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return sl_create(kind->compare);
+}
+static int _sl_insert(void* c, void* data){ return sl_insert_sorted((SkipList*)c, data); }
+static void* _sl_find(void* c, void* key){ return sl_find((SkipList*)c, key); }
+static void* _sl_remove(void* c, void* key){ return sl_remove((SkipList*)c, key); }
+static void _sl_destroy(void* c){ sl_free((SkipList*)c); }
+static int _sl_range(void* c, void* low, void* high, VisitFunc visit, void* context){
+    return sl_range((SkipList*)c, low, high, visit, context);
+}
+
+/* --- BPlusTree --- */
+
+static void* _bpt_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return bpt_create(kind->compare);
+}
+static int _bpt_insert(void* c, void* data){ return bpt_insert((BPlusTree*)c, data); }
+static void* _bpt_find(void* c, void* key){ return bpt_find((BPlusTree*)c, key); }
+static void* _bpt_remove(void* c, void* key){ return bpt_remove((BPlusTree*)c, key); }
+static void _bpt_destroy(void* c){ bpt_free((BPlusTree*)c); }
+static int _bpt_load_sorted(void* c, void** sorted, int count){ return bpt_bulk_load((BPlusTree*)c, sorted, count); }
+static int _bpt_range(void* c, void* low, void* high, VisitFunc visit, void* context){
+    return bpt_range((BPlusTree*)c, low, high, visit, context);
+}
+
+static const BenchDriver DRIVERS[] = {
+    {"ordered_array", 0, 0, _oa_create, _oa_insert, _oa_find, _oa_remove, _oa_destroy, _oa_insert_batch, NULL, _oa_find_batch, _oa_range},
+    {"oa_growable", 0, 0, _oa_growable_create, _oa_insert, _oa_find, _oa_remove, _oa_destroy, _oa_insert_batch, NULL, _oa_find_batch, _oa_range},
+    {"oa_keyed", 0, 0, _oa_keyed_create, _oa_insert, _oa_find, _oa_remove, _oa_destroy, _oa_insert_batch, NULL, _oa_find_batch, _oa_range},
+    {"oa_hashed", 0, 0, _oa_hashed_create, _oa_insert, _oa_find, _oa_remove, _oa_destroy, _oa_insert_batch, NULL, _oa_find_batch, _oa_range},
+    {"oa_cached", 0, 0, _oa_cached_create, _oa_insert, _oa_find, _oa_remove, _oa_destroy, _oa_insert_batch, NULL, _oa_find_batch, _oa_range},
+    {"tiered_array", 0, 0, _ta_create, _ta_insert, _ta_find, _ta_remove, _ta_destroy, NULL, NULL, NULL, _ta_range},
+    {"linked_list", 1, 1, _list_create, _list_insert, _list_find, _list_remove, _list_destroy, NULL, NULL, _list_find_batch, _list_range},
+    {"list_pooled", 1, 1, _list_pooled_create, _list_insert, _list_find, _list_remove, _list_destroy, NULL, NULL, _list_find_batch, _list_range},
+    {"list_keyed", 1, 1, _list_keyed_create, _list_insert, _list_find, _list_remove, _list_destroy, NULL, NULL, _list_find_batch, _list_range},
+    {"list_hashed", 1, 1, _list_hashed_create, _list_insert, _list_find, _list_remove, _list_destroy, NULL, NULL, _list_find_batch, _list_range},
+    {"list_cached", 1, 1, _list_cached_create, _list_insert, _list_find, _list_remove, _list_destroy, NULL, NULL, _list_find_batch, _list_range},
+    {"unrolled_list", 1, 1, _ul_create, _ul_insert, _ul_find, _ul_remove, _ul_destroy, NULL, NULL, NULL, _ul_range},
+    {"skip_list", 0, 0, _sl_create, _sl_insert, _sl_find, _sl_remove, _sl_destroy, NULL, NULL, NULL, _sl_range},
+    {"bplus_tree", 0, 0, _bpt_create, _bpt_insert, _bpt_find, _bpt_remove, _bpt_destroy, NULL, _bpt_load_sorted, NULL, _bpt_range},
+};
+
+int bench_driver_count(void){
+    return (int)(sizeof(DRIVERS) / sizeof(DRIVERS[0]));
+}
+
+const BenchDriver* bench_driver_at(int index){
+    if(index < 0 || index >= bench_driver_count()) return NULL;
+    return &DRIVERS[index];
+}
+
+const BenchDriver* bench_driver_find(const char* name){
+    for(int i = 0; i < bench_driver_count(); i++){
+        if(strcmp(DRIVERS[i].name, name) == 0) return &DRIVERS[i];
+    }
+    return NULL;
+}
+
+/* --- Thread-safe containers --- */
+
+/*Baseline: one OrderedArray behind a single mutex, as callers do without concurrent wrappers*/
+typedef struct{
+    OrderedArray* arr;
+    pthread_mutex_t lock;
+}LockedOA;
+
+static void* _locked_oa_create(long expected_size, const RecordKind* kind){
+    LockedOA* locked = (LockedOA*)malloc(sizeof(LockedOA));
+    if(locked == NULL) return NULL;
+    locked->arr = oa_create_keyed((int)expected_size, kind->key_of);
+    if(locked->arr == NULL || pthread_mutex_init(&locked->lock, NULL) != 0){
+        oa_free(locked->arr);
+        free(locked);
+        return NULL;
+    }
+    oa_set_growth(locked->arr, 1, 0.0f);
+    return locked;
+}
+static int _locked_oa_insert(void* c, void* data){
+    LockedOA* locked = (LockedOA*)c;
+    pthread_mutex_lock(&locked->lock);
+    int inserted = oa_insert_sorted(locked->arr, data);
+    pthread_mutex_unlock(&locked->lock);
+    return inserted;
+}
+static void* _locked_oa_find(void* c, void* key){
+    LockedOA* locked = (LockedOA*)c;
+    pthread_mutex_lock(&locked->lock);
+    void* found = oa_find_binary(locked->arr, key);
+    pthread_mutex_unlock(&locked->lock);
+    return found;
+}
+static void* _locked_oa_remove(void* c, void* key){
+    LockedOA* locked = (LockedOA*)c;
+    pthread_mutex_lock(&locked->lock);
+    void* removed = oa_remove(locked->arr, key);
+    pthread_mutex_unlock(&locked->lock);
+    return removed;
+}
+static void _locked_oa_destroy(void* c){
+    LockedOA* locked = (LockedOA*)c;
+    pthread_mutex_destroy(&locked->lock);
+    oa_free(locked->arr);
+    free(locked);
+}
+
+static void* _coa_create(long expected_size, const RecordKind* kind){
+    ConcurrentOA* coa = coa_create_keyed((int)expected_size, kind->key_of);
+    if(coa != NULL) oa_set_growth(coa->arr, 1, 0.0f);
+    return coa;
+}
+static int _coa_insert(void* c, void* data){ return coa_insert((ConcurrentOA*)c, data); }
+static void* _coa_find(void* c, void* key){ return coa_find((ConcurrentOA*)c, key); }
+static void* _coa_remove(void* c, void* key){ return coa_remove((ConcurrentOA*)c, key); }
+static void _coa_destroy(void* c){ coa_free((ConcurrentOA*)c); }
+
+/*The harness uses ids in [0, 2 * size]: split that range evenly*/
+static void* _shoa_create(long expected_size, const RecordKind* kind){
+    return shoa_create(kind->key_of, 0, 2 * expected_size + 2, CONC_DEFAULT_SHARDS);
+}
+static int _shoa_insert(void* c, void* data){ return shoa_insert((ShardedOA*)c, data); }
+static void* _shoa_find(void* c, void* key){ return shoa_find((ShardedOA*)c, key); }
+static void* _shoa_remove(void* c, void* key){ return shoa_remove((ShardedOA*)c, key); }
+static void _shoa_destroy(void* c){ shoa_free((ShardedOA*)c); }
+
+static void* _shlist_create(long expected_size, const RecordKind* kind){
+    return shlist_create(kind->key_of, 0, 2 * expected_size + 2, CONC_DEFAULT_SHARDS);
+}
+static int _shlist_insert(void* c, void* data){ return shlist_insert((ShardedList*)c, data); }
+static void* _shlist_find(void* c, void* key){ return shlist_find((ShardedList*)c, key); }
+static void* _shlist_remove(void* c, void* key){ return shlist_remove((ShardedList*)c, key); }
+static void _shlist_destroy(void* c){ shlist_free((ShardedList*)c); }
+
+static void* _lfl_create(long expected_size, const RecordKind* kind){
+    (void)expected_size;
+    return lfl_create_keyed(kind->key_of);
+}
+static int _lfl_insert(void* c, void* data){ return lfl_insert_sorted((LockFreeList*)c, data); }
+static void* _lfl_find(void* c, void* key){ return lfl_find((LockFreeList*)c, key); }
+static void* _lfl_remove(void* c, void* key){ return lfl_remove((LockFreeList*)c, key); }
+static void _lfl_destroy(void* c){
+    lfl_free((LockFreeList*)c);
+    lfl_collect();
+}
+
+static const BenchDriver CONCURRENT_DRIVERS[] = {
+    {"locked_oa", 0, 0, _locked_oa_create, _locked_oa_insert, _locked_oa_find, _locked_oa_remove, _locked_oa_destroy, NULL, NULL, NULL, NULL},
+    {"rwlock_oa", 0, 0, _coa_create, _coa_insert, _coa_find, _coa_remove, _coa_destroy, NULL, NULL, NULL, NULL},
+    {"sharded_oa", 0, 0, _shoa_create, _shoa_insert, _shoa_find, _shoa_remove, _shoa_destroy, NULL, NULL, NULL, NULL},
+    {"sharded_list", 1, 1, _shlist_create, _shlist_insert, _shlist_find, _shlist_remove, _shlist_destroy, NULL, NULL, NULL, NULL},
+    {"lockfree_list", 1, 1, _lfl_create, _lfl_insert, _lfl_find, _lfl_remove, _lfl_destroy, NULL, NULL, NULL, NULL},
+};
+
+int bench_concurrent_count(void){
+    return (int)(sizeof(CONCURRENT_DRIVERS) / sizeof(CONCURRENT_DRIVERS[0]));
+}
+
+const BenchDriver* bench_concurrent_at(int index){
+    if(index < 0 || index >= bench_concurrent_count()) return NULL;
+    return &CONCURRENT_DRIVERS[index];
+}
+
+/* --- Synthetic records --- */
+
+/*Distinct synthetic names per record type: like first names, they repeat*/
+#define BENCH_NAMES 4096
+
+/*Owner of the synthetic names (records are generated in place, in the harness' own buffers)*/
+static RecordArena* bench_names = NULL;
+
+/**
+ * @brief (Private) Interned name of a synthetic record, e.g. "Student 17".
+ */
+static const char* _bench_name(const char* prefix, long id){
+    char name[32];
+    snprintf(name, sizeof(name), "%s %ld", prefix, id % BENCH_NAMES);
+    if(bench_names == NULL) bench_names = ra_create(0);
+    const char* interned = ra_intern(bench_names, name);
+    return interned != NULL ? interned : prefix;
+}
+
+void bench_records_release(void){
+    ra_free(bench_names);
+    bench_names = NULL;
+}
+
+static void _student_init(void* record, long id){
+    Student* s = (Student*)record;
+    s->id = id;
+    s->name = _bench_name("Student", id);
+    s->gpa = (float)(id % 100) / 10.0f;
+}
+static void _student_set_id(void* record, long id){ ((Student*)record)->id = id; }
+
+static void _product_init(void* record, long id){
+    Product* p = (Product*)record;
+    p->id = id;
+    p->name = _bench_name("Product", id);
+    p->price = (float)(id % 1000) + 0.99f;
+    p->cost = p->price * 0.6f;
+    p->stock = id % 500;
+}
+static void _product_set_id(void* record, long id){ ((Product*)record)->id = id; }
+
+static void _student_write_csv(FILE* out, void* record){
+    Student* s = (Student*)record;
+    fprintf(out, "%ld,%s,%.2f\n", s->id, s->name, s->gpa);
+}
+static void* _student_scan_csv(const char* line){
+    long id;
+    char name[100];
+    float gpa;
+    if(sscanf(line, " %ld ,%[^,] ,%f ", &id, name, &gpa) != 3) return NULL;
+    return student_create(id, name, gpa);
+}
+
+static void _product_write_csv(FILE* out, void* record){
+    Product* p = (Product*)record;
+    fprintf(out, "%ld,%s,%.2f,%.2f,%ld\n", p->id, p->name, p->price, p->cost, p->stock);
+}
+static void* _product_scan_csv(const char* line){
+    long id, stock;
+    char name[100];
+    float price, cost;
+    if(sscanf(line, " %ld ,%[^,] ,%f ,%f ,%ld ", &id, name, &price, &cost, &stock) != 5) return NULL;
+    return product_create(id, name, price, cost, stock);
+}
+
+static const RecordKind RECORDS[] = {
+    {"student", sizeof(Student), student_compare_by_id, student_get_id, _student_init, _student_set_id,
+     _student_write_csv, csv_load_students, csv_load_students_in, _student_scan_csv, student_free},
+    {"product", sizeof(Product), product_compare_by_id, product_get_id, _product_init, _product_set_id,
+     _product_write_csv, csv_load_products, csv_load_products_in, _product_scan_csv, product_free},
+};
+
+int bench_record_count(void){
+    return (int)(sizeof(RECORDS) / sizeof(RECORDS[0]));
+}
+
+const RecordKind* bench_record_at(int index){
+    if(index < 0 || index >= bench_record_count()) return NULL;
+    return &RECORDS[index];
+}
+
+const RecordKind* bench_record_find(const char* name){
+    for(int i = 0; i < bench_record_count(); i++){
+        if(strcmp(RECORDS[i].name, name) == 0) return &RECORDS[i];
+    }
+    return NULL;
+}
@@ -0,0 +1,66 @@
+#ifndef BENCHDRIVERS_H_INCLUDED
+#define BENCHDRIVERS_H_INCLUDED
+#include <stddef.h>
+#include <stdio.h>
+#include "orderedArray.h"
+#include "linkedList.h"
+#include "skipList.h"
+#include "bPlusTree.h"
+#include "tieredArray.h"
+#include "unrolledList.h"
+#include "csvLoader.h"
+
+/*STRUCTURES DEFINITION*/
+
+/*Synthetic record type (Student or Product) generated by the harness*/
+typedef struct{
+    const char* name;
+    size_t size;
+    CompareFunc compare;
+    KeyFunc key_of;
+    void (*init)(void* record, long id);
+    void (*set_id)(void* record, long id);
+    void (*write_csv)(FILE* out, void* record);                     /*One CSV row, same layout as the data/ files*/
+    void** (*load_csv)(const char* filename, int* count, CsvReport* report);
+    void** (*load_csv_in)(RecordArena* arena, const char* filename, int* count, CsvReport* report);  /*Same, records in an arena*/
+    void* (*scan_csv)(const char* line);    /*Legacy sscanf parser: heap record or NULL*/
+    void (*free_record)(void* record);
+}RecordKind;
+
+/*
+ * A BenchDriver adapts one container to the harness. Every container
+ * exposes the same four operations, so adding a new structure to the
+ * comparison means adding one entry to the driver table.
+ */
+typedef struct{
+    const char* name;
+    int linear;                 /*1 if lookups are O(n): subject to --list-limit*/
+    int prefill_descending;     /*Build order that is cheapest for the container*/
+    void* (*create)(long expected_size, const RecordKind* kind);
+    int (*insert)(void* container, void* data);
+    void* (*find)(void* container, void* key);
+    void* (*remove)(void* container, void* key);
+    void (*destroy)(void* container);
+    int (*insert_batch)(void* container, void** items, int count); /*NULL if unsupported*/
+    int (*load_sorted)(void* container, void** sorted, int count);  /*NULL if unsupported*/
+    int (*find_batch)(void* container, void** keys, int count, void** results); /*NULL if unsupported*/
+    int (*range)(void* container, void* low, void* high, VisitFunc visit, void* context);  /*NULL if unsupported*/
+}BenchDriver;
+
+/*FUNCTION PROTOTYPES*/
+
+int bench_driver_count(void);
+const BenchDriver* bench_driver_at(int index);
+const BenchDriver* bench_driver_find(const char* name);
+
+/*Thread-safe containers, used by the multi-threaded suite*/
+int bench_concurrent_count(void);
+const BenchDriver* bench_concurrent_at(int index);
+
+int bench_record_count(void);
+const RecordKind* bench_record_at(int index);
+const RecordKind* bench_record_find(const char* name);
+/*Frees the interned names of the synthetic records (call once, at exit)*/
+void bench_records_release(void);
+
+#endif // BENCHDRIVERS_H_INCLUDED
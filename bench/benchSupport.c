@@ -0,0 +1,355 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "benchSupport.h"
+
+/*
+ * benchSupport.c
+ *
+ * Shared infrastructure for the benchmark harness: a monotonic clock,
+ * a reproducible PRNG, the synthetic key distributions, latency
+ * statistics and the table/CSV/JSON reporters.
+ *
+ * Everything here is independent of the data structures being measured.
+ */
+
+
+/**
+ * @brief Reads the monotonic clock.
+ *
+ * @return The current time in nanoseconds from an arbitrary origin.
+ */
+uint64_t bench_now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Estimates the cost of one pair of bench_now_ns() calls.
+ *
+ * Takes the minimum of many back-to-back readings, so the value is the
+ * floor that every per-operation sample carries.
+ *
+ * @return The timer overhead in nanoseconds.
+ */
+uint64_t bench_timer_overhead_ns(void){
+    uint64_t best = UINT64_MAX;
+    for(int i = 0; i < 10000; i++){
+        uint64_t t0 = bench_now_ns();
+        uint64_t t1 = bench_now_ns();
+        if(t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+/**
+ * @brief Seeds the generator. Identical seeds produce identical streams.
+ *
+ * @param rng The generator to seed.
+ * @param seed Any 64-bit value (0 included).
+ */
+void rng_seed(BenchRng* rng, uint64_t seed){
+    rng->state = seed;
+}
+
+/**
+ * @brief Returns the next 64-bit value of the splitmix64 sequence.
+ *
+ * @param rng The generator.
+ * @return A uniformly distributed 64-bit value.
+ */
+uint64_t rng_next(BenchRng* rng){
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Returns a value in [0, bound) (bound must be > 0).
+ *
+ * @param rng The generator.
+ * @param bound Exclusive upper limit.
+ * @return A (practically) uniform value below 'bound'.
+ */
+uint64_t rng_below(BenchRng* rng, uint64_t bound){
+    return rng_next(rng) % bound;
+}
+
+/**
+ * @brief Fisher-Yates shuffle of an array of longs.
+ *
+ * @param rng The generator.
+ * @param values The array to shuffle in place.
+ * @param count Number of elements in 'values'.
+ */
+void rng_shuffle_longs(BenchRng* rng, long* values, long count){
+    for(long i = count - 1; i > 0; i--){
+        long j = (long)rng_below(rng, (uint64_t)i + 1);
+        long tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+}
+
+static const char* DIST_NAMES[DIST_COUNT] = {"sequential", "random", "reverse", "zipfian"};
+
+/**
+ * @brief Returns the command-line name of a distribution.
+ */
+const char* dist_name(KeyDistribution dist){
+    if(dist < 0 || dist >= DIST_COUNT) return "?";
+    return DIST_NAMES[dist];
+}
+
+/**
+ * @brief Parses a distribution name.
+ *
+ * @param name "sequential", "random", "reverse" or "zipfian".
+ * @param out [out] The parsed distribution.
+ * @return 1 on success, 0 if the name is unknown.
+ */
+int dist_parse(const char* name, KeyDistribution* out){
+    for(int i = 0; i < DIST_COUNT; i++){
+        if(strcmp(name, DIST_NAMES[i]) == 0){
+            *out = (KeyDistribution)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief (Private) Generalized harmonic number: sum of 1/i^theta for i in [1, n].
+ */
+static double _zeta(long n, double theta){
+    double sum = 0.0;
+    for(long i = 1; i <= n; i++) sum += 1.0 / pow((double)i, theta);
+    return sum;
+}
+
+/**
+ * @brief Prepares a key generator over the ranks [0, n).
+ *
+ * The zipfian shape uses the Gray et al. constant-time method with
+ * theta = 0.99 (the YCSB default). Its setup is O(n) once per generator.
+ *
+ * @param gen The generator to initialize.
+ * @param dist The distribution shape.
+ * @param n Number of distinct ranks (must be > 0).
+ * @param seed Seed for the random shapes.
+ */
+void keygen_init(KeyGenerator* gen, KeyDistribution dist, long n, uint64_t seed){
+    memset(gen, 0, sizeof(*gen));
+    gen->dist = dist;
+    gen->n = n;
+    rng_seed(&gen->rng, seed);
+    if(dist == DIST_ZIPFIAN){
+        gen->theta = 0.99;
+        gen->alpha = 1.0 / (1.0 - gen->theta);
+        gen->zetan = _zeta(n, gen->theta);
+        double zeta2 = _zeta(2, gen->theta);
+        gen->eta = (1.0 - pow(2.0 / (double)n, 1.0 - gen->theta)) / (1.0 - zeta2 / gen->zetan);
+    }
+}
+
+/**
+ * @brief Draws the next rank.
+ *
+ * SEQUENTIAL and REVERSE walk the ranks (wrapping around), RANDOM is
+ * uniform, ZIPFIAN is skewed. Zipfian ranks are scrambled with a hash so
+ * the hot keys are spread over the key space instead of sitting at the
+ * front of the containers.
+ *
+ * @param gen The generator.
+ * @return A rank in [0, n).
+ */
+long keygen_next(KeyGenerator* gen){
+    long rank;
+    switch(gen->dist){
+    case DIST_SEQUENTIAL:
+        rank = gen->cursor;
+        gen->cursor = (gen->cursor + 1) % gen->n;
+        return rank;
+    case DIST_REVERSE:
+        rank = gen->n - 1 - gen->cursor;
+        gen->cursor = (gen->cursor + 1) % gen->n;
+        return rank;
+    case DIST_RANDOM:
+        return (long)rng_below(&gen->rng, (uint64_t)gen->n);
+    case DIST_ZIPFIAN: {
+        double u = (double)(rng_next(&gen->rng) >> 11) * (1.0 / 9007199254740992.0);
+        double uz = u * gen->zetan;
+        if(uz < 1.0) rank = 0;
+        else if(uz < 1.0 + pow(0.5, gen->theta)) rank = 1;
+        else rank = (long)((double)gen->n * pow(gen->eta * u - gen->eta + 1.0, gen->alpha));
+        if(rank >= gen->n) rank = gen->n - 1;
+        uint64_t h = (uint64_t)rank * 0x9E3779B97F4A7C15ull;
+        return (long)((h ^ (h >> 29)) % (uint64_t)gen->n);
+    }
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Allocates room for 'capacity' latency samples.
+ *
+ * @return 1 on success, 0 if memory fails.
+ */
+int samples_init(BenchSamples* s, long capacity){
+    s->samples = (uint64_t*)malloc((size_t)(capacity > 0 ? capacity : 1) * sizeof(uint64_t));
+    s->count = 0;
+    s->capacity = capacity;
+    s->total_ns = 0;
+    return s->samples != NULL;
+}
+
+/**
+ * @brief Records one latency sample. Samples beyond capacity still count
+ * towards the total (and therefore ns/op) but not the percentiles.
+ */
+void samples_add(BenchSamples* s, uint64_t ns){
+    if(s->count < s->capacity) s->samples[s->count] = ns;
+    s->count++;
+    s->total_ns += ns;
+}
+
+void samples_reset(BenchSamples* s){
+    s->count = 0;
+    s->total_ns = 0;
+}
+
+void samples_free(BenchSamples* s){
+    free(s->samples);
+    s->samples = NULL;
+    s->count = s->capacity = 0;
+}
+
+static int _cmp_u64(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief (Private) Nearest-rank percentile over sorted samples.
+ */
+static uint64_t _percentile(const uint64_t* sorted, long count, double p){
+    if(count == 0) return 0;
+    long rank = (long)ceil(p * (double)count);
+    if(rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+/**
+ * @brief Computes ns/op, percentiles and throughput.
+ *
+ * Sorts the sample buffer in place.
+ *
+ * @param s The collected samples.
+ * @param stats [out] The summary.
+ */
+void samples_summarize(BenchSamples* s, BenchStats* stats){
+    long kept = s->count < s->capacity ? s->count : s->capacity;
+    memset(stats, 0, sizeof(*stats));
+    stats->ops = s->count;
+    if(s->count == 0) return;
+    qsort(s->samples, (size_t)kept, sizeof(uint64_t), _cmp_u64);
+    stats->ns_per_op = (double)s->total_ns / (double)s->count;
+    stats->p50 = _percentile(s->samples, kept, 0.50);
+    stats->p90 = _percentile(s->samples, kept, 0.90);
+    stats->p99 = _percentile(s->samples, kept, 0.99);
+    stats->max = kept > 0 ? s->samples[kept - 1] : 0;
+    stats->ops_per_sec = s->total_ns > 0 ? (double)s->count * 1e9 / (double)s->total_ns : 0.0;
+}
+
+/**
+ * @brief Writes the report header.
+ *
+ * The JSON header carries the seed, op count, compiler and timer overhead
+ * so results from different builds can be compared side by side.
+ */
+void report_begin(BenchReport* report, FILE* out, ReportFormat format, uint64_t seed, long ops){
+    report->out = out;
+    report->format = format;
+    report->rows = 0;
+    if(format == FORMAT_CSV){
+        fprintf(out, "structure,record,dist,size,op,ops,ns_per_op,p50_ns,p90_ns,p99_ns,max_ns,ops_per_sec\n");
+    }
+    else if(format == FORMAT_JSON){
+#ifdef __VERSION__
+        const char* compiler = __VERSION__;
+#else
+        const char* compiler = "unknown";
+#endif
+        fprintf(out, "{\n  \"meta\": {\"seed\": %llu, \"ops\": %ld, \"compiler\": \"%s\", \"timer_overhead_ns\": %llu},\n",
+                (unsigned long long)seed, ops, compiler, (unsigned long long)bench_timer_overhead_ns());
+        fprintf(out, "  \"results\": [");
+    }
+    else{
+        fprintf(out, "%-14s %-8s %-10s %9s %-12s %8s %10s %8s %8s %8s %10s %12s\n",
+                "structure", "record", "dist", "size", "op", "ops", "ns/op", "p50", "p90", "p99", "max", "ops/s");
+    }
+}
+
+/**
+ * @brief Writes one result row in the selected format.
+ */
+void report_row(BenchReport* report, const char* structure, const char* record,
+                const char* dist, long size, const char* op, const BenchStats* stats){
+    report_row_extra(report, structure, record, dist, size, op, stats, NULL, NULL);
+}
+
+/**
+ * @brief Writes one result row carrying an extra JSON value.
+ *
+ * In JSON the row gets one more member, 'extra_key': 'extra_json' (e.g.
+ * a cs_dump_json object). Table and CSV rows are written as by report_row.
+ *
+ * @param extra_key Name of the extra member (NULL: none).
+ * @param extra_json Its value, already valid JSON (NULL: none).
+ */
+void report_row_extra(BenchReport* report, const char* structure, const char* record,
+                      const char* dist, long size, const char* op, const BenchStats* stats,
+                      const char* extra_key, const char* extra_json){
+    FILE* out = report->out;
+    if(report->format == FORMAT_CSV){
+        fprintf(out, "%s,%s,%s,%ld,%s,%ld,%.1f,%llu,%llu,%llu,%llu,%.0f\n",
+                structure, record, dist, size, op, stats->ops, stats->ns_per_op,
+                (unsigned long long)stats->p50, (unsigned long long)stats->p90,
+                (unsigned long long)stats->p99, (unsigned long long)stats->max, stats->ops_per_sec);
+    }
+    else if(report->format == FORMAT_JSON){
+        fprintf(out, "%s\n    {\"structure\": \"%s\", \"record\": \"%s\", \"dist\": \"%s\", \"size\": %ld, "
+                "\"op\": \"%s\", \"ops\": %ld, \"ns_per_op\": %.1f, \"p50_ns\": %llu, \"p90_ns\": %llu, "
+                "\"p99_ns\": %llu, \"max_ns\": %llu, \"ops_per_sec\": %.0f",
+                report->rows > 0 ? "," : "", structure, record, dist, size, op, stats->ops, stats->ns_per_op,
+                (unsigned long long)stats->p50, (unsigned long long)stats->p90,
+                (unsigned long long)stats->p99, (unsigned long long)stats->max, stats->ops_per_sec);
+        if(extra_key != NULL && extra_json != NULL) fprintf(out, ", \"%s\": %s", extra_key, extra_json);
+        fprintf(out, "}");
+    }
+    else{
+        fprintf(out, "%-14s %-8s %-10s %9ld %-12s %8ld %10.1f %8llu %8llu %8llu %10llu %12.0f\n",
+                structure, record, dist, size, op, stats->ops, stats->ns_per_op,
+                (unsigned long long)stats->p50, (unsigned long long)stats->p90,
+                (unsigned long long)stats->p99, (unsigned long long)stats->max, stats->ops_per_sec);
+    }
+    fflush(out);
+    report->rows++;
+}
+
+/**
+ * @brief Closes the report (terminates the JSON document).
+ */
+void report_end(BenchReport* report){
+    if(report->format == FORMAT_JSON){
+        fprintf(report->out, "\n  ]\n}\n");
+    }
+    fflush(report->out);
+}
@@ -0,0 +1,92 @@
+#ifndef BENCHSUPPORT_H_INCLUDED
+#define BENCHSUPPORT_H_INCLUDED
+#include <stdio.h>
+#include <stdint.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Deterministic PRNG (splitmix64). Same seed -> same workload on every platform*/
+typedef struct{
+    uint64_t state;
+}BenchRng;
+
+typedef enum{
+    DIST_SEQUENTIAL,
+    DIST_RANDOM,
+    DIST_REVERSE,
+    DIST_ZIPFIAN,
+    DIST_COUNT
+}KeyDistribution;
+
+/*Produces ranks in [0, n) following one of the KeyDistribution shapes*/
+typedef struct{
+    KeyDistribution dist;
+    long n;
+    long cursor;
+    BenchRng rng;
+    double theta;
+    double alpha;
+    double zetan;
+    double eta;
+}KeyGenerator;
+
+/*Per-operation latency samples (nanoseconds)*/
+typedef struct{
+    uint64_t* samples;
+    long count;
+    long capacity;
+    uint64_t total_ns;
+}BenchSamples;
+
+typedef struct{
+    long ops;
+    double ns_per_op;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t max;
+    double ops_per_sec;
+}BenchStats;
+
+typedef enum{
+    FORMAT_TABLE,
+    FORMAT_CSV,
+    FORMAT_JSON
+}ReportFormat;
+
+typedef struct{
+    FILE* out;
+    ReportFormat format;
+    int rows;
+}BenchReport;
+
+/*FUNCTION PROTOTYPES*/
+
+uint64_t bench_now_ns(void);
+uint64_t bench_timer_overhead_ns(void);
+
+void rng_seed(BenchRng* rng, uint64_t seed);
+uint64_t rng_next(BenchRng* rng);
+uint64_t rng_below(BenchRng* rng, uint64_t bound);
+void rng_shuffle_longs(BenchRng* rng, long* values, long count);
+
+const char* dist_name(KeyDistribution dist);
+int dist_parse(const char* name, KeyDistribution* out);
+void keygen_init(KeyGenerator* gen, KeyDistribution dist, long n, uint64_t seed);
+long keygen_next(KeyGenerator* gen);
+
+int samples_init(BenchSamples* s, long capacity);
+void samples_add(BenchSamples* s, uint64_t ns);
+void samples_reset(BenchSamples* s);
+void samples_free(BenchSamples* s);
+void samples_summarize(BenchSamples* s, BenchStats* stats);
+
+void report_begin(BenchReport* report, FILE* out, ReportFormat format, uint64_t seed, long ops);
+void report_row(BenchReport* report, const char* structure, const char* record,
+                const char* dist, long size, const char* op, const BenchStats* stats);
+void report_row_extra(BenchReport* report, const char* structure, const char* record,
+                      const char* dist, long size, const char* op, const BenchStats* stats,
+                      const char* extra_key, const char* extra_json);
+void report_end(BenchReport* report);
+
+#endif // BENCHSUPPORT_H_INCLUDED
@@ -0,0 +1,1709 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "benchSupport.h"
+#include "benchDrivers.h"
+#include "oaLookup.h"
+#include "frozenArray.h"
+#include "recordStore.h"
+#include "snapshot.h"
+#include "changeLog.h"
+#include "bulkBuild.h"
+#include "lockFreeList.h"
+#include "student.h"
+#include "product.h"
+
+/*
+ * benchmark.c
+ *
+ * Standalone benchmark harness for the containers. For every combination
+ * of structure x record x key distribution x size it:
+ *   1. Builds the container with 'size' records (even ids) in the order
+ *      cheapest for it, timing each insert ("build" = amortized cost).
+ *   2. Times 'ops' individual operations with a monotonic clock:
+ *        find_hit, find_miss, insert, remove,
+ *        mixed_read (95% find / 5% write), mixed_write (50% / 50%).
+ *   3. Times the destruction of the container.
+ *   4. For containers with a batch insert, times loading all 'size'
+ *      records in random order with one call ("build_batch", per element).
+ *   5. For containers with a sorted bulk load, times loading all 'size'
+ *      records already in order ("load_sorted", per element).
+ *   6. For containers with a batch lookup, times 'ops' hits looked up one
+ *      call at a time in a single loop ("find_loop") and the same keys in
+ *      one batch call ("find_batch"), both per key.
+ *   7. For containers with a range scan, times 'ops' scans of
+ *      BENCH_RANGE_WIDTH consecutive elements starting at a hit ("range_32").
+ * and reports ns/op, p50/p90/p99/max latency and throughput as a table,
+ * CSV or JSON. The same --seed always produces the same workload.
+ *
+ * The "lookup" suite instead compares oa_find_binary on a sorted
+ * OrderedArray with every oaLookup kernel and with the van Emde Boas
+ * FrozenArray snapshots (plain and keyed) built from it (find_hit,
+ * find_miss, the snapshot build cost and, for FrozenArray, fz_refresh).
+ *
+ * The "csv" suite writes 'size' rows to a temporary CSV file and times
+ * loading it with csvLoader against the previous fgets/sscanf loop
+ * (per row, records created and freed in both cases) and with the
+ * records in a RecordArena released at once ("csv_arena"), then times
+ * building an OrderedArray from the loaded rows with oa_insert_batch and
+ * with bulk_build_oa on 1, 2, 4, ... --threads threads.
+ *
+ * The "columns" suite times the same column scans (students with gpa
+ * above 5, total product stock) over individually allocated records
+ * visited in id order and over a StudentStore/ProductStore. It then puts
+ * the records in an OrderedArray with a secondary index (gpa / stock) and
+ * compares a scan with the index for a filter (gpa above 5, stock below
+ * 10) and for the BENCH_TOP_K largest.
+ *
+ * The "snapshot" suite compares startup from CSV (parse + bulk insert
+ * into an OrderedArray of students / a LinkedList of products) with
+ * opening a binary snapshot of the same rows, with and without checksum
+ * verification, and times in-place snapshot lookups. It then times the
+ * change log: 'ops' updates logged with group commit and up to 256 with
+ * an fsync each, their replay into the loaded container, and compaction
+ * into a fresh snapshot.
+ *
+ * The "threads" suite runs the thread-safe containers from 1, 2, 4, ...
+ * up to --threads threads at once: every thread does 'ops' finds, then
+ * inserts and finally removes its own share of fresh ids. Rows report
+ * the aggregate cost (wall time / total operations), so perfect scaling
+ * halves ns/op each time the thread count doubles.
+ *
+ * The "stress" suite runs a 50% find / 25% insert / 25% remove mix on a
+ * LockFreeList from max(4, --threads) threads over the same ids, then
+ * checks that no update was lost or duplicated, that the list is still
+ * ordered and that its counter is exact. It runs once on a keyed list
+ * and once on a CompareFunc list that frees removed records
+ * ("lockfree_list_cmp", see lfl_set_release).
+ *
+ * The "stats" suite needs a build with -DTRADEOFFS_STATS (it is skipped
+ * otherwise). It times finds whose cost is known and checks the
+ * ContainerStats counters against it: at most ceil(log2 n) + 1
+ * comparisons per binary find, exactly r + 1 comparisons and r hops for
+ * a linear find of rank r, one histogram entry per find. With
+ * --format json each row carries the cs_dump_json object.
+ *
+ * Run with --help for the options.
+ */
+
+#define MAX_SIZES 16
+
+typedef enum{
+    SUITE_OPS,
+    SUITE_LOOKUP,
+    SUITE_CSV,
+    SUITE_COLUMNS,
+    SUITE_SNAPSHOT,
+    SUITE_THREADS,
+    SUITE_STRESS,
+    SUITE_STATS,
+    SUITE_COUNT
+}BenchSuite;
+
+static const char* SUITE_NAMES[SUITE_COUNT] = {"ops", "lookup", "csv", "columns", "snapshot", "threads", "stress", "stats"};
+
+typedef struct{
+    long sizes[MAX_SIZES];
+    int size_count;
+    long ops;
+    int use_dist[DIST_COUNT];
+    int use_record[8];
+    int use_driver[32];
+    int use_suite[SUITE_COUNT];
+    long list_limit;
+    int max_threads;
+    uint64_t seed;
+    ReportFormat format;
+    const char* out_path;
+}BenchConfig;
+
+static uint64_t timer_overhead = 0;
+static int validation_errors = 0;
+
+/**
+ * @brief (Private) Stores one latency sample with the timer floor removed.
+ */
+static void _record(BenchSamples* s, uint64_t t0, uint64_t t1){
+    uint64_t ns = t1 - t0;
+    samples_add(s, ns > timer_overhead ? ns - timer_overhead : 0);
+}
+
+static void _emit(BenchReport* report, BenchSamples* s, const char* structure, const RecordKind* kind,
+                  KeyDistribution dist, long size, const char* op){
+    BenchStats stats;
+    samples_summarize(s, &stats);
+    report_row(report, structure, kind->name, dist_name(dist), size, op, &stats);
+    samples_reset(s);
+}
+
+/**
+ * @brief (Private) Reports a single timed bulk operation over 'count' elements, normalized per element.
+ */
+static void _report_total(BenchReport* report, const char* structure, const RecordKind* kind,
+                          KeyDistribution dist, long size, long count, const char* op, uint64_t elapsed){
+    BenchStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.ops = count;
+    stats.ns_per_op = (double)elapsed / (double)count;
+    stats.p50 = stats.p90 = stats.p99 = stats.max = elapsed;
+    stats.ops_per_sec = elapsed > 0 ? (double)count * 1e9 / (double)elapsed : 0.0;
+    report_row(report, structure, kind->name, dist_name(dist), size, op, &stats);
+}
+
+static void _check(int ok, const char* drv, const char* op, long id){
+    if(ok) return;
+    if(validation_errors < 10){
+        fprintf(stderr, "VALIDATION FAILED: %s %s id=%ld\n", drv, op, id);
+    }
+    validation_errors++;
+}
+
+/**
+ * @brief (Private) Picks a rank from the distribution that is not in use yet.
+ *
+ * Keeps inserted keys distinct (even under zipfian skew) by probing
+ * forward from the drawn rank to the next free one.
+ */
+static long _fresh_rank(KeyGenerator* gen, unsigned char* used, long n){
+    long r = keygen_next(gen);
+    while(used[r]) r = (r + 1) % n;
+    used[r] = 1;
+    return r;
+}
+
+/*Elements visited by each range scan of the operation suite*/
+#define BENCH_RANGE_WIDTH 32
+
+/*State of the visitor that checks a range scan*/
+typedef struct{
+    KeyFunc key_of;
+    long last_id;
+    int ordered;        /*Cleared if the ids do not step by 2 (the harness uses even ids)*/
+}RangeCheck;
+
+/**
+ * @brief (Private) Range visitor: checks that the ids arrive in order, without gaps.
+ */
+static int _range_visit(void* data, void* context){
+    RangeCheck* check = (RangeCheck*)context;
+    long id = check->key_of(data);
+    if(id != check->last_id + 2) check->ordered = 0;
+    check->last_id = id;
+    return 1;
+}
+
+/**
+ * @brief (Private) Runs the whole operation suite for one configuration.
+ */
+static void _run_ops(const BenchConfig* cfg, BenchReport* report, const BenchDriver* drv,
+                     const RecordKind* kind, KeyDistribution dist, long size){
+    long ops = cfg->ops < size ? cfg->ops : size;
+    char* present = (char*)malloc((size_t)size * kind->size);
+    char* fresh = (char*)malloc((size_t)ops * kind->size);
+    char* probe = (char*)malloc(kind->size);
+    unsigned char* used = (unsigned char*)calloc((size_t)size, 1);
+    long* live = (long*)malloc((size_t)ops * sizeof(long));
+    long* free_slots = (long*)malloc((size_t)ops * sizeof(long));
+    long* live_rank = (long*)malloc((size_t)ops * sizeof(long));
+    BenchSamples samples;
+    if(present == NULL || fresh == NULL || probe == NULL || used == NULL || live == NULL
+       || free_slots == NULL || live_rank == NULL || !samples_init(&samples, ops)){
+        fprintf(stderr, "Error: not enough memory for size %ld\n", size);
+        free(present); free(fresh); free(probe); free(used); free(live); free(free_slots); free(live_rank);
+        return;
+    }
+    for(long i = 0; i < size; i++) kind->init(present + i * kind->size, 2 * i);
+    for(long i = 0; i < ops; i++) kind->init(fresh + i * kind->size, 1);
+    kind->init(probe, 0);
+
+    void* c = drv->create(size + ops, kind);
+    if(c == NULL){
+        fprintf(stderr, "Error: couldn't create %s of size %ld\n", drv->name, size);
+        goto cleanup;
+    }
+    KeyGenerator gen;
+    uint64_t t0, t1;
+    void* res;
+
+    /* build */
+    BenchSamples build;
+    if(samples_init(&build, size)){
+        for(long i = 0; i < size; i++){
+            long idx = drv->prefill_descending ? size - 1 - i : i;
+            t0 = bench_now_ns();
+            int ok = drv->insert(c, present + idx * kind->size);
+            t1 = bench_now_ns();
+            _record(&build, t0, t1);
+            _check(ok, drv->name, "build", 2 * idx);
+        }
+        _emit(report, &build, drv->name, kind, dist, size, "build");
+        samples_free(&build);
+    }
+    else{
+        for(long i = 0; i < size; i++){
+            long idx = drv->prefill_descending ? size - 1 - i : i;
+            drv->insert(c, present + idx * kind->size);
+        }
+    }
+
+    /* find_hit */
+    keygen_init(&gen, dist, size, cfg->seed);
+    for(long k = 0; k < ops; k++){
+        long id = 2 * keygen_next(&gen);
+        kind->set_id(probe, id);
+        t0 = bench_now_ns();
+        res = drv->find(c, probe);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res != NULL && kind->compare(res, probe) == 0, drv->name, "find_hit", id);
+    }
+    _emit(report, &samples, drv->name, kind, dist, size, "find_hit");
+
+    /* find_miss */
+    keygen_init(&gen, dist, size, cfg->seed + 1);
+    for(long k = 0; k < ops; k++){
+        long id = 2 * keygen_next(&gen) + 1;
+        kind->set_id(probe, id);
+        t0 = bench_now_ns();
+        res = drv->find(c, probe);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res == NULL, drv->name, "find_miss", id);
+    }
+    _emit(report, &samples, drv->name, kind, dist, size, "find_miss");
+
+    /* insert */
+    keygen_init(&gen, dist, size, cfg->seed + 2);
+    for(long k = 0; k < ops; k++){
+        void* rec = fresh + k * kind->size;
+        long id = 2 * _fresh_rank(&gen, used, size) + 1;
+        kind->set_id(rec, id);
+        t0 = bench_now_ns();
+        int ok = drv->insert(c, rec);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(ok, drv->name, "insert", id);
+    }
+    _emit(report, &samples, drv->name, kind, dist, size, "insert");
+
+    /* remove (same keys, same order) */
+    for(long k = 0; k < ops; k++){
+        void* rec = fresh + k * kind->size;
+        memcpy(probe, rec, kind->size);
+        t0 = bench_now_ns();
+        res = drv->remove(c, probe);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res == rec, drv->name, "remove", 0);
+    }
+    _emit(report, &samples, drv->name, kind, dist, size, "remove");
+    memset(used, 0, (size_t)size);
+
+    /* mixed workloads */
+    static const struct{ const char* op; int write_percent; } MIXES[] = {
+        {"mixed_read", 5}, {"mixed_write", 50}
+    };
+    for(int m = 0; m < 2; m++){
+        BenchRng coin;
+        long live_count = 0, free_count = ops;
+        rng_seed(&coin, cfg->seed + 10 + (uint64_t)m);
+        for(long k = 0; k < ops; k++) free_slots[k] = ops - 1 - k;
+        keygen_init(&gen, dist, size, cfg->seed + 3 + (uint64_t)m);
+        for(long k = 0; k < ops; k++){
+            int write = (int)rng_below(&coin, 100) < MIXES[m].write_percent;
+            if(!write){
+                long id = 2 * keygen_next(&gen);
+                kind->set_id(probe, id);
+                t0 = bench_now_ns();
+                res = drv->find(c, probe);
+                t1 = bench_now_ns();
+                _check(res != NULL, drv->name, MIXES[m].op, id);
+            }
+            else if(live_count > 0 && (free_count == 0 || rng_below(&coin, 2) == 0)){
+                long pick = (long)rng_below(&coin, (uint64_t)live_count);
+                long slot = live[pick];
+                void* rec = fresh + slot * kind->size;
+                memcpy(probe, rec, kind->size);
+                t0 = bench_now_ns();
+                res = drv->remove(c, probe);
+                t1 = bench_now_ns();
+                _check(res == rec, drv->name, MIXES[m].op, 0);
+                used[live_rank[pick]] = 0;
+                live[pick] = live[live_count - 1];
+                live_rank[pick] = live_rank[live_count - 1];
+                live_count--;
+                free_slots[free_count++] = slot;
+            }
+            else{
+                long slot = free_slots[--free_count];
+                void* rec = fresh + slot * kind->size;
+                long rank = _fresh_rank(&gen, used, size);
+                kind->set_id(rec, 2 * rank + 1);
+                t0 = bench_now_ns();
+                int ok = drv->insert(c, rec);
+                t1 = bench_now_ns();
+                _check(ok, drv->name, MIXES[m].op, 2 * rank + 1);
+                live[live_count] = slot;
+                live_rank[live_count] = rank;
+                live_count++;
+            }
+            _record(&samples, t0, t1);
+        }
+        _emit(report, &samples, drv->name, kind, dist, size, MIXES[m].op);
+        while(live_count > 0){
+            live_count--;
+            memcpy(probe, fresh + live[live_count] * kind->size, kind->size);
+            drv->remove(c, probe);
+            used[live_rank[live_count]] = 0;
+        }
+    }
+
+    /* destroy: one sample, reported per element */
+    t0 = bench_now_ns();
+    drv->destroy(c);
+    t1 = bench_now_ns();
+    _report_total(report, drv->name, kind, dist, size, size, "destroy", t1 - t0);
+
+    /* build_batch: unsorted bulk load through the batch path */
+    if(drv->insert_batch != NULL){
+        void** items = (void**)malloc((size_t)size * sizeof(void*));
+        long* order = (long*)malloc((size_t)size * sizeof(long));
+        void* batch_container = drv->create(size, kind);
+        if(items != NULL && order != NULL && batch_container != NULL){
+            BenchRng rng;
+            rng_seed(&rng, cfg->seed + 20);
+            for(long i = 0; i < size; i++) order[i] = i;
+            rng_shuffle_longs(&rng, order, size);
+            for(long i = 0; i < size; i++) items[i] = present + order[i] * kind->size;
+            t0 = bench_now_ns();
+            int inserted = drv->insert_batch(batch_container, items, (int)size);
+            t1 = bench_now_ns();
+            _check(inserted == size, drv->name, "build_batch", 0);
+            _report_total(report, drv->name, kind, dist, size, size, "build_batch", t1 - t0);
+        }
+        if(batch_container != NULL) drv->destroy(batch_container);
+        free(items);
+        free(order);
+    }
+
+    /* load_sorted: bottom-up build from sorted input */
+    if(drv->load_sorted != NULL){
+        void** items = (void**)malloc((size_t)size * sizeof(void*));
+        void* sorted_container = drv->create(size, kind);
+        if(items != NULL && sorted_container != NULL){
+            for(long i = 0; i < size; i++) items[i] = present + i * kind->size;
+            t0 = bench_now_ns();
+            int ok = drv->load_sorted(sorted_container, items, (int)size);
+            t1 = bench_now_ns();
+            _check(ok, drv->name, "load_sorted", 0);
+            for(long k = 0; k < ops && ok; k++){
+                kind->set_id(probe, 2 * (k * (size / ops)));
+                _check(drv->find(sorted_container, probe) != NULL, drv->name, "load_sorted", 2 * (k * (size / ops)));
+            }
+            _report_total(report, drv->name, kind, dist, size, size, "load_sorted", t1 - t0);
+        }
+        if(sorted_container != NULL) drv->destroy(sorted_container);
+        free(items);
+    }
+
+    /* phases 6-7 run on a separate container holding all 'size' records */
+    if(drv->find_batch != NULL || drv->range != NULL){
+        void** keys = (void**)malloc((size_t)ops * sizeof(void*));
+        void** results = (void**)malloc((size_t)ops * sizeof(void*));
+        char* probes = (char*)malloc((size_t)(ops + 1) * kind->size);
+        void* full_container = drv->create(size, kind);
+        if(keys != NULL && results != NULL && probes != NULL && full_container != NULL){
+            for(long i = 0; i < size; i++){
+                long idx = drv->prefill_descending ? size - 1 - i : i;
+                drv->insert(full_container, present + idx * kind->size);
+            }
+            keygen_init(&gen, dist, size, cfg->seed + 30);
+            for(long k = 0; k < ops; k++){
+                keys[k] = probes + k * kind->size;
+                kind->init(keys[k], 2 * keygen_next(&gen));
+            }
+        }
+        else{
+            fprintf(stderr, "Error: not enough memory for %s size %ld\n", drv->name, size);
+        }
+
+        /* find_loop vs find_batch: the same hits, one call per key vs one call */
+        if(drv->find_batch != NULL && full_container != NULL && probes != NULL && keys != NULL && results != NULL){
+            long hits = 0;
+            t0 = bench_now_ns();
+            for(long k = 0; k < ops; k++) hits += drv->find(full_container, keys[k]) != NULL;
+            t1 = bench_now_ns();
+            _check(hits == ops, drv->name, "find_loop", 0);
+            _report_total(report, drv->name, kind, dist, size, ops, "find_loop", t1 - t0);
+            t0 = bench_now_ns();
+            int found = drv->find_batch(full_container, keys, (int)ops, results);
+            t1 = bench_now_ns();
+            _check(found == ops, drv->name, "find_batch", 0);
+            for(long k = 0; k < ops; k++){
+                _check(results[k] != NULL && kind->compare(results[k], keys[k]) == 0,
+                       drv->name, "find_batch", kind->key_of(keys[k]));
+            }
+            _report_total(report, drv->name, kind, dist, size, ops, "find_batch", t1 - t0);
+        }
+
+        /* range: BENCH_RANGE_WIDTH consecutive elements starting at each hit */
+        if(drv->range != NULL && full_container != NULL && probes != NULL && keys != NULL){
+            void* high = probes + ops * kind->size;
+            kind->init(high, 0);
+            for(long k = 0; k < ops; k++){
+                long low_id = kind->key_of(keys[k]);
+                long expected = (size - low_id / 2) < BENCH_RANGE_WIDTH ? size - low_id / 2 : BENCH_RANGE_WIDTH;
+                RangeCheck check = {kind->key_of, low_id - 2, 1};
+                kind->set_id(high, low_id + 2 * BENCH_RANGE_WIDTH);
+                t0 = bench_now_ns();
+                int visited = drv->range(full_container, keys[k], high, _range_visit, &check);
+                t1 = bench_now_ns();
+                _record(&samples, t0, t1);
+                _check(visited == expected && check.ordered, drv->name, "range", low_id);
+            }
+            char op_name[32];
+            snprintf(op_name, sizeof(op_name), "range_%d", BENCH_RANGE_WIDTH);
+            _emit(report, &samples, drv->name, kind, dist, size, op_name);
+        }
+        if(full_container != NULL) drv->destroy(full_container);
+        free(keys);
+        free(results);
+        free(probes);
+    }
+
+cleanup:
+    samples_free(&samples);
+    free(present); free(fresh); free(probe); free(used); free(live); free(free_slots); free(live_rank);
+}
+
+/**
+ * @brief (Private) Compares oa_find_binary with the oaLookup kernels and FrozenArray on the same keys.
+ */
+static void _run_lookup(const BenchConfig* cfg, BenchReport* report, const RecordKind* kind,
+                        KeyDistribution dist, long size){
+    static const LookupKind KINDS[] = {OAL_BRANCHLESS, OAL_EYTZINGER, OAL_SIMD};
+    static const char* NAMES[] = {"oal_branchless", "oal_eytzinger", "oal_simd"};
+    long ops = cfg->ops;
+    char* present = (char*)malloc((size_t)size * kind->size);
+    char* probe = (char*)malloc(kind->size);
+    long* hits = (long*)malloc((size_t)ops * sizeof(long));
+    long* misses = (long*)malloc((size_t)ops * sizeof(long));
+    OrderedArray* arr = oa_create((int)size, kind->compare);
+    BenchSamples samples;
+    if(present == NULL || probe == NULL || hits == NULL || misses == NULL || arr == NULL
+       || !samples_init(&samples, ops)){
+        fprintf(stderr, "Error: not enough memory for size %ld\n", size);
+        free(present); free(probe); free(hits); free(misses); oa_free(arr);
+        return;
+    }
+    for(long i = 0; i < size; i++){
+        kind->init(present + i * kind->size, 2 * i);
+        oa_insert_sorted(arr, present + i * kind->size);
+    }
+    kind->init(probe, 0);
+    KeyGenerator gen;
+    keygen_init(&gen, dist, size, cfg->seed);
+    for(long k = 0; k < ops; k++) hits[k] = 2 * keygen_next(&gen);
+    keygen_init(&gen, dist, size, cfg->seed + 1);
+    for(long k = 0; k < ops; k++) misses[k] = 2 * keygen_next(&gen) + 1;
+    uint64_t t0, t1;
+    void* res;
+
+    /* baseline: CompareFunc binary search over the element pointers */
+    for(long k = 0; k < ops; k++){
+        kind->set_id(probe, hits[k]);
+        t0 = bench_now_ns();
+        res = oa_find_binary(arr, probe);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res != NULL && kind->key_of(res) == hits[k], "oa_find_binary", "find_hit", hits[k]);
+    }
+    _emit(report, &samples, "oa_find_binary", kind, dist, size, "find_hit");
+    for(long k = 0; k < ops; k++){
+        kind->set_id(probe, misses[k]);
+        t0 = bench_now_ns();
+        res = oa_find_binary(arr, probe);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res == NULL, "oa_find_binary", "find_miss", misses[k]);
+    }
+    _emit(report, &samples, "oa_find_binary", kind, dist, size, "find_miss");
+
+    /* van Emde Boas snapshots: the same CompareFunc search, then with the keys copied in */
+    for(int keyed = 0; keyed < 2; keyed++){
+        const char* name = keyed ? "frozen_veb_keys" : "frozen_veb";
+        t0 = bench_now_ns();
+        FrozenArray* frozen = fz_freeze(arr, keyed ? kind->key_of : NULL);
+        t1 = bench_now_ns();
+        if(frozen == NULL){
+            fprintf(stderr, "Error: couldn't build %s of size %ld\n", name, size);
+            continue;
+        }
+        _report_total(report, name, kind, dist, size, size, "build", t1 - t0);
+        t0 = bench_now_ns();
+        _check(fz_refresh(frozen, arr), name, "refresh", size);
+        t1 = bench_now_ns();
+        _report_total(report, name, kind, dist, size, size, "refresh", t1 - t0);
+        for(long k = 0; k < ops; k++){
+            kind->set_id(probe, hits[k]);
+            t0 = bench_now_ns();
+            res = fz_find(frozen, probe);
+            t1 = bench_now_ns();
+            _record(&samples, t0, t1);
+            _check(res != NULL && kind->key_of(res) == hits[k], name, "find_hit", hits[k]);
+        }
+        _emit(report, &samples, name, kind, dist, size, "find_hit");
+        for(long k = 0; k < ops; k++){
+            kind->set_id(probe, misses[k]);
+            t0 = bench_now_ns();
+            res = fz_find(frozen, probe);
+            t1 = bench_now_ns();
+            _record(&samples, t0, t1);
+            _check(res == NULL, name, "find_miss", misses[k]);
+        }
+        _emit(report, &samples, name, kind, dist, size, "find_miss");
+        fz_free(frozen);
+    }
+
+    for(int v = 0; v < (int)(sizeof(KINDS) / sizeof(KINDS[0])); v++){
+        t0 = bench_now_ns();
+        OALookup* lookup = oal_build(arr, kind->key_of, KINDS[v]);
+        t1 = bench_now_ns();
+        if(lookup == NULL){
+            fprintf(stderr, "Error: couldn't build %s of size %ld\n", NAMES[v], size);
+            continue;
+        }
+        _report_total(report, NAMES[v], kind, dist, size, size, "build", t1 - t0);
+        for(long k = 0; k < ops; k++){
+            t0 = bench_now_ns();
+            res = oal_find(lookup, hits[k]);
+            t1 = bench_now_ns();
+            _record(&samples, t0, t1);
+            _check(res != NULL && kind->key_of(res) == hits[k], NAMES[v], "find_hit", hits[k]);
+        }
+        _emit(report, &samples, NAMES[v], kind, dist, size, "find_hit");
+        for(long k = 0; k < ops; k++){
+            t0 = bench_now_ns();
+            res = oal_find(lookup, misses[k]);
+            t1 = bench_now_ns();
+            _record(&samples, t0, t1);
+            _check(res == NULL, NAMES[v], "find_miss", misses[k]);
+        }
+        _emit(report, &samples, NAMES[v], kind, dist, size, "find_miss");
+        oal_free(lookup);
+    }
+
+    samples_free(&samples);
+    oa_free(arr);
+    free(present); free(probe); free(hits); free(misses);
+}
+
+/**
+ * @brief (Private) Thread counts of the threads and csv suites: powers of two, then the maximum itself.
+ */
+static int _next_thread_count(int threads, int max_threads){
+    if(threads == max_threads) return max_threads + 1;
+    return threads * 2 < max_threads ? threads * 2 : max_threads;
+}
+
+/**
+ * @brief (Private) Times csvLoader against the legacy fgets/sscanf loop on a generated file.
+ *
+ * csvLoader runs twice: heap records freed one by one, and records in a
+ * RecordArena released with one ra_free.
+ *
+ * Then times building an OrderedArray from the loaded rows with one
+ * oa_insert_batch and with bulk_build_oa on 1, 2, 4, ... cfg->max_threads
+ * threads ("build_Nt").
+ */
+static void _run_csv(const BenchConfig* cfg, BenchReport* report, const RecordKind* kind,
+                     KeyDistribution dist, long size){
+    static const char* PATH = "benchmark_rows.tmp.csv";
+    char* record = (char*)malloc(kind->size);
+    FILE* out = fopen(PATH, "w");
+    if(record == NULL || out == NULL){
+        fprintf(stderr, "Error: couldn't prepare %s\n", PATH);
+        free(record);
+        if(out != NULL) fclose(out);
+        return;
+    }
+    KeyGenerator gen;
+    keygen_init(&gen, dist, size, cfg->seed);
+    for(long i = 0; i < size; i++){
+        kind->init(record, 2 * keygen_next(&gen));
+        kind->write_csv(out, record);
+    }
+    fclose(out);
+    uint64_t t0, t1;
+
+    /* legacy: one fgets + sscanf + malloc per row */
+    long legacy_rows = 0;
+    t0 = bench_now_ns();
+    FILE* in = fopen(PATH, "r");
+    if(in != NULL){
+        char line_buffer[256];
+        while(fgets(line_buffer, sizeof(line_buffer), in) != NULL){
+            void* row = kind->scan_csv(line_buffer);
+            if(row != NULL){
+                legacy_rows++;
+                kind->free_record(row);
+            }
+        }
+        fclose(in);
+    }
+    t1 = bench_now_ns();
+    _check(legacy_rows == size, "fgets_sscanf", "load", legacy_rows);
+    _report_total(report, "fgets_sscanf", kind, dist, size, size, "load", t1 - t0);
+
+    int count = 0;
+    CsvReport csv;
+    t0 = bench_now_ns();
+    void** rows = kind->load_csv(PATH, &count, &csv);
+    for(int i = 0; i < count; i++) kind->free_record(rows[i]);
+    free(rows);
+    t1 = bench_now_ns();
+    _check(rows != NULL && count == size && csv.malformed == 0, "csv_loader", "load", count);
+    _report_total(report, "csv_loader", kind, dist, size, size, "load", t1 - t0);
+
+    /* the same load with records and names in an arena, released at once */
+    t0 = bench_now_ns();
+    RecordArena* arena = ra_create(0);
+    rows = kind->load_csv_in(arena, PATH, &count, &csv);
+    free(rows);
+    size_t arena_bytes = arena != NULL ? arena->bytes_reserved : 0;
+    ra_free(arena);
+    t1 = bench_now_ns();
+    _check(rows != NULL && count == size && csv.malformed == 0 && arena_bytes > 0, "csv_arena", "load", count);
+    _report_total(report, "csv_arena", kind, dist, size, size, "load", t1 - t0);
+
+    /* build: the loaded rows into an OrderedArray, batch insert against bulk build */
+    rows = kind->load_csv(PATH, &count, NULL);
+    void** order = rows != NULL ? (void**)malloc((size_t)count * sizeof(void*)) : NULL;
+    if(order != NULL && count > 0){
+        memcpy(order, rows, (size_t)count * sizeof(void*));
+        t0 = bench_now_ns();
+        OrderedArray* arr = oa_create(count, kind->compare);
+        int inserted = arr != NULL ? oa_insert_batch(arr, rows, count) : 0;
+        t1 = bench_now_ns();
+        _check(inserted > 0, "oa_insert_batch", "build", inserted);
+        _report_total(report, "oa_insert_batch", kind, dist, size, count, "build", t1 - t0);
+        oa_free(arr);
+        for(int threads = 1; threads <= cfg->max_threads; threads = _next_thread_count(threads, cfg->max_threads)){
+            char op[32];
+            snprintf(op, sizeof(op), "build_%dt", threads);
+            memcpy(rows, order, (size_t)count * sizeof(void*));
+            BulkOptions options = {threads, BULK_KEEP_FIRST, NULL};
+            t0 = bench_now_ns();
+            arr = bulk_build_oa(rows, count, kind->compare, &options, NULL);
+            t1 = bench_now_ns();
+            _check(arr != NULL && arr->counter == inserted, "bulk_build", op, arr != NULL ? arr->counter : 0);
+            _report_total(report, "bulk_build", kind, dist, size, count, op, t1 - t0);
+            oa_free(arr);
+        }
+    }
+    for(int i = 0; order != NULL && i < count; i++) kind->free_record(order[i]);
+    free(order);
+    free(rows);
+
+    remove(PATH);
+    free(record);
+}
+
+/*Elements returned by the top-k queries of the columns suite*/
+#define BENCH_TOP_K 10
+
+/**
+ * @brief (Private) Counts the elements of a secondary index range.
+ */
+static int _count_visit(void* data, void* context){
+    (void)data;
+    (*(long long*)context)++;
+    return 1;
+}
+
+/**
+ * @brief (Private) Times a filter and a top-k over a scan and over a secondary index.
+ *
+ * 'records' are in id order, so they load with oa_append_sorted; the
+ * index orders them by gpa (students) or stock (products).
+ */
+static void _run_secondary(BenchReport* report, const RecordKind* kind, void** records, long size){
+    int is_student = strcmp(kind->name, "student") == 0;
+    CompareFunc by_field = is_student ? student_compare_by_gpa : product_compare_by_stock;
+    const char* filter = is_student ? "filter_gpa" : "low_stock";
+    OrderedArray* arr = oa_create((int)size, kind->compare);
+    if(arr == NULL || !oa_append_sorted(arr, records, (int)size)){
+        fprintf(stderr, "Error: not enough memory for size %ld\n", size);
+        oa_free(arr);
+        return;
+    }
+    uint64_t t0, t1;
+    t0 = bench_now_ns();
+    int slot = oa_add_index(arr, by_field);
+    t1 = bench_now_ns();
+    _check(slot >= 0, "secondary_index", "index_build", size);
+    if(slot < 0){
+        oa_free(arr);
+        return;
+    }
+    _report_total(report, "secondary_index", kind, DIST_RANDOM, size, size, "index_build", t1 - t0);
+
+    /* Students with gpa > 5 / products with stock < 10 */
+    long long scan_result = 0, index_result = 0;
+    t0 = bench_now_ns();
+    for(long i = 0; i < size; i++){
+        if(is_student) scan_result += ((Student*)records[i])->gpa > 5.0f;
+        else scan_result += ((Product*)records[i])->stock < 10;
+    }
+    t1 = bench_now_ns();
+    _report_total(report, "oa_scan", kind, DIST_RANDOM, size, 1, filter, t1 - t0);
+    Student student_bound = {LONG_MAX, "", 5.0f};
+    Product product_bound = {LONG_MIN, "", 0.0f, 0.0f, 10};
+    t0 = bench_now_ns();
+    if(is_student) oa_index_range(arr, slot, &student_bound, NULL, _count_visit, &index_result);
+    else oa_index_range(arr, slot, NULL, &product_bound, _count_visit, &index_result);
+    t1 = bench_now_ns();
+    _check(index_result == scan_result, "secondary_index", filter, (long)index_result);
+    _report_total(report, "secondary_index", kind, DIST_RANDOM, size, 1, filter, t1 - t0);
+
+    /* The BENCH_TOP_K largest: a scan keeping a sorted buffer against the index's leaf chain */
+    void* scan_top[BENCH_TOP_K];
+    void* index_top[BENCH_TOP_K];
+    int kept = 0;
+    t0 = bench_now_ns();
+    for(long i = 0; i < size; i++){
+        void* record = records[i];
+        if(kept == BENCH_TOP_K && by_field(record, scan_top[kept - 1]) <= 0) continue;
+        int j = kept < BENCH_TOP_K ? kept++ : kept - 1;
+        while(j > 0 && by_field(record, scan_top[j - 1]) > 0){
+            scan_top[j] = scan_top[j - 1];
+            j--;
+        }
+        scan_top[j] = record;
+    }
+    t1 = bench_now_ns();
+    _report_total(report, "oa_scan", kind, DIST_RANDOM, size, 1, "top_10", t1 - t0);
+    t0 = bench_now_ns();
+    int found = oa_index_top(arr, slot, BENCH_TOP_K, index_top);
+    t1 = bench_now_ns();
+    _check(found == kept && (found == 0 || memcmp(scan_top, index_top, (size_t)found * sizeof(void*)) == 0),
+           "secondary_index", "top_10", found);
+    _report_total(report, "secondary_index", kind, DIST_RANDOM, size, 1, "top_10", t1 - t0);
+    oa_free(arr);
+}
+
+/**
+ * @brief (Private) Times column scans over heap records (array of pointers) and over a record store.
+ *
+ * The heap records are allocated in random order and visited in id
+ * order, like a container would, so consecutive rows are scattered.
+ */
+static void _run_columns(const BenchConfig* cfg, BenchReport* report, const RecordKind* kind, long size){
+    int is_student = strcmp(kind->name, "student") == 0;
+    long* order = (long*)malloc((size_t)size * sizeof(long));
+    void** records = (void**)calloc((size_t)size, sizeof(void*));
+    int* rows = (int*)malloc((size_t)size * sizeof(int));
+    StudentStore* students = is_student ? sstore_create((int)size) : NULL;
+    ProductStore* products = is_student ? NULL : pstore_create((int)size);
+    if(order == NULL || records == NULL || rows == NULL || (students == NULL && products == NULL)){
+        fprintf(stderr, "Error: not enough memory for size %ld\n", size);
+        goto cleanup;
+    }
+    BenchRng rng;
+    rng_seed(&rng, cfg->seed + 40);
+    for(long i = 0; i < size; i++) order[i] = i;
+    rng_shuffle_longs(&rng, order, size);
+    for(long i = 0; i < size; i++){
+        long row = order[i];
+        records[row] = malloc(kind->size);
+        if(records[row] == NULL){
+            fprintf(stderr, "Error: not enough memory for size %ld\n", size);
+            goto cleanup;
+        }
+        kind->init(records[row], 2 * row);
+    }
+    for(long i = 0; i < size; i++){
+        if(is_student){
+            Student* st = (Student*)records[i];
+            sstore_append(students, st->id, st->name, st->gpa);
+        }
+        else{
+            Product* pr = (Product*)records[i];
+            pstore_append(products, pr->id, pr->name, pr->price, pr->cost, pr->stock);
+        }
+    }
+    uint64_t t0, t1;
+    const char* op = is_student ? "filter_gpa" : "sum_stock";
+    long long heap_result = 0, store_result = 0;
+
+    t0 = bench_now_ns();
+    if(is_student){
+        int matches = 0;
+        for(long i = 0; i < size; i++){
+            rows[matches] = (int)i;
+            matches += ((Student*)records[i])->gpa > 5.0f;
+        }
+        heap_result = matches;
+    }
+    else{
+        for(long i = 0; i < size; i++) heap_result += ((Product*)records[i])->stock;
+    }
+    t1 = bench_now_ns();
+    _report_total(report, "heap_records", kind, DIST_RANDOM, size, size, op, t1 - t0);
+
+    t0 = bench_now_ns();
+    if(is_student) store_result = sstore_filter_gpa_above(students, 5.0f, rows);
+    else store_result = pstore_sum_stock(products);
+    t1 = bench_now_ns();
+    _check(store_result == heap_result, "record_store", op, (long)store_result);
+    _report_total(report, "record_store", kind, DIST_RANDOM, size, size, op, t1 - t0);
+    _run_secondary(report, kind, records, size);
+
+cleanup:
+    if(records != NULL){
+        for(long i = 0; i < size; i++) free(records[i]);
+    }
+    free(order);
+    free(records);
+    free(rows);
+    sstore_free(students);
+    pstore_free(products);
+}
+
+/**
+ * @brief (Private) Frees every record of a container loaded by _run_snapshot, then the container.
+ */
+static void _free_loaded(const RecordKind* kind, OrderedArray* arr, LinkedList* list){
+    if(arr != NULL){
+        for(int i = 0; i < arr->counter; i++) kind->free_record(arr->data[i]);
+        oa_free(arr);
+    }
+    if(list != NULL){
+        for(Node* node = list->head; node != NULL; node = node->next) kind->free_record(node->data);
+        list_free(list);
+    }
+}
+
+/**
+ * @brief (Private) Compares CSV startup with snapshot startup and times snapshot lookups.
+ */
+static void _run_snapshot(const BenchConfig* cfg, BenchReport* report, const RecordKind* kind,
+                          KeyDistribution dist, long size){
+    static const char* CSV_PATH = "benchmark_rows.tmp.csv";
+    static const char* SNAP_PATH = "benchmark_rows.tmp.snap";
+    static const char* WAL_PATH = "benchmark_rows.tmp.wal";
+    int is_student = strcmp(kind->name, "student") == 0;
+    SnapshotType type = is_student ? SNAP_STUDENTS : SNAP_PRODUCTS;
+    long ops = cfg->ops;
+    char* record = (char*)malloc(kind->size);
+    BenchSamples samples;
+    FILE* out = fopen(CSV_PATH, "w");
+    if(record == NULL || out == NULL || !samples_init(&samples, ops)){
+        fprintf(stderr, "Error: couldn't prepare %s\n", CSV_PATH);
+        free(record);
+        if(out != NULL) fclose(out);
+        return;
+    }
+    for(long i = 0; i < size; i++){
+        kind->init(record, 2 * i);
+        kind->write_csv(out, record);
+    }
+    fclose(out);
+    uint64_t t0, t1;
+
+    /* startup from CSV: parse, then one bulk insert */
+    OrderedArray* arr = NULL;
+    LinkedList* list = NULL;
+    t0 = bench_now_ns();
+    int count = 0;
+    void** rows = kind->load_csv(CSV_PATH, &count, NULL);
+    int inserted = 0;
+    if(rows != NULL && is_student){
+        arr = oa_create(count > 0 ? count : 1, kind->compare);
+        if(arr != NULL) inserted = oa_insert_batch(arr, rows, count);
+    }
+    else if(rows != NULL){
+        list = list_create(kind->compare);
+        if(list != NULL) inserted = list_insert_batch(list, rows, count);
+    }
+    t1 = bench_now_ns();
+    _check(inserted == size, "csv", "startup", inserted);
+    _report_total(report, "csv", kind, dist, size, size, "startup", t1 - t0);
+    for(int i = inserted; rows != NULL && i < count; i++) kind->free_record(rows[i]);
+    free(rows);
+
+    int written = is_student ? snap_write_students(SNAP_PATH, arr) : snap_write_products(SNAP_PATH, list);
+    _check(written, "snapshot", "write", 0);
+
+    t0 = bench_now_ns();
+    Snapshot* snap = snap_open(SNAP_PATH, type, 0);
+    t1 = bench_now_ns();
+    _check(snap != NULL && snap->count == (size_t)size, "snapshot", "startup", 0);
+    _report_total(report, "snapshot", kind, dist, size, size, "startup", t1 - t0);
+    snap_close(snap);
+
+    t0 = bench_now_ns();
+    snap = snap_open(SNAP_PATH, type, 1);
+    t1 = bench_now_ns();
+    _check(snap != NULL, "snapshot", "startup_verified", 0);
+    _report_total(report, "snapshot", kind, dist, size, size, "startup_verified", t1 - t0);
+
+    if(snap != NULL){
+        KeyGenerator gen;
+        keygen_init(&gen, dist, size, cfg->seed);
+        for(long k = 0; k < ops; k++){
+            long id = 2 * keygen_next(&gen);
+            const void* res;
+            t0 = bench_now_ns();
+            res = is_student ? (const void*)snap_find_student(snap, id) : (const void*)snap_find_product(snap, id);
+            t1 = bench_now_ns();
+            _record(&samples, t0, t1);
+            _check(res != NULL && *(const int64_t*)res == id, "snapshot", "find_hit", id);
+        }
+        _emit(report, &samples, "snapshot", kind, dist, size, "find_hit");
+        snap_close(snap);
+    }
+
+    /* change log: 'ops' updates with group commit, then one fsync per update, replay and compaction */
+    if(arr != NULL || list != NULL){
+        remove(WAL_PATH);
+        ChangeLog* log = wal_open(WAL_PATH, type, WAL_DEFAULT_GROUP);
+        KeyGenerator gen;
+        keygen_init(&gen, dist, size, cfg->seed + 50);
+        int logged = log != NULL;
+        t0 = bench_now_ns();
+        for(long k = 0; logged && k < ops; k++){
+            kind->init(record, 2 * keygen_next(&gen));
+            logged = is_student ? wal_log_student(log, (Student*)record) : wal_log_product(log, (Product*)record);
+        }
+        logged = logged && wal_commit(log);
+        t1 = bench_now_ns();
+        _check(logged, "wal", "log_group", 0);
+        _report_total(report, "wal", kind, dist, size, ops, "log_group", t1 - t0);
+
+        long synced = ops < 256 ? ops : 256;
+        if(log != NULL) log->group_size = 1;
+        t0 = bench_now_ns();
+        for(long k = 0; logged && k < synced; k++){
+            kind->init(record, 2 * keygen_next(&gen));
+            logged = is_student ? wal_log_student(log, (Student*)record) : wal_log_product(log, (Product*)record);
+        }
+        t1 = bench_now_ns();
+        _check(logged && wal_close(log), "wal", "log_fsync_each", 0);
+        _report_total(report, "wal", kind, dist, size, synced, "log_fsync_each", t1 - t0);
+
+        WalReplayReport replay;
+        t0 = bench_now_ns();
+        int replayed = is_student ? wal_replay_students(WAL_PATH, arr, &replay) : wal_replay_products(WAL_PATH, list, &replay);
+        t1 = bench_now_ns();
+        _check(replayed && replay.applied == ops + synced, "wal", "replay", replay.applied);
+        _report_total(report, "wal", kind, dist, size, ops + synced, "replay", t1 - t0);
+
+        log = wal_open(WAL_PATH, type, WAL_DEFAULT_GROUP);
+        t0 = bench_now_ns();
+        int compacted = log != NULL && (is_student ? wal_compact_students(log, arr, SNAP_PATH, WAL_COMPACT_SNAPSHOT)
+                                                   : wal_compact_products(log, list, SNAP_PATH, WAL_COMPACT_SNAPSHOT));
+        t1 = bench_now_ns();
+        _check(compacted && log->entries == 0, "wal", "compact", 0);
+        _report_total(report, "wal", kind, dist, size, size, "compact", t1 - t0);
+        wal_close(log);
+        remove(WAL_PATH);
+    }
+    _free_loaded(kind, arr, list);
+    remove(CSV_PATH);
+    remove(SNAP_PATH);
+    samples_free(&samples);
+    free(record);
+}
+
+/*Start line shared by the threads of one timed phase*/
+typedef struct{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int ready;
+    int go;
+}ThreadGate;
+
+typedef enum{
+    THREAD_FIND,
+    THREAD_INSERT,
+    THREAD_REMOVE
+}ThreadOp;
+
+/*Work of one benchmark thread in one phase*/
+typedef struct{
+    const BenchDriver* drv;
+    void* container;
+    void** items;       /*Elements to find, insert or remove*/
+    long count;
+    ThreadOp op;
+    long failures;
+    ThreadGate* gate;
+}ThreadWork;
+
+/**
+ * @brief (Private) Parks the calling thread until the phase starts.
+ */
+static void _gate_wait(ThreadGate* gate){
+    pthread_mutex_lock(&gate->lock);
+    gate->ready++;
+    pthread_cond_broadcast(&gate->cond);
+    while(!gate->go) pthread_cond_wait(&gate->cond, &gate->lock);
+    pthread_mutex_unlock(&gate->lock);
+}
+
+/**
+ * @brief (Private) Thread body: waits at the gate, then runs its operations.
+ *
+ * A find or remove succeeds when it returns the very element that was
+ * inserted with that id.
+ */
+static void* _thread_main(void* arg){
+    ThreadWork* work = (ThreadWork*)arg;
+    _gate_wait(work->gate);
+    long failures = 0;
+    for(long k = 0; k < work->count; k++){
+        void* item = work->items[k];
+        if(work->op == THREAD_FIND) failures += work->drv->find(work->container, item) != item;
+        else if(work->op == THREAD_INSERT) failures += !work->drv->insert(work->container, item);
+        else failures += work->drv->remove(work->container, item) != item;
+    }
+    work->failures = failures;
+    lfl_thread_exit();      /*Frees this thread's reclamation slot if it used a lock-free list*/
+    return NULL;
+}
+
+/**
+ * @brief (Private) Runs 'body' on 'threads' threads and returns the wall time.
+ *
+ * Every args[t] must refer to 'gate', on which the body waits first: the
+ * clock starts once every thread is parked there, so thread creation is
+ * not timed.
+ *
+ * @return Elapsed nanoseconds, or 0 if a thread couldn't be started.
+ */
+static uint64_t _run_threads(void* (*body)(void*), void** args, int threads, ThreadGate* gate){
+    pthread_t ids[64];
+    int started = 0;
+    pthread_mutex_init(&gate->lock, NULL);
+    pthread_cond_init(&gate->cond, NULL);
+    gate->ready = 0;
+    gate->go = 0;
+    for(int t = 0; t < threads; t++){
+        if(pthread_create(&ids[t], NULL, body, args[t]) != 0) break;
+        started++;
+    }
+    pthread_mutex_lock(&gate->lock);
+    while(gate->ready < started) pthread_cond_wait(&gate->cond, &gate->lock);
+    uint64_t t0 = bench_now_ns();
+    gate->go = 1;
+    pthread_cond_broadcast(&gate->cond);
+    pthread_mutex_unlock(&gate->lock);
+    for(int t = 0; t < started; t++) pthread_join(ids[t], NULL);
+    uint64_t t1 = bench_now_ns();
+    pthread_cond_destroy(&gate->cond);
+    pthread_mutex_destroy(&gate->lock);
+    return started == threads ? t1 - t0 : 0;
+}
+
+/**
+ * @brief (Private) Runs one phase of the threads suite and sums the failures of its threads.
+ */
+static uint64_t _run_phase(ThreadWork* works, int threads, long* failures){
+    ThreadGate gate;
+    void* args[64];
+    for(int t = 0; t < threads; t++){
+        works[t].gate = &gate;
+        args[t] = &works[t];
+    }
+    uint64_t elapsed = _run_threads(_thread_main, args, threads, &gate);
+    *failures = 0;
+    for(int t = 0; t < threads; t++) *failures += works[t].failures;
+    return elapsed;
+}
+
+/**
+ * @brief (Private) Measures how one thread-safe container scales from 1 to cfg->max_threads threads.
+ */
+static void _run_threads_suite(const BenchConfig* cfg, BenchReport* report, const BenchDriver* drv,
+                               const RecordKind* kind, KeyDistribution dist, long size){
+    static const char* OP_NAMES[] = {"find", "insert", "remove"};
+    int max_threads = cfg->max_threads;
+    long ops = cfg->ops;
+    char* present = (char*)malloc((size_t)size * kind->size);
+    char* fresh = (char*)malloc((size_t)size * kind->size);
+    long* ranks = (long*)malloc((size_t)size * sizeof(long));
+    void** items = (void**)malloc((size_t)max_threads * (size_t)ops * sizeof(void*));
+    ThreadWork* works = (ThreadWork*)calloc((size_t)max_threads, sizeof(ThreadWork));
+    void* container = drv->create(size, kind);
+    if(present == NULL || fresh == NULL || ranks == NULL || items == NULL || works == NULL || container == NULL){
+        fprintf(stderr, "Error: not enough memory for %s size %ld\n", drv->name, size);
+        free(present); free(fresh); free(ranks); free(items); free(works);
+        if(container != NULL) drv->destroy(container);
+        return;
+    }
+    for(long i = 0; i < size; i++){
+        long rank = drv->prefill_descending ? size - 1 - i : i;
+        kind->init(present + rank * kind->size, 2 * rank);
+        kind->init(fresh + i * kind->size, 2 * i + 1);
+        _check(drv->insert(container, present + rank * kind->size), drv->name, "prefill", 2 * rank);
+        ranks[i] = i;
+    }
+    BenchRng rng;
+    rng_seed(&rng, cfg->seed);
+    rng_shuffle_longs(&rng, ranks, size);
+
+    for(int threads = 1; threads <= max_threads; threads = _next_thread_count(threads, max_threads)){
+        char op_name[32];
+        long failures;
+        uint64_t elapsed;
+
+        /* every thread: 'ops' hits drawn from the distribution with its own seed */
+        for(int t = 0; t < threads; t++){
+            KeyGenerator gen;
+            keygen_init(&gen, dist, size, cfg->seed + 1 + (uint64_t)t);
+            works[t] = (ThreadWork){drv, container, items + (size_t)t * ops, ops, THREAD_FIND, 0, NULL};
+            for(long k = 0; k < ops; k++) works[t].items[k] = present + keygen_next(&gen) * kind->size;
+        }
+        elapsed = _run_phase(works, threads, &failures);
+        _check(elapsed > 0 && failures == 0, drv->name, "find", failures);
+        snprintf(op_name, sizeof(op_name), "%s_%dt", OP_NAMES[THREAD_FIND], threads);
+        _report_total(report, drv->name, kind, dist, size, (long)threads * ops, op_name, elapsed);
+
+        /* disjoint slices of fresh (odd) ids, spread over the whole key range */
+        long share = ops < size / threads ? ops : size / threads;
+        if(share == 0) continue;
+        for(int op = THREAD_INSERT; op <= THREAD_REMOVE; op++){
+            for(int t = 0; t < threads; t++){
+                works[t] = (ThreadWork){drv, container, items + (size_t)t * ops, share, (ThreadOp)op, 0, NULL};
+                for(long k = 0; k < share; k++) works[t].items[k] = fresh + ranks[t * share + k] * kind->size;
+            }
+            elapsed = _run_phase(works, threads, &failures);
+            _check(elapsed > 0 && failures == 0, drv->name, OP_NAMES[op], failures);
+            snprintf(op_name, sizeof(op_name), "%s_%dt", OP_NAMES[op], threads);
+            _report_total(report, drv->name, kind, dist, size, (long)threads * share, op_name, elapsed);
+        }
+    }
+    drv->destroy(container);
+    free(present); free(fresh); free(ranks); free(items); free(works);
+}
+
+/**
+ * @brief (Private) Reports the timed finds of a stats run along with the container's counters.
+ *
+ * In JSON the row carries the cs_dump_json object as "container_stats";
+ * in a table the counters follow on an indented line.
+ */
+static void _emit_stats(BenchReport* report, BenchSamples* s, const char* structure, const RecordKind* kind,
+                        KeyDistribution dist, long size, const char* op, const ContainerStats* stats){
+    BenchStats summary;
+    samples_summarize(s, &summary);
+    char* json = NULL;
+    size_t length = 0;
+    if(report->format == FORMAT_JSON){
+        FILE* memory = open_memstream(&json, &length);
+        if(memory != NULL){
+            _check(cs_dump_json(stats, structure, memory), structure, "stats_json", size);
+            fclose(memory);
+        }
+        if(json != NULL && length > 0 && json[length - 1] == '\n') json[length - 1] = '\0';
+    }
+    report_row_extra(report, structure, kind->name, dist_name(dist), size, op, &summary, "container_stats", json);
+    if(report->format == FORMAT_TABLE){
+        fprintf(report->out, "%14s comparisons=%llu shifts=%llu hops=%llu allocations=%llu frees=%llu bytes_in_use=%lld\n",
+                "", (unsigned long long)stats->comparisons, (unsigned long long)stats->shifts,
+                (unsigned long long)stats->hops, (unsigned long long)stats->allocations,
+                (unsigned long long)stats->frees, (long long)stats->bytes_in_use);
+    }
+    free(json);
+    samples_reset(s);
+}
+
+/**
+ * @brief (Private) Checks the stats build's counters against finds whose cost is known exactly.
+ *
+ * Appending in order never shifts. Every binary find (plain and keyed
+ * array) makes at most ceil(log2 n) + 1 comparisons and no shift or hop;
+ * a linear find of the element at rank r in a sorted LinkedList makes
+ * exactly r + 1 comparisons and r hops. Each find must also land in the
+ * find histogram once.
+ */
+static void _run_stats(const BenchConfig* cfg, BenchReport* report, const RecordKind* kind,
+                       KeyDistribution dist, long size){
+    long ops = cfg->ops;
+    int with_list = size <= cfg->list_limit;
+    char* present = (char*)malloc((size_t)size * kind->size);
+    char* probe = (char*)malloc(kind->size);
+    long* hits = (long*)malloc((size_t)ops * sizeof(long));
+    OrderedArray* arr = oa_create((int)size, kind->compare);
+    OrderedArray* keyed = oa_create_keyed((int)size, kind->key_of);
+    LinkedList* list = with_list ? list_create(kind->compare) : NULL;
+    BenchSamples samples;
+    if(present == NULL || probe == NULL || hits == NULL || arr == NULL || keyed == NULL
+       || (with_list && list == NULL) || !samples_init(&samples, ops)){
+        fprintf(stderr, "Error: not enough memory for size %ld\n", size);
+        free(present); free(probe); free(hits); oa_free(arr); oa_free(keyed); list_free(list);
+        return;
+    }
+    for(long i = 0; i < size; i++){
+        kind->init(present + i * kind->size, 2 * i);
+        oa_insert_sorted(arr, present + i * kind->size);
+        oa_insert_sorted(keyed, present + i * kind->size);
+    }
+    /* descending, so every list insert stops at the head */
+    for(long i = size - 1; with_list && i >= 0; i--) list_insert_sorted(list, present + i * kind->size);
+    _check(oa_stats(arr)->shifts == 0, "oa_stats", "prefill_shifts", (long)oa_stats(arr)->shifts);
+    _check(oa_stats(keyed)->shifts == 0, "oa_keyed_stats", "prefill_shifts", (long)oa_stats(keyed)->shifts);
+    cs_reset(oa_stats(arr));
+    cs_reset(oa_stats(keyed));
+    if(with_list) cs_reset(list_stats(list));
+
+    kind->init(probe, 0);
+    KeyGenerator gen;
+    keygen_init(&gen, dist, size, cfg->seed);
+    for(long k = 0; k < ops; k++) hits[k] = 2 * keygen_next(&gen);
+    unsigned long long limit = 1;
+    while(size > 1 && (1L << (limit - 1)) < size) limit++;
+    uint64_t t0, t1;
+    void* res;
+
+    ContainerStats* stats = oa_stats(arr);
+    for(long k = 0; k < ops; k++){
+        kind->set_id(probe, hits[k]);
+        unsigned long long before = stats->comparisons;
+        t0 = bench_now_ns();
+        res = oa_find_binary(arr, probe);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res != NULL && kind->key_of(res) == hits[k], "oa_stats", "find_hit", hits[k]);
+        _check(stats->comparisons - before <= limit, "oa_stats", "find_comparisons", hits[k]);
+    }
+    _check(stats->latency[CS_OP_FIND].count == (unsigned long long)ops, "oa_stats", "find_histogram", ops);
+    _check(stats->shifts == 0 && stats->hops == 0, "oa_stats", "find_no_moves", size);
+    _emit_stats(report, &samples, "oa_stats", kind, dist, size, "find_hit", stats);
+
+    stats = oa_stats(keyed);
+    for(long k = 0; k < ops; k++){
+        unsigned long long before = stats->comparisons;
+        t0 = bench_now_ns();
+        res = oa_find_key(keyed, hits[k]);
+        t1 = bench_now_ns();
+        _record(&samples, t0, t1);
+        _check(res != NULL && kind->key_of(res) == hits[k], "oa_keyed_stats", "find_hit", hits[k]);
+        _check(stats->comparisons - before <= limit, "oa_keyed_stats", "find_comparisons", hits[k]);
+    }
+    _check(stats->latency[CS_OP_FIND].count == (unsigned long long)ops, "oa_keyed_stats", "find_histogram", ops);
+    _emit_stats(report, &samples, "oa_keyed_stats", kind, dist, size, "find_hit", stats);
+
+    if(with_list){
+        stats = list_stats(list);
+        for(long k = 0; k < ops; k++){
+            kind->set_id(probe, hits[k]);
+            unsigned long long comparisons = stats->comparisons, hops = stats->hops;
+            t0 = bench_now_ns();
+            res = list_find_linear(list, probe);
+            t1 = bench_now_ns();
+            _record(&samples, t0, t1);
+            unsigned long long rank = (unsigned long long)(hits[k] / 2);
+            _check(res != NULL && kind->key_of(res) == hits[k], "list_stats", "find_hit", hits[k]);
+            _check(stats->comparisons - comparisons == rank + 1 && stats->hops - hops == rank,
+                   "list_stats", "find_walk", hits[k]);
+        }
+        _check(stats->latency[CS_OP_FIND].count == (unsigned long long)ops, "list_stats", "find_histogram", ops);
+        _emit_stats(report, &samples, "list_stats", kind, dist, size, "find_hit", stats);
+    }
+
+    samples_free(&samples);
+    oa_free(arr); oa_free(keyed); list_free(list);
+    free(present); free(probe); free(hits);
+}
+
+/*One thread of the lock-free stress test*/
+typedef struct{
+    LockFreeList* list;
+    char* records;          /*The element (or, for copies, the template) with id k is records + k * record_size*/
+    size_t record_size;
+    int copies;             /*1: insert heap copies, which the list frees once removed*/
+    KeyFunc key_of;
+    KeyGenerator gen;
+    BenchRng rng;
+    long ops;
+    int* net;               /*net[k]: successful inserts minus removes of id k by this thread*/
+    long failures;          /*Finds/removes that returned a foreign element*/
+    ThreadGate* gate;
+}StressWork;
+
+/**
+ * @brief (Private) Stress thread: 50% find, 25% insert, 25% remove on ids shared by all threads.
+ *
+ * Without copies, results must be the very element of the id. With
+ * copies, every insert is a fresh heap record and the list frees removed
+ * ones (lfl_set_release), so results are checked by id inside
+ * lfl_pin/lfl_unpin.
+ */
+static void* _stress_main(void* arg){
+    StressWork* work = (StressWork*)arg;
+    _gate_wait(work->gate);
+    long failures = 0;
+    for(long k = 0; k < work->ops; k++){
+        long id = keygen_next(&work->gen);
+        void* item = work->records + (size_t)id * work->record_size;
+        uint64_t roll = rng_below(&work->rng, 4);
+        if(roll == 2){
+            void* inserted = item;
+            if(work->copies && (inserted = malloc(work->record_size)) != NULL){
+                memcpy(inserted, item, work->record_size);
+            }
+            if(inserted != NULL && lfl_insert_sorted(work->list, inserted)) work->net[id]++;
+            else if(work->copies) free(inserted);
+            continue;
+        }
+        if(!lfl_pin()){
+            failures++;
+            continue;
+        }
+        void* result = roll < 2 ? lfl_find(work->list, item) : lfl_remove(work->list, item);
+        if(result != NULL){
+            failures += work->copies ? work->key_of(result) != id : result != item;
+            if(roll == 3) work->net[id]--;
+        }
+        lfl_unpin();
+    }
+    work->failures = failures;
+    lfl_thread_exit();
+    return NULL;
+}
+
+/**
+ * @brief (Private) Hammers one LockFreeList from many threads and checks the result.
+ *
+ * Runs on a keyed list of preallocated elements, and on a CompareFunc
+ * list of heap records that it frees once removed, while other threads
+ * may still be comparing against them. Every thread counts its own
+ * successful inserts and removes per id. Afterwards each id must be
+ * present exactly when the ids it started with plus all threads' net
+ * changes equal 1 (never below 0 or above 1: no lost or duplicated
+ * update), the list must still be strictly ordered and its counter must
+ * match.
+ */
+static void _run_stress(const BenchConfig* cfg, BenchReport* report, const RecordKind* kind,
+                        KeyDistribution dist, long size, int keyed){
+    const char* name = keyed ? "lockfree_list" : "lockfree_list_cmp";
+    int threads = cfg->max_threads < 4 ? 4 : cfg->max_threads;
+    long ops = cfg->ops;
+    char* records = (char*)malloc((size_t)size * kind->size);
+    int* net = (int*)calloc((size_t)threads * (size_t)size, sizeof(int));
+    StressWork* works = (StressWork*)calloc((size_t)threads, sizeof(StressWork));
+    LockFreeList* list = keyed ? lfl_create_keyed(kind->key_of) : lfl_create(kind->compare);
+    if(records == NULL || net == NULL || works == NULL || list == NULL){
+        fprintf(stderr, "Error: not enough memory for the stress test of size %ld\n", size);
+        free(records); free(net); free(works); lfl_free(list);
+        return;
+    }
+    if(!keyed) lfl_set_release(list, kind->free_record);
+    /* start with every even id present, inserted from the back (O(1) each) */
+    for(long id = size - 1; id >= 0; id--){
+        void* item = records + id * kind->size;
+        kind->init(item, id);
+        if(id % 2 != 0) continue;
+        if(!keyed){
+            void* copy = malloc(kind->size);
+            if(copy != NULL) memcpy(copy, item, kind->size);
+            item = copy;
+        }
+        int inserted = item != NULL && lfl_insert_sorted(list, item);
+        if(!inserted && !keyed) free(item);
+        _check(inserted, name, "prefill", id);
+    }
+    /* give the prefill's reclamation slot back: up to 64 workers need one each */
+    lfl_thread_exit();
+    ThreadGate gate;
+    void* args[64];
+    for(int t = 0; t < threads; t++){
+        works[t].list = list;
+        works[t].records = records;
+        works[t].record_size = kind->size;
+        works[t].copies = !keyed;
+        works[t].key_of = kind->key_of;
+        keygen_init(&works[t].gen, dist, size, cfg->seed + (uint64_t)t);
+        rng_seed(&works[t].rng, cfg->seed * 31 + (uint64_t)t);
+        works[t].ops = ops;
+        works[t].net = net + (size_t)t * size;
+        works[t].gate = &gate;
+        args[t] = &works[t];
+    }
+    uint64_t elapsed = _run_threads(_stress_main, args, threads, &gate);
+    _check(elapsed > 0, name, "stress", threads);
+
+    long failures = 0, expected_count = 0;
+    for(int t = 0; t < threads; t++) failures += works[t].failures;
+    _check(failures == 0, name, "stress_foreign_element", failures);
+    for(long id = 0; id < size; id++){
+        long present = id % 2 == 0;
+        for(int t = 0; t < threads; t++) present += net[(size_t)t * size + id];
+        _check(present == 0 || present == 1, name, "stress_lost_update", id);
+        _check((lfl_find(list, records + id * kind->size) != NULL) == (present == 1), name, "stress_membership", id);
+        expected_count += present;
+    }
+    _check(lfl_validate(list), name, "stress_order", 0);
+    _check(lfl_count(list) == expected_count, name, "stress_count", lfl_count(list));
+
+    char op_name[32];
+    snprintf(op_name, sizeof(op_name), "stress_%dt", threads);
+    _report_total(report, name, kind, dist, size, (long)threads * ops, op_name, elapsed);
+    /* the copies belong to the list: remove them all, lfl_collect frees them */
+    for(long id = 0; !keyed && id < size; id++) lfl_remove(list, records + id * kind->size);
+    lfl_free(list);
+    lfl_thread_exit();
+    lfl_collect();
+    free(records); free(net); free(works);
+}
+
+static void _usage(const char* prog){
+    printf("Usage: %s [options]\n", prog);
+    printf("  --sizes N[,N...]     Container sizes (default 10000,100000,1000000)\n");
+    printf("  --ops N              Timed operations per phase (default 2000)\n");
+    printf("  --dist LIST|all      sequential,random,reverse,zipfian (default all)\n");
+    printf("  --records LIST|all   student,product (default all)\n");
+    printf("  --structures LIST|all");
+    for(int i = 0; i < bench_driver_count(); i++) printf("%s%s", i == 0 ? " " : ",", bench_driver_at(i)->name);
+    printf("\n");
+    printf("  --suites LIST|all    ops,lookup,csv,columns,snapshot,threads,stress,stats (default all)\n");
+    printf("  --list-limit N       Skip O(n)-lookup structures above N elements (default 100000)\n");
+    printf("  --threads N          Highest thread count of the threads suite (default: online CPUs)\n");
+    printf("  --seed N             Workload seed (default 42)\n");
+    printf("  --format F           table, csv or json (default table)\n");
+    printf("  --out FILE           Write results to FILE instead of stdout\n");
+}
+
+/**
+ * @brief (Private) Splits a comma-separated list and calls 'select' on each item.
+ * @return 1 if every item was accepted, 0 otherwise.
+ */
+static int _parse_list(const char* arg, int (*select)(BenchConfig*, const char*), BenchConfig* cfg){
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "%s", arg);
+    for(char* item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ",")){
+        if(!select(cfg, item)){
+            fprintf(stderr, "Error: unknown value '%s'\n", item);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int _select_dist(BenchConfig* cfg, const char* name){
+    KeyDistribution d;
+    if(strcmp(name, "all") == 0){
+        for(int i = 0; i < DIST_COUNT; i++) cfg->use_dist[i] = 1;
+        return 1;
+    }
+    if(!dist_parse(name, &d)) return 0;
+    cfg->use_dist[d] = 1;
+    return 1;
+}
+
+static int _select_record(BenchConfig* cfg, const char* name){
+    for(int i = 0; i < bench_record_count(); i++){
+        if(strcmp(name, "all") == 0 || strcmp(name, bench_record_at(i)->name) == 0){
+            cfg->use_record[i] = 1;
+            if(strcmp(name, "all") != 0) return 1;
+        }
+    }
+    return strcmp(name, "all") == 0;
+}
+
+static int _select_driver(BenchConfig* cfg, const char* name){
+    for(int i = 0; i < bench_driver_count(); i++){
+        if(strcmp(name, "all") == 0 || strcmp(name, bench_driver_at(i)->name) == 0){
+            cfg->use_driver[i] = 1;
+            if(strcmp(name, "all") != 0) return 1;
+        }
+    }
+    return strcmp(name, "all") == 0;
+}
+
+static int _select_suite(BenchConfig* cfg, const char* name){
+    for(int i = 0; i < SUITE_COUNT; i++){
+        if(strcmp(name, "all") == 0 || strcmp(name, SUITE_NAMES[i]) == 0){
+            cfg->use_suite[i] = 1;
+            if(strcmp(name, "all") != 0) return 1;
+        }
+    }
+    return strcmp(name, "all") == 0;
+}
+
+static int _select_size(BenchConfig* cfg, const char* text){
+    double value = strtod(text, NULL);
+    if(value < 1 || cfg->size_count == MAX_SIZES) return 0;
+    cfg->sizes[cfg->size_count++] = (long)value;
+    return 1;
+}
+
+int main(int argc, char** argv){
+    BenchConfig cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.ops = 2000;
+    cfg.list_limit = 100000;
+    cfg.seed = 42;
+    cfg.max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    cfg.format = FORMAT_TABLE;
+    int dist_set = 0, record_set = 0, driver_set = 0, suite_set = 0;
+
+    for(int i = 1; i < argc; i++){
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        int ok = 1;
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0){
+            _usage(argv[0]);
+            return 0;
+        }
+        if(val == NULL){
+            fprintf(stderr, "Error: missing value for %s\n", arg);
+            return 2;
+        }
+        if(strcmp(arg, "--sizes") == 0) ok = _parse_list(val, _select_size, &cfg);
+        else if(strcmp(arg, "--ops") == 0) cfg.ops = (long)strtod(val, NULL);
+        else if(strcmp(arg, "--dist") == 0){ ok = _parse_list(val, _select_dist, &cfg); dist_set = 1; }
+        else if(strcmp(arg, "--records") == 0){ ok = _parse_list(val, _select_record, &cfg); record_set = 1; }
+        else if(strcmp(arg, "--structures") == 0){ ok = _parse_list(val, _select_driver, &cfg); driver_set = 1; }
+        else if(strcmp(arg, "--suites") == 0){ ok = _parse_list(val, _select_suite, &cfg); suite_set = 1; }
+        else if(strcmp(arg, "--list-limit") == 0) cfg.list_limit = (long)strtod(val, NULL);
+        else if(strcmp(arg, "--threads") == 0) cfg.max_threads = (int)strtol(val, NULL, 10);
+        else if(strcmp(arg, "--seed") == 0) cfg.seed = strtoull(val, NULL, 10);
+        else if(strcmp(arg, "--out") == 0) cfg.out_path = val;
+        else if(strcmp(arg, "--format") == 0){
+            if(strcmp(val, "table") == 0) cfg.format = FORMAT_TABLE;
+            else if(strcmp(val, "csv") == 0) cfg.format = FORMAT_CSV;
+            else if(strcmp(val, "json") == 0) cfg.format = FORMAT_JSON;
+            else ok = 0;
+        }
+        else ok = 0;
+        if(!ok){
+            fprintf(stderr, "Error: invalid option %s %s (see --help)\n", arg, val);
+            return 2;
+        }
+        i++;
+    }
+    if(cfg.size_count == 0){
+        cfg.sizes[0] = 10000;
+        cfg.sizes[1] = 100000;
+        cfg.sizes[2] = 1000000;
+        cfg.size_count = 3;
+    }
+    if(cfg.ops < 1) cfg.ops = 1;
+    if(cfg.max_threads < 1) cfg.max_threads = 1;
+    if(cfg.max_threads > 64) cfg.max_threads = 64;
+    if(!dist_set) _select_dist(&cfg, "all");
+    if(!record_set) _select_record(&cfg, "all");
+    if(!driver_set) _select_driver(&cfg, "all");
+    if(!suite_set) _select_suite(&cfg, "all");
+
+    FILE* out = stdout;
+    if(cfg.out_path != NULL){
+        out = fopen(cfg.out_path, "w");
+        if(out == NULL){
+            fprintf(stderr, "Error: Couldn't open the file %s\n", cfg.out_path);
+            return 1;
+        }
+    }
+
+    timer_overhead = bench_timer_overhead_ns();
+    BenchReport report;
+    report_begin(&report, out, cfg.format, cfg.seed, cfg.ops);
+    for(int d = 0; d < bench_driver_count() && cfg.use_suite[SUITE_OPS]; d++){
+        if(!cfg.use_driver[d]) continue;
+        const BenchDriver* drv = bench_driver_at(d);
+        for(int r = 0; r < bench_record_count(); r++){
+            if(!cfg.use_record[r]) continue;
+            for(int k = 0; k < DIST_COUNT; k++){
+                if(!cfg.use_dist[k]) continue;
+                for(int s = 0; s < cfg.size_count; s++){
+                    if(drv->linear && cfg.sizes[s] > cfg.list_limit) continue;
+                    _run_ops(&cfg, &report, drv, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s]);
+                }
+            }
+        }
+    }
+    for(int r = 0; r < bench_record_count() && cfg.use_suite[SUITE_LOOKUP]; r++){
+        if(!cfg.use_record[r]) continue;
+        for(int k = 0; k < DIST_COUNT; k++){
+            if(!cfg.use_dist[k]) continue;
+            for(int s = 0; s < cfg.size_count; s++){
+                _run_lookup(&cfg, &report, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s]);
+            }
+        }
+    }
+    for(int r = 0; r < bench_record_count() && cfg.use_suite[SUITE_CSV]; r++){
+        if(!cfg.use_record[r]) continue;
+        for(int k = 0; k < DIST_COUNT; k++){
+            if(!cfg.use_dist[k]) continue;
+            for(int s = 0; s < cfg.size_count; s++){
+                _run_csv(&cfg, &report, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s]);
+            }
+        }
+    }
+    for(int r = 0; r < bench_record_count() && cfg.use_suite[SUITE_COLUMNS]; r++){
+        if(!cfg.use_record[r]) continue;
+        for(int s = 0; s < cfg.size_count; s++) _run_columns(&cfg, &report, bench_record_at(r), cfg.sizes[s]);
+    }
+    for(int r = 0; r < bench_record_count() && cfg.use_suite[SUITE_SNAPSHOT]; r++){
+        if(!cfg.use_record[r]) continue;
+        for(int k = 0; k < DIST_COUNT; k++){
+            if(!cfg.use_dist[k]) continue;
+            for(int s = 0; s < cfg.size_count; s++){
+                _run_snapshot(&cfg, &report, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s]);
+            }
+        }
+    }
+    for(int d = 0; d < bench_concurrent_count() && cfg.use_suite[SUITE_THREADS]; d++){
+        const BenchDriver* drv = bench_concurrent_at(d);
+        for(int r = 0; r < bench_record_count(); r++){
+            if(!cfg.use_record[r]) continue;
+            for(int k = 0; k < DIST_COUNT; k++){
+                if(!cfg.use_dist[k]) continue;
+                for(int s = 0; s < cfg.size_count; s++){
+                    if(drv->linear && cfg.sizes[s] > cfg.list_limit) continue;
+                    _run_threads_suite(&cfg, &report, drv, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s]);
+                }
+            }
+        }
+    }
+    for(int r = 0; r < bench_record_count() && cfg.use_suite[SUITE_STRESS]; r++){
+        if(!cfg.use_record[r]) continue;
+        for(int k = 0; k < DIST_COUNT; k++){
+            if(!cfg.use_dist[k]) continue;
+            for(int s = 0; s < cfg.size_count; s++){
+                if(cfg.sizes[s] > cfg.list_limit) continue;
+                _run_stress(&cfg, &report, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s], 1);
+                _run_stress(&cfg, &report, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s], 0);
+            }
+        }
+    }
+    for(int r = 0; r < bench_record_count() && cfg.use_suite[SUITE_STATS]; r++){
+        if(!cfg.use_record[r]) continue;
+#ifndef TRADEOFFS_STATS
+        fprintf(stderr, "Note: the stats suite needs a build with -DTRADEOFFS_STATS, skipped\n");
+        break;
+#endif
+        for(int k = 0; k < DIST_COUNT; k++){
+            if(!cfg.use_dist[k]) continue;
+            for(int s = 0; s < cfg.size_count; s++){
+                _run_stats(&cfg, &report, bench_record_at(r), (KeyDistribution)k, cfg.sizes[s]);
+            }
+        }
+    }
+    report_end(&report);
+    if(out != stdout) fclose(out);
+    bench_records_release();
+
+    if(validation_errors > 0){
+        fprintf(stderr, "%d validation errors\n", validation_errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef BPLUSTREE_H_INCLUDED
+#define BPLUSTREE_H_INCLUDED
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. HOW the tree will compare two generic elements*/
+typedef int (*CompareFunc)(void* a, void* b);
+typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Called once per element of a range scan. Return 1 to continue, 0 to stop*/
+typedef int (*VisitFunc)(void* data, void* context);
+
+/*Node sizing: a node's key array (plus its header) spans BPT_NODE_LINES cache lines*/
+#define BPT_CACHE_LINE 64
+#ifndef BPT_NODE_LINES
+#define BPT_NODE_LINES 4
+#endif
+#define BPT_MAX_KEYS ((int)((BPT_NODE_LINES * BPT_CACHE_LINE) / sizeof(void*)) - 1)
+#define BPT_MIN_KEYS (BPT_MAX_KEYS / 2)
+
+/*Common header of every node. Leaves store the elements themselves in 'keys'*/
+typedef struct BPTNode{
+    int is_leaf;
+    int count;
+    void* keys[BPT_MAX_KEYS];
+}BPTNode;
+
+typedef struct BPTLeaf{
+    BPTNode base;
+    struct BPTLeaf* next;   /*Leaves are chained in key order for range scans*/
+    struct BPTLeaf* prev;
+}BPTLeaf;
+
+/*keys[i] is the smallest element of children[i + 1]*/
+typedef struct{
+    BPTNode base;
+    BPTNode* children[BPT_MAX_KEYS + 1];
+}BPTInternal;
+
+typedef struct{
+    BPTNode* root;
+    BPTLeaf* first;         /*Leftmost leaf*/
+    BPTLeaf* last;          /*Rightmost leaf*/
+    int counter;
+    int height;             /*1 = the root is a leaf*/
+    CompareFunc compare;
+}BPlusTree;
+
+/*FUNCTION PROTOTYPES*/
+
+BPlusTree* bpt_create(CompareFunc compare_func);
+void bpt_free(BPlusTree* tree);
+void* bpt_find(BPlusTree* tree, void* data_to_find);
+int bpt_insert(BPlusTree* tree, void* data);
+void* bpt_remove(BPlusTree* tree, void* data_to_remove);
+int bpt_bulk_load(BPlusTree* tree, void** sorted, int count);
+int bpt_range(BPlusTree* tree, void* low, void* high, VisitFunc visit, void* context);
+int bpt_range_reverse(BPlusTree* tree, void* low, void* high, VisitFunc visit, void* context);
+void bpt_print(BPlusTree* tree, PrintFunc print_func);
+
+#endif // BPLUSTREE_H_INCLUDED
@@ -0,0 +1,43 @@
+#ifndef BULKBUILD_H_INCLUDED
+#define BULKBUILD_H_INCLUDED
+#include "orderedArray.h"
+#include "linkedList.h"
+
+/*STRUCTURES DEFINITION*/
+
+/*What to do with rows whose key is already present earlier in the input*/
+typedef enum{
+    BULK_KEEP_FIRST,    /*Keep the earliest row, drop the later ones*/
+    BULK_KEEP_LAST,     /*Keep the latest row (later rows win, like an update)*/
+    BULK_REPORT         /*Keep the earliest row and report every dropped one on stderr*/
+}BulkDedupe;
+
+typedef struct{
+    int threads;            /*Sorting threads (<= 0: online CPUs, at most BULK_MAX_THREADS)*/
+    BulkDedupe dedupe;
+    KeyFunc key_func;       /*BULK_REPORT: names each dropped row by its key on stderr (NULL: only the count)*/
+}BulkOptions;
+
+/*Outcome of one bulk build*/
+typedef struct{
+    long input;         /*Rows received*/
+    long unique;        /*Rows kept*/
+    long duplicates;    /*Rows dropped by the dedupe policy*/
+    int threads;        /*Threads that actually sorted*/
+}BulkReport;
+
+#define BULK_MAX_THREADS 64
+/*Below this many rows per thread, extra threads cost more than they save*/
+#define BULK_MIN_CHUNK 8192
+/*BULK_REPORT prints at most this many duplicates, then a summary*/
+#define BULK_MAX_REPORTED 20
+
+/*FUNCTION PROTOTYPES*/
+
+int bulk_sort(void** items, int count, CompareFunc compare_func, const BulkOptions* options, BulkReport* report);
+OrderedArray* bulk_build_oa(void** items, int count, CompareFunc compare_func,
+                            const BulkOptions* options, BulkReport* report);
+LinkedList* bulk_build_list(void** items, int count, CompareFunc compare_func,
+                            const BulkOptions* options, BulkReport* report);
+
+#endif // BULKBUILD_H_INCLUDED
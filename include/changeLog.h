@@ -0,0 +1,86 @@
+#ifndef CHANGELOG_H_INCLUDED
+#define CHANGELOG_H_INCLUDED
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "orderedArray.h"
+#include "linkedList.h"
+#include "snapshot.h"
+#include "student.h"
+#include "product.h"
+
+/*STRUCTURES DEFINITION*/
+
+#define WAL_MAGIC "CDSTWAL1"
+#define WAL_VERSION 2
+/*Entries buffered before wal_log_* commits on its own (group commit)*/
+#define WAL_DEFAULT_GROUP 64
+
+typedef enum{
+    WAL_INSERT = 1,     /*Insert or replace the record with this id*/
+    WAL_REMOVE = 2      /*Remove the record with this id*/
+}WalOp;
+
+/*What wal_compact_* writes the containers to*/
+typedef enum{
+    WAL_COMPACT_SNAPSHOT,   /*Binary snapshot (snap_open reads it back)*/
+    WAL_COMPACT_CSV         /*Sorted CSV (csv_load_students/csv_load_products read it back)*/
+}WalFormat;
+
+/*File header (32 bytes). Followed by entries in log order*/
+typedef struct{
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;    /*SNAP_ENDIAN_TAG*/
+    uint32_t record_type;   /*SnapshotType*/
+    uint32_t record_size;   /*sizeof(SnapStudent) or sizeof(SnapProduct), names excluded*/
+    uint8_t reserved[8];
+}WalHeader;
+
+/*
+ * Entry header (16 bytes). WAL_INSERT entries are followed by one record
+ * (name_offset 0) and its name_length bytes of name, without terminator
+ */
+typedef struct{
+    uint32_t crc;           /*CRC-32 of the rest of the header, the record and the name*/
+    uint32_t op;            /*WalOp*/
+    int64_t id;
+}WalEntry;
+
+/*An open log, appended to in groups*/
+typedef struct{
+    FILE* file;
+    SnapshotType type;
+    size_t record_size;
+    unsigned char* buffer;  /*Entries logged but not committed yet*/
+    size_t used;
+    size_t capacity;
+    int pending;            /*Entries in 'buffer'*/
+    int group_size;         /*Commit every 'group_size' entries (0 = only on wal_commit)*/
+    unsigned long long entries;     /*Entries in the file since it was created or compacted*/
+    unsigned long long commits;     /*Group commits (one fsync each)*/
+}ChangeLog;
+
+typedef struct{
+    long applied;       /*Valid entries replayed*/
+    long inserts;
+    long removes;
+    long replaced;      /*Inserts that replaced a record with the same id*/
+    long missing;       /*Removes of ids that were not present*/
+    long torn_bytes;    /*Bytes after the last valid entry (an interrupted write), ignored*/
+}WalReplayReport;
+
+/*FUNCTION PROTOTYPES*/
+
+ChangeLog* wal_open(const char* filename, SnapshotType type, int group_size);
+int wal_log_student(ChangeLog* log, const Student* student);
+int wal_log_product(ChangeLog* log, const Product* product);
+int wal_log_remove(ChangeLog* log, long id);
+int wal_commit(ChangeLog* log);
+int wal_close(ChangeLog* log);
+int wal_replay_students(const char* filename, OrderedArray* arr, WalReplayReport* report);
+int wal_replay_products(const char* filename, LinkedList* list, WalReplayReport* report);
+int wal_compact_students(ChangeLog* log, OrderedArray* arr, const char* base_path, WalFormat format);
+int wal_compact_products(ChangeLog* log, LinkedList* list, const char* base_path, WalFormat format);
+
+#endif // CHANGELOG_H_INCLUDED
@@ -0,0 +1,77 @@
+#ifndef CONCURRENTCONTAINERS_H_INCLUDED
+#define CONCURRENTCONTAINERS_H_INCLUDED
+#include <pthread.h>     /*Translation units that include this need POSIX (e.g. _POSIX_C_SOURCE 200809L) for pthread_rwlock_t*/
+#include "orderedArray.h"
+#include "linkedList.h"
+
+/*STRUCTURES DEFINITION*/
+
+#define CONC_CACHE_LINE 64
+#define CONC_DEFAULT_SHARDS 16
+
+/*OrderedArray shared by many threads: finds run in parallel, writes are exclusive*/
+typedef struct{
+    OrderedArray* arr;
+    pthread_rwlock_t lock;
+}ConcurrentOA;
+
+/*One key range of a sharded container, with its own lock*/
+typedef struct{
+    pthread_rwlock_t lock;
+    void* container;            /*OrderedArray* or LinkedList**/
+    char pad[CONC_CACHE_LINE];  /*Keeps neighbouring shard locks off the same cache line*/
+}ContainerShard;
+
+/*
+ * Keyed containers split into 'shard_count' contiguous id ranges of
+ * 'width' ids starting at 'min_key'. Ids below/above the range go to the
+ * first/last shard, so any id is accepted.
+ */
+typedef struct{
+    ContainerShard* shards;
+    int shard_count;
+    long min_key;
+    unsigned long width;
+    KeyFunc key_of;
+}ShardedOA;
+
+typedef struct{
+    ContainerShard* shards;
+    int shard_count;
+    long min_key;
+    unsigned long width;
+    KeyFunc key_of;
+}ShardedList;
+
+/*FUNCTION PROTOTYPES*/
+
+ConcurrentOA* coa_create(int capacity, CompareFunc compare_func);
+ConcurrentOA* coa_create_keyed(int capacity, KeyFunc key_func);
+void coa_free(ConcurrentOA* coa);
+void* coa_find(ConcurrentOA* coa, void* data_to_find);
+void* coa_find_key(ConcurrentOA* coa, long key);
+int coa_find_batch(ConcurrentOA* coa, void** keys, int count, void** results);
+int coa_insert(ConcurrentOA* coa, void* data);
+int coa_insert_batch(ConcurrentOA* coa, void** items, int count);
+void* coa_remove(ConcurrentOA* coa, void* data_to_remove);
+int coa_count(ConcurrentOA* coa);
+
+ShardedOA* shoa_create(KeyFunc key_func, long min_key, long max_key, int shard_count);
+void shoa_free(ShardedOA* shoa);
+int shoa_shard_of(ShardedOA* shoa, long key);
+void* shoa_find(ShardedOA* shoa, void* data_to_find);
+void* shoa_find_key(ShardedOA* shoa, long key);
+int shoa_insert(ShardedOA* shoa, void* data);
+void* shoa_remove(ShardedOA* shoa, void* data_to_remove);
+int shoa_count(ShardedOA* shoa);
+
+ShardedList* shlist_create(KeyFunc key_func, long min_key, long max_key, int shard_count);
+void shlist_free(ShardedList* shlist);
+int shlist_shard_of(ShardedList* shlist, long key);
+void* shlist_find(ShardedList* shlist, void* data_to_find);
+void* shlist_find_key(ShardedList* shlist, long key);
+int shlist_insert(ShardedList* shlist, void* data);
+void* shlist_remove(ShardedList* shlist, void* data_to_remove);
+int shlist_count(ShardedList* shlist);
+
+#endif // CONCURRENTCONTAINERS_H_INCLUDED
@@ -0,0 +1,80 @@
+#ifndef CONTAINERSTATS_H_INCLUDED
+#define CONTAINERSTATS_H_INCLUDED
+#include <stdio.h>
+#include <stdatomic.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Operations with their own latency histogram*/
+typedef enum{
+    CS_OP_FIND,
+    CS_OP_INSERT,
+    CS_OP_REMOVE,
+    CS_OP_BATCH,        /*insert_batch, remove_batch and find_batch calls*/
+    CS_OP_COUNT
+}ContainerOp;
+
+/*
+ * Log-linear (HDR-style) buckets: values below CS_HIST_SUB are exact,
+ * then every power of two is split into CS_HIST_SUB equal buckets, so a
+ * bucket is never wider than 1/CS_HIST_SUB of its value (12.5%).
+ * Latencies above 2^CS_HIST_MAX_MAGNITUDE ns land in the last bucket.
+ */
+#define CS_HIST_SUB_BITS 3
+#define CS_HIST_SUB (1 << CS_HIST_SUB_BITS)
+#define CS_HIST_MAX_MAGNITUDE 40
+#define CS_HIST_BUCKETS (CS_HIST_SUB + (CS_HIST_MAX_MAGNITUDE - CS_HIST_SUB_BITS + 1) * CS_HIST_SUB)
+
+typedef struct{
+    atomic_ullong count;
+    atomic_ullong total_ns;
+    atomic_ullong max_ns;
+    atomic_ullong buckets[CS_HIST_BUCKETS];
+}LatencyHistogram;
+
+/*
+ * Cost counters of one container. Every field but bytes_in_use is reset
+ * by cs_reset. Fields are atomics updated with relaxed ordering: readers
+ * sharing a container (coa_find and the other read-locked paths of
+ * concurrentContainers.h) count into the same stats without a data race.
+ * Each field is exact, but a copy taken while other threads are working
+ * is not a consistent snapshot across fields.
+ */
+typedef struct{
+    atomic_ullong comparisons;          /*CompareFunc calls and inline key comparisons*/
+    atomic_ullong shifts;               /*Element slots moved to open or close gaps*/
+    atomic_ullong hops;                 /*'next' pointers followed*/
+    atomic_ullong allocations;          /*malloc/realloc calls*/
+    atomic_ullong frees;
+    atomic_llong bytes_in_use;          /*Memory owned by the container (not the elements)*/
+    LatencyHistogram latency[CS_OP_COUNT];
+}ContainerStats;
+
+/*
+ * Instrumentation hooks used inside the containers. They compile to
+ * nothing unless the whole project is built with -DTRADEOFFS_STATS.
+ */
+#ifdef TRADEOFFS_STATS
+#define CS_ADD(stats, field, amount) \
+    atomic_fetch_add_explicit(&(stats)->field, (amount), memory_order_relaxed)
+#define CS_TIMER_START(name) unsigned long long name = cs_now_ns()
+#define CS_TIMER_STOP(stats, op, name) cs_record_latency((stats), (op), cs_now_ns() - (name))
+#else
+#define CS_ADD(stats, field, amount) ((void)0)
+#define CS_TIMER_START(name)
+#define CS_TIMER_STOP(stats, op, name) ((void)0)
+#endif
+
+/*FUNCTION PROTOTYPES*/
+
+ContainerStats* cs_create(void);
+void cs_free(ContainerStats* stats);
+void cs_reset(ContainerStats* stats);
+void cs_snapshot(const ContainerStats* stats, ContainerStats* out);
+unsigned long long cs_now_ns(void);
+void cs_record_latency(ContainerStats* stats, ContainerOp op, unsigned long long ns);
+unsigned long long cs_percentile(const LatencyHistogram* histogram, double percentile);
+const char* cs_op_name(ContainerOp op);
+int cs_dump_json(const ContainerStats* stats, const char* name, FILE* out);
+
+#endif // CONTAINERSTATS_H_INCLUDED
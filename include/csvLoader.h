@@ -0,0 +1,23 @@
+#ifndef CSVLOADER_H_INCLUDED
+#define CSVLOADER_H_INCLUDED
+#include "recordArena.h"
+
+/*STRUCTURES DEFINITION*/
+
+/*Outcome of loading one file*/
+typedef struct{
+    long lines;         /*Lines read, including blank lines and the header*/
+    long loaded;        /*Rows turned into records*/
+    long malformed;     /*Rows skipped (each one is reported with its line number)*/
+    long long bytes;    /*File size*/
+    int mapped;         /*1 if the file was memory-mapped, 0 if it was read into a buffer*/
+}CsvReport;
+
+/*FUNCTION PROTOTYPES*/
+
+void** csv_load_students(const char* filename, int* count, CsvReport* report);
+void** csv_load_products(const char* filename, int* count, CsvReport* report);
+void** csv_load_students_in(RecordArena* arena, const char* filename, int* count, CsvReport* report);
+void** csv_load_products_in(RecordArena* arena, const char* filename, int* count, CsvReport* report);
+
+#endif // CSVLOADER_H_INCLUDED
@@ -0,0 +1,40 @@
+#ifndef FROZENARRAY_H_INCLUDED
+#define FROZENARRAY_H_INCLUDED
+#include <stddef.h>
+#include "orderedArray.h"
+
+/*STRUCTURES DEFINITION*/
+
+/*Deepest tree a FrozenArray can hold (2^31 - 1 slots, more than an int counter)*/
+#define FZ_MAX_HEIGHT 31
+
+/*
+ * Immutable snapshot of an OrderedArray, laid out as a complete binary
+ * search tree in van Emde Boas order: the top half of the tree first,
+ * then each bottom subtree, every part laid out the same way. It does not
+ * follow later changes to the array: call fz_refresh after modifications.
+ */
+typedef struct FrozenArray{
+    void** data;            /*Elements in vEB order, NULL = padding (greater than everything)*/
+    long* keys;             /*Same order, keyed snapshots only (LONG_MAX padding). NULL otherwise*/
+    int* ranks;             /*ranks[slot] = position in the sorted array of the element stored there*/
+    size_t slots;           /*2^height - 1 >= count*/
+    int count;
+    int height;
+    CompareFunc compare;
+    KeyFunc key_of;         /*Keyed snapshots only*/
+    /*Navigation, per depth d (root = 1) of a node heading a bottom subtree:*/
+    size_t top[FZ_MAX_HEIGHT + 1];      /*Nodes in the top tree it hangs from (also a mask)*/
+    size_t bottom[FZ_MAX_HEIGHT + 1];   /*Nodes in its own subtree*/
+    int root_depth[FZ_MAX_HEIGHT + 1];  /*Depth of the root of the tree the split was made in*/
+}FrozenArray;
+
+/*FUNCTION PROTOTYPES*/
+
+FrozenArray* fz_freeze(OrderedArray* arr, KeyFunc key_func);
+int fz_refresh(FrozenArray* frozen, OrderedArray* arr);
+void fz_free(FrozenArray* frozen);
+void* fz_find(FrozenArray* frozen, void* data_to_find);
+void* fz_find_key(FrozenArray* frozen, long key);
+
+#endif // FROZENARRAY_H_INCLUDED
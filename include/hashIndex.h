@@ -0,0 +1,43 @@
+#ifndef HASHINDEX_H_INCLUDED
+#define HASHINDEX_H_INCLUDED
+#include <stdint.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. Extracts the integer key of an element*/
+typedef long (*KeyFunc)(void* data);
+
+/*Smallest table size (power of two)*/
+#define HI_MIN_CAPACITY 16
+/*Longest probe distance a metadata byte can record*/
+#define HI_MAX_PROBE 250
+
+/*
+ * Open-addressing (Robin Hood) hash table from an element's long key to
+ * the element. meta[i] is 0 for an empty slot, otherwise the distance of
+ * slot i from its key's home slot plus one. The metadata bytes are kept
+ * apart from keys/values so a probe scans 64 slots per cache line and
+ * only reads a key when its distance matches.
+ */
+typedef struct HashIndex{
+    uint8_t* meta;
+    long* keys;
+    void** values;
+    int capacity;       /*Power of two*/
+    int shift;          /*64 - log2(capacity): keeps the top bits of the hash*/
+    int counter;
+    KeyFunc key_of;
+}HashIndex;
+
+/*FUNCTION PROTOTYPES*/
+
+HashIndex* hi_create(int expected_size, KeyFunc key_func);
+void hi_free(HashIndex* hi);
+int hi_reserve(HashIndex* hi, int expected_size);
+int hi_insert(HashIndex* hi, void* data);
+void* hi_find(HashIndex* hi, long key);
+void* hi_remove(HashIndex* hi, long key);
+void hi_clear(HashIndex* hi);
+int hi_count(HashIndex* hi);
+
+#endif // HASHINDEX_H_INCLUDED
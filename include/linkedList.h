@@ -2,31 +2,86 @@
 #define LINKEDLIST_H_INCLUDED
 #include <stdio.h>
 #include <stdlib.h>
+#include "containerStats.h"
 
 
 /*Pointer to function. HOW the list will compare two generic elements*/
 typedef int (*CompareFunc)(void* a, void* b);
 typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Extracts the integer key of an element (keyed mode)*/
+typedef long (*KeyFunc)(void* data);
+/*Pointer to function. Called once per element of a range scan. Return 1 to continue, 0 to stop*/
+typedef int (*VisitFunc)(void* data, void* context);
 
 typedef struct Node{
     void* data;
     struct Node* next;
+    long key;           /*Keyed mode only: key of 'data'*/
 }Node;
 
+/*A block of nodes carved out with a single malloc*/
+typedef struct NodeSlab{
+    struct NodeSlab* next;
+    int used;       /*Nodes handed out from this slab so far*/
+    Node nodes[];
+}NodeSlab;
+
+/*Node allocator owned by a pooled list*/
+typedef struct{
+    NodeSlab* slabs;    /*Most recent slab first*/
+    Node* free_list;    /*Recycled nodes, chained through 'next'*/
+    int slab_size;      /*Nodes per slab*/
+}NodePool;
+
 typedef struct{
     Node* head;
     int counter;
     CompareFunc compare;
+    NodePool* pool;     /*NULL = one malloc/free per node (default)*/
+    KeyFunc key_of;     /*Keyed mode: NULL = compare elements with 'compare'*/
+    struct HashIndex* index;    /*Optional id -> element side index (list_attach_hash_index). NULL otherwise*/
+    struct LookupCache* cache;  /*Optional cache of recently found elements (list_attach_lookup_cache). NULL otherwise*/
+    struct SecondaryIndexes* secondary; /*Optional orderings by other fields (list_add_index). NULL otherwise*/
+#ifdef TRADEOFFS_STATS
+    ContainerStats* stats;      /*Cost counters and latencies (stats builds only)*/
+#endif
 }LinkedList;
 
+/*Position in a LinkedList. Invalidated if its node is removed*/
+typedef struct{
+    Node* node;
+}ListCursor;
+
+#define LIST_DEFAULT_SLAB_SIZE 256
+
 /*PUBLIC INTERFACE (FUNCTION PROTOTYPES LinkedList.c will provide)*/
 
 LinkedList* list_create(CompareFunc compare_func);
+LinkedList* list_create_pooled(CompareFunc compare_func, int slab_size);
+LinkedList* list_create_keyed(KeyFunc key_func, int slab_size);
 void list_free(LinkedList* list);
 int list_insert_sorted(LinkedList* list, void* data);
+int list_insert_batch(LinkedList* list, void** items, int count);
+int list_append_sorted(LinkedList* list, void** items, int count);
 void* list_remove(LinkedList* list, void* data_to_remove);
 void* list_find_linear(LinkedList* list, void* data_to_find);
+void* list_find_key(LinkedList* list, long key);
+int list_find_batch(LinkedList* list, void** keys, int count, void** results);
 void list_print(LinkedList* list, PrintFunc print_func);
+int list_begin(LinkedList* list, ListCursor* cursor);
+int list_lower_bound(LinkedList* list, void* key, ListCursor* cursor);
+void* list_cursor_get(ListCursor* cursor);
+int list_cursor_next(ListCursor* cursor);
+int list_range(LinkedList* list, void* low, void* high, VisitFunc visit, void* context);
+int list_attach_hash_index(LinkedList* list, KeyFunc key_func);
+void list_detach_hash_index(LinkedList* list);
+int list_attach_lookup_cache(LinkedList* list, int slots, KeyFunc key_func);
+void list_detach_lookup_cache(LinkedList* list);
+int list_add_index(LinkedList* list, CompareFunc compare_func);
+int list_drop_index(LinkedList* list, int slot);
+int list_index_range(LinkedList* list, int slot, void* low, void* high, VisitFunc visit, void* context);
+int list_index_top(LinkedList* list, int slot, int k, void** results);
+ContainerStats* list_stats(LinkedList* list);
 
 
 #endif // LINKEDLIST_H_INCLUDED
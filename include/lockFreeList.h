@@ -0,0 +1,68 @@
+#ifndef LOCKFREELIST_H_INCLUDED
+#define LOCKFREELIST_H_INCLUDED
+#include <stdatomic.h>
+#include <stdint.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. HOW the list will compare two generic elements*/
+typedef int (*CompareFunc)(void* a, void* b);
+typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Extracts the integer key of an element (keyed mode)*/
+typedef long (*KeyFunc)(void* data);
+/*Pointer to function. Frees an element (e.g. student_free)*/
+typedef void (*FreeFunc)(void* data);
+
+/*Most threads that may use lock-free lists at the same time*/
+#define LFL_MAX_THREADS 64
+/*Retired nodes a thread accumulates before it tries to advance the epoch*/
+#define LFL_RETIRE_THRESHOLD 64
+
+typedef struct LFNode{
+    _Atomic(uintptr_t) next;        /*Next node. Low bit set = this node is logically deleted*/
+    void* data;
+    long key;                       /*Keyed mode only: key of 'data'*/
+    struct LFNode* retired_next;    /*Chains the node in its thread's limbo list once unlinked*/
+    FreeFunc release;               /*Set when retired: frees 'data' together with the node*/
+}LFNode;
+
+typedef struct{
+    _Atomic(uintptr_t) head;
+    atomic_int counter;
+    CompareFunc compare;
+    KeyFunc key_of;     /*Keyed mode: NULL = compare elements with 'compare'*/
+    FreeFunc release;   /*Frees removed elements once no thread can read them (lfl_set_release). NULL = caller frees*/
+}LockFreeList;
+
+/*FUNCTION PROTOTYPES*/
+
+/*
+ * Every operation runs in the calling thread's reclamation slot, claimed
+ * on first use. At most LFL_MAX_THREADS threads hold one at a time (call
+ * lfl_thread_exit before a thread ends): beyond that the error is printed
+ * on stderr and lfl_insert_sorted returns 0, lfl_remove, lfl_find and
+ * lfl_find_key NULL, lfl_pin 0.
+ *
+ * Elements found or removed may be read by other threads until a grace
+ * period has passed: let the list free removed ones (lfl_set_release)
+ * and use found ones inside lfl_pin/lfl_unpin, or free them only once no
+ * thread uses the list.
+ */
+
+LockFreeList* lfl_create(CompareFunc compare_func);
+LockFreeList* lfl_create_keyed(KeyFunc key_func);
+void lfl_free(LockFreeList* list);
+int lfl_insert_sorted(LockFreeList* list, void* data);
+void* lfl_remove(LockFreeList* list, void* data_to_remove);
+void* lfl_find(LockFreeList* list, void* data_to_find);
+void* lfl_find_key(LockFreeList* list, long key);
+int lfl_count(LockFreeList* list);
+void lfl_print(LockFreeList* list, PrintFunc print_func);
+int lfl_validate(LockFreeList* list);
+void lfl_set_release(LockFreeList* list, FreeFunc release_func);
+int lfl_pin(void);
+void lfl_unpin(void);
+void lfl_thread_exit(void);
+void lfl_collect(void);
+
+#endif // LOCKFREELIST_H_INCLUDED
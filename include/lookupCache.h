@@ -0,0 +1,50 @@
+#ifndef LOOKUPCACHE_H_INCLUDED
+#define LOOKUPCACHE_H_INCLUDED
+#include <stdint.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. Extracts the integer key of an element*/
+typedef long (*KeyFunc)(void* data);
+
+/*Slots per set: 8 keys = one 64-byte cache line*/
+#define LC_WAYS 8
+/*Default size of a cache attached without an explicit one*/
+#define LC_DEFAULT_SLOTS 1024
+
+/*Occupancy and CLOCK state of one set (bit i = way i)*/
+typedef struct{
+    uint8_t valid;
+    uint8_t referenced;     /*Set on every hit, cleared as the hand passes*/
+    uint8_t hand;           /*Next way the CLOCK hand looks at*/
+}LCSet;
+
+/*
+ * Small fixed-size cache of recently found elements, keyed by id. A key
+ * can only live in one set of LC_WAYS slots, so a lookup reads one cache
+ * line of keys. A full set evicts with CLOCK: the hand skips (and clears)
+ * recently hit slots and takes the first one that was not hit since.
+ */
+typedef struct LookupCache{
+    long* keys;         /*sets * LC_WAYS, set s at keys[s * LC_WAYS]*/
+    void** values;
+    LCSet* state;
+    int sets;           /*Power of two*/
+    KeyFunc key_of;
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+}LookupCache;
+
+/*FUNCTION PROTOTYPES*/
+
+LookupCache* lc_create(int slots, KeyFunc key_func);
+void lc_free(LookupCache* cache);
+void* lc_find(LookupCache* cache, long key);
+int lc_store(LookupCache* cache, void* data);
+int lc_invalidate(LookupCache* cache, long key);
+void lc_clear(LookupCache* cache);
+void lc_reset_counters(LookupCache* cache);
+double lc_hit_rate(LookupCache* cache);
+
+#endif // LOOKUPCACHE_H_INCLUDED
@@ -0,0 +1,47 @@
+#ifndef OALOOKUP_H_INCLUDED
+#define OALOOKUP_H_INCLUDED
+#include "orderedArray.h"
+
+/*STRUCTURES DEFINITION*/
+
+typedef enum{
+    OAL_AUTO,           /*Pick the best kernel for the size and the CPU*/
+    OAL_BRANCHLESS,     /*Branch-free binary search over the sorted keys*/
+    OAL_EYTZINGER,      /*BFS-ordered keys with software prefetching*/
+    OAL_SIMD            /*Branch-free narrowing + vectorized scan of the last block*/
+}LookupKind;
+
+/*SIMD support detected at runtime*/
+typedef enum{
+    OAL_SIMD_SCALAR,
+    OAL_SIMD_SSE42,
+    OAL_SIMD_AVX2
+}SimdLevel;
+
+/*
+ * Read-only snapshot of an OrderedArray's keys and elements. It does not
+ * follow later changes to the array: rebuild it after modifications.
+ */
+typedef struct OALookup{
+    long long* keys;        /*Sorted keys, padded with OAL_BLOCK sentinels*/
+    void** values;          /*values[i] is the element with keys[i]*/
+    long long* eytz_keys;   /*OAL_EYTZINGER only: 1-based BFS layout*/
+    void** eytz_values;
+    int count;
+    LookupKind kind;        /*The kernel in use (never OAL_AUTO)*/
+    SimdLevel simd;
+    void* (*find)(struct OALookup* lookup, long key);
+}OALookup;
+
+#define OAL_BLOCK 16
+#define OAL_EYTZINGER_THRESHOLD 65536
+
+/*FUNCTION PROTOTYPES*/
+
+OALookup* oal_build(OrderedArray* arr, KeyFunc key_func, LookupKind kind);
+void oal_free(OALookup* lookup);
+void* oal_find(OALookup* lookup, long key);
+SimdLevel oal_cpu_simd_level(void);
+const char* oal_kind_name(LookupKind kind);
+
+#endif // OALOOKUP_H_INCLUDED
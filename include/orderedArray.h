@@ -1,27 +1,74 @@
 #ifndef ORDEREDARRAY_H_INCLUDED
 #define ORDEREDARRAY_H_INCLUDED
+#include "containerStats.h"
 
 /*STRUCTURES DEFINITION*/
 
 /*Pointer to function. HOW the array will compare two generic elements*/
 typedef int (*CompareFunc)(void* a, void* b);
 typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Extracts the integer key of an element (keyed mode)*/
+typedef long (*KeyFunc)(void* data);
+/*Pointer to function. Called once per element of a range scan. Return 1 to continue, 0 to stop*/
+typedef int (*VisitFunc)(void* data, void* context);
 
 typedef struct{
     void** data;
     int counter;
     int capacity;
     CompareFunc compare;
+    int growable;           /*0 = fixed capacity (default), 1 = geometric growth*/
+    int min_capacity;       /*Shrinking never goes below the initial capacity*/
+    float shrink_threshold; /*Shrink when counter < capacity * threshold (0 = never)*/
+    long* keys;             /*Keyed mode: keys[i] is the key of data[i]. NULL otherwise*/
+    KeyFunc key_of;
+    struct HashIndex* index;    /*Optional id -> element side index (oa_attach_hash_index). NULL otherwise*/
+    struct LookupCache* cache;  /*Optional cache of recently found elements (oa_attach_lookup_cache). NULL otherwise*/
+    struct SecondaryIndexes* secondary; /*Optional orderings by other fields (oa_add_index). NULL otherwise*/
+#ifdef TRADEOFFS_STATS
+    ContainerStats* stats;      /*Cost counters and latencies (stats builds only)*/
+#endif
 }OrderedArray;
 
+/*Position in an OrderedArray. Invalidated by any insert or remove*/
+typedef struct{
+    OrderedArray* arr;
+    int index;
+}OACursor;
+
 /*FUNCTION PROTOTYPES*/
 
 OrderedArray* oa_create(int capacity, CompareFunc compare_func);
+OrderedArray* oa_create_keyed(int capacity, KeyFunc key_func);
 void oa_free(OrderedArray* arr);
 void* oa_find_binary(OrderedArray* arr, void* data_to_find);
+void* oa_find_key(OrderedArray* arr, long key);
+int oa_find_batch(OrderedArray* arr, void** keys, int count, void** results);
 int oa_insert_sorted(OrderedArray* arr, void* data);
 void oa_print(OrderedArray* arr, PrintFunc print_func);
 void* oa_remove(OrderedArray* arr, void* data_to_remove);
+int oa_insert_batch(OrderedArray* arr, void** items, int count);
+int oa_remove_batch(OrderedArray* arr, void** keys, int count, void** removed);
+int oa_append_sorted(OrderedArray* arr, void** items, int count);
+int oa_set_growth(OrderedArray* arr, int growable, float shrink_threshold);
+int oa_reserve(OrderedArray* arr, int min_capacity);
+int oa_shrink_to_fit(OrderedArray* arr);
+int oa_begin(OrderedArray* arr, OACursor* cursor);
+int oa_last(OrderedArray* arr, OACursor* cursor);
+int oa_lower_bound(OrderedArray* arr, void* key, OACursor* cursor);
+void* oa_cursor_get(OACursor* cursor);
+int oa_cursor_next(OACursor* cursor);
+int oa_cursor_prev(OACursor* cursor);
+int oa_range(OrderedArray* arr, void* low, void* high, VisitFunc visit, void* context);
+int oa_attach_hash_index(OrderedArray* arr, KeyFunc key_func);
+void oa_detach_hash_index(OrderedArray* arr);
+int oa_attach_lookup_cache(OrderedArray* arr, int slots, KeyFunc key_func);
+void oa_detach_lookup_cache(OrderedArray* arr);
+int oa_add_index(OrderedArray* arr, CompareFunc compare_func);
+int oa_drop_index(OrderedArray* arr, int slot);
+int oa_index_range(OrderedArray* arr, int slot, void* low, void* high, VisitFunc visit, void* context);
+int oa_index_top(OrderedArray* arr, int slot, int k, void** results);
+ContainerStats* oa_stats(OrderedArray* arr);
 
 
 #endif // ORDEREDARRAY_H_INCLUDED
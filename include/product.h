@@ -1,11 +1,13 @@
 #ifndef PRODUCT_H_INCLUDED
 #define PRODUCT_H_INCLUDED
 
+struct RecordArena;
+
 /*STRUCTURE DEFINITION*/
 
 typedef struct{
     long int id;
-    char name[100];
+    const char* name;   /*Stored right after the struct (product_create) or interned in an arena (product_create_in)*/
     float price;
     float cost;
     long int stock;
@@ -13,9 +15,14 @@ typedef struct{
 
 //FUNCTION PROTOTYPES
 
+long product_get_id(void* data);
 int product_compare_by_id(void* productA, void* productB);
+int product_compare_by_price(void* productA, void* productB);
+int product_compare_by_stock(void* productA, void* productB);
+int product_compare_by_name(void* productA, void* productB);
 void product_print(void* data);
 Product* product_create(long int id, const char* name, float price, float cost, long int stock);
+Product* product_create_in(struct RecordArena* arena, long int id, const char* name, float price, float cost, long int stock);
 void product_free(void* data);
 
 #endif // PRODUCT_H_INCLUDED
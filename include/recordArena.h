@@ -0,0 +1,42 @@
+#ifndef RECORDARENA_H_INCLUDED
+#define RECORDARENA_H_INCLUDED
+#include <stddef.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Bytes per block (a record larger than that gets a block of its own)*/
+#define RA_DEFAULT_BLOCK (64 * 1024)
+/*Intern table slots to start with (a power of two)*/
+#define RA_INITIAL_NAMES 256
+
+/*One malloc'd chunk that records and names are carved out of, front to back*/
+typedef struct ArenaBlock{
+    struct ArenaBlock* next;    /*The block filled before this one*/
+    size_t used;
+    size_t size;
+    max_align_t data[];         /*'size' bytes, aligned for any record*/
+}ArenaBlock;
+
+/*
+ * Owner of a whole database's records (Student/Product) and names. Records
+ * are never freed one by one: ra_free releases everything at once.
+ */
+typedef struct RecordArena{
+    ArenaBlock* blocks;     /*Current block first*/
+    size_t block_size;
+    const char** names;     /*Intern table: open addressing, NULL = empty slot*/
+    size_t name_slots;      /*Power of two*/
+    size_t name_count;      /*Distinct names stored*/
+    size_t bytes_used;      /*Bytes handed out (records and names)*/
+    size_t bytes_reserved;  /*Bytes malloc'd for blocks*/
+    long intern_hits;       /*ra_intern calls answered with a name already stored*/
+}RecordArena;
+
+/*FUNCTION PROTOTYPES*/
+
+RecordArena* ra_create(size_t block_size);
+void ra_free(RecordArena* arena);
+void* ra_alloc(RecordArena* arena, size_t size);
+const char* ra_intern(RecordArena* arena, const char* name);
+
+#endif // RECORDARENA_H_INCLUDED
@@ -0,0 +1,63 @@
+#ifndef RECORDSTORE_H_INCLUDED
+#define RECORDSTORE_H_INCLUDED
+#include <stddef.h>
+
+/*STRUCTURES DEFINITION*/
+
+/*Names of every row, stored back to back (NUL-terminated) in one buffer*/
+typedef struct{
+    char* chars;
+    size_t used;
+    size_t capacity;
+}NamePool;
+
+/*Columnar Student storage: row i is {id[i], names + name_offset[i], gpa[i]}*/
+typedef struct{
+    long* id;
+    float* gpa;
+    size_t* name_offset;
+    NamePool names;
+    int counter;
+    int capacity;       /*Fixed: the columns never move, so handles stay valid*/
+}StudentStore;
+
+/*Columnar Product storage*/
+typedef struct{
+    long* id;
+    float* price;
+    float* cost;
+    long* stock;
+    size_t* name_offset;
+    NamePool names;
+    int counter;
+    int capacity;
+}ProductStore;
+
+/*FUNCTION PROTOTYPES*/
+
+/*Row handles (&id[row]) can be stored in any container*/
+long store_get_id(void* handle);
+int store_compare_by_id(void* handleA, void* handleB);
+
+StudentStore* sstore_create(int capacity);
+void sstore_free(StudentStore* store);
+int sstore_append(StudentStore* store, long id, const char* name, float gpa);
+void* sstore_handle(StudentStore* store, int row);
+int sstore_row(StudentStore* store, void* handle);
+const char* sstore_name(StudentStore* store, int row);
+void sstore_print(StudentStore* store, int row);
+double sstore_average_gpa(StudentStore* store);
+int sstore_filter_gpa_above(StudentStore* store, float threshold, int* rows);
+
+ProductStore* pstore_create(int capacity);
+void pstore_free(ProductStore* store);
+int pstore_append(ProductStore* store, long id, const char* name, float price, float cost, long stock);
+void* pstore_handle(ProductStore* store, int row);
+int pstore_row(ProductStore* store, void* handle);
+const char* pstore_name(ProductStore* store, int row);
+void pstore_print(ProductStore* store, int row);
+long long pstore_sum_stock(ProductStore* store);
+double pstore_inventory_value(ProductStore* store);
+int pstore_filter_stock_below(ProductStore* store, long threshold, int* rows);
+
+#endif // RECORDSTORE_H_INCLUDED
@@ -0,0 +1,32 @@
+#ifndef SECONDARYINDEX_H_INCLUDED
+#define SECONDARYINDEX_H_INCLUDED
+#include "bPlusTree.h"
+
+/*STRUCTURES DEFINITION*/
+
+/*Indexes a container can carry at once*/
+#define SX_MAX_INDEXES 4
+
+/*
+ * Extra orderings over the elements of one container. Each slot is a
+ * BPlusTree of the same element pointers under its own CompareFunc (e.g.
+ * student_compare_by_gpa), so nothing is copied. Comparators must be
+ * total: two different elements never compare equal (break ties by id).
+ */
+typedef struct SecondaryIndexes{
+    BPlusTree* trees[SX_MAX_INDEXES];   /*NULL = free slot*/
+}SecondaryIndexes;
+
+/*FUNCTION PROTOTYPES*/
+
+SecondaryIndexes* sx_create(void);
+void sx_free(SecondaryIndexes* set);
+int sx_add(SecondaryIndexes* set, CompareFunc compare_func, void** items, int count);
+int sx_drop(SecondaryIndexes* set, int slot);
+int sx_count(SecondaryIndexes* set);
+int sx_insert(SecondaryIndexes* set, void** items, int count);
+void sx_remove(SecondaryIndexes* set, void* data);
+int sx_range(SecondaryIndexes* set, int slot, void* low, void* high, VisitFunc visit, void* context);
+int sx_top(SecondaryIndexes* set, int slot, int k, void** results);
+
+#endif // SECONDARYINDEX_H_INCLUDED
@@ -0,0 +1,38 @@
+#ifndef SKIPLIST_H_INCLUDED
+#define SKIPLIST_H_INCLUDED
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. HOW the list will compare two generic elements*/
+typedef int (*CompareFunc)(void* a, void* b);
+typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Called once per element of a range scan. Return 1 to continue, 0 to stop*/
+typedef int (*VisitFunc)(void* data, void* context);
+
+#define SKIPLIST_MAX_LEVEL 32
+
+typedef struct SkipNode{
+    void* data;
+    int level;                      /*Number of forward pointers of this node*/
+    struct SkipNode* forward[];     /*forward[i] = next node on level i*/
+}SkipNode;
+
+typedef struct{
+    SkipNode* head;                 /*Sentinel with SKIPLIST_MAX_LEVEL levels*/
+    int level;                      /*Levels currently in use*/
+    int counter;
+    CompareFunc compare;
+    unsigned long long rng_state;   /*Drives the random node heights*/
+}SkipList;
+
+/*FUNCTION PROTOTYPES*/
+
+SkipList* sl_create(CompareFunc compare_func);
+void sl_free(SkipList* list);
+int sl_insert_sorted(SkipList* list, void* data);
+void* sl_remove(SkipList* list, void* data_to_remove);
+void* sl_find(SkipList* list, void* data_to_find);
+void sl_print(SkipList* list, PrintFunc print_func);
+int sl_range(SkipList* list, void* low, void* high, VisitFunc visit, void* context);
+
+#endif // SKIPLIST_H_INCLUDED
@@ -0,0 +1,82 @@
+#ifndef SNAPSHOT_H_INCLUDED
+#define SNAPSHOT_H_INCLUDED
+#include <stddef.h>
+#include <stdint.h>
+#include "orderedArray.h"
+#include "linkedList.h"
+
+/*STRUCTURES DEFINITION*/
+
+#define SNAP_MAGIC "CDSTSNAP"
+#define SNAP_VERSION 2
+#define SNAP_ENDIAN_TAG 0x01020304u
+
+typedef enum{
+    SNAP_STUDENTS = 1,
+    SNAP_PRODUCTS = 2
+}SnapshotType;
+
+/*File header (64 bytes). Followed by 'count' records sorted by id, then the names*/
+typedef struct{
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;    /*Rejects files written with the other byte order*/
+    uint32_t record_type;   /*SnapshotType*/
+    uint32_t record_size;
+    uint64_t count;
+    uint64_t checksum;      /*FNV-1a of the record and name words (4 interleaved lanes)*/
+    uint64_t names_size;    /*Bytes of the name area (a multiple of 8)*/
+    uint8_t reserved[16];
+}SnapshotHeader;
+
+/*
+ * Fixed-width records. A name of any length lives in the name area after
+ * the records, NUL-terminated, at 'name_offset' from its start (read it
+ * with snap_student_name/snap_product_name). Padding is zeroed so the
+ * checksum is deterministic.
+ */
+typedef struct{
+    int64_t id;
+    float gpa;
+    uint32_t name_length;   /*Terminator excluded*/
+    uint64_t name_offset;
+}SnapStudent;
+
+typedef struct{
+    int64_t id;
+    int64_t stock;
+    float price;
+    float cost;
+    uint64_t name_offset;
+    uint32_t name_length;   /*Terminator excluded*/
+    uint32_t padding;
+}SnapProduct;
+
+/*An open snapshot. The records are read in place from the mapping*/
+typedef struct{
+    const SnapshotHeader* header;
+    const unsigned char* records;
+    const char* names;      /*Name area, right after the records*/
+    size_t names_size;
+    size_t count;
+    size_t record_size;
+    void* base;             /*Start of the mapping (or of the buffer)*/
+    size_t size;
+    int mapped;             /*1 = mmap, 0 = read into a heap buffer*/
+}Snapshot;
+
+/*FUNCTION PROTOTYPES*/
+
+int snap_write_students(const char* filename, OrderedArray* arr);
+int snap_write_products(const char* filename, LinkedList* list);
+Snapshot* snap_open(const char* filename, SnapshotType type, int verify);
+void snap_close(Snapshot* snap);
+int snap_verify(Snapshot* snap);
+const SnapStudent* snap_student_at(Snapshot* snap, size_t index);
+const SnapProduct* snap_product_at(Snapshot* snap, size_t index);
+const SnapStudent* snap_find_student(Snapshot* snap, long id);
+const SnapProduct* snap_find_product(Snapshot* snap, long id);
+const char* snap_student_name(Snapshot* snap, const SnapStudent* record);
+const char* snap_product_name(Snapshot* snap, const SnapProduct* record);
+
+#endif // SNAPSHOT_H_INCLUDED
@@ -1,19 +1,25 @@
 #ifndef STUDENT_H_INCLUDED
 #define STUDENT_H_INCLUDED
 
+struct RecordArena;
+
 /*STRUCTURE DEFINITION*/
 
 typedef struct{
     long int id;
-    char name[100];
+    const char* name;   /*Stored right after the struct (student_create) or interned in an arena (student_create_in)*/
     float gpa; //"Grade Point Average"
 }Student;
 
 //FUNCTION PROTOTYPES
 
+long student_get_id(void* data);
 int student_compare_by_id(void* studentA, void* studentB);
+int student_compare_by_gpa(void* studentA, void* studentB);
+int student_compare_by_name(void* studentA, void* studentB);
 void student_print(void* data);
 Student* student_create(long int id, const char* name, float gpa);
+Student* student_create_in(struct RecordArena* arena, long int id, const char* name, float gpa);
 void student_free(void* data);
 
 #endif // STUDENT_H_INCLUDED
@@ -0,0 +1,42 @@
+#ifndef TIEREDARRAY_H_INCLUDED
+#define TIEREDARRAY_H_INCLUDED
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. HOW the array will compare two generic elements*/
+typedef int (*CompareFunc)(void* a, void* b);
+typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Called once per element of a range scan. Return 1 to continue, 0 to stop*/
+typedef int (*VisitFunc)(void* data, void* context);
+
+/*Smallest block size (power of two)*/
+#define TA_MIN_BLOCK 16
+
+/*
+ * Ordered array split into blocks of 'block_size' slots. Every block but
+ * the last one is full, so element i lives in block i / block_size. Each
+ * block is a ring buffer starting at heads[block], which lets a whole
+ * block take an element at its front and drop one at its back in O(1).
+ */
+typedef struct{
+    void** storage;     /*Block b is storage[b * block_size .. (b + 1) * block_size)*/
+    int* heads;         /*heads[b]: slot of block b's first element*/
+    int block_size;     /*Power of two, about sqrt(counter)*/
+    int block_shift;    /*log2(block_size)*/
+    int block_count;    /*Blocks allocated*/
+    int counter;
+    CompareFunc compare;
+}TieredArray;
+
+/*FUNCTION PROTOTYPES*/
+
+TieredArray* ta_create(int expected_size, CompareFunc compare_func);
+void ta_free(TieredArray* ta);
+void* ta_find(TieredArray* ta, void* data_to_find);
+void* ta_get(TieredArray* ta, int index);
+int ta_insert_sorted(TieredArray* ta, void* data);
+void* ta_remove(TieredArray* ta, void* data_to_remove);
+void ta_print(TieredArray* ta, PrintFunc print_func);
+int ta_range(TieredArray* ta, void* low, void* high, VisitFunc visit, void* context);
+
+#endif // TIEREDARRAY_H_INCLUDED
@@ -0,0 +1,39 @@
+#ifndef UNROLLEDLIST_H_INCLUDED
+#define UNROLLEDLIST_H_INCLUDED
+
+/*STRUCTURES DEFINITION*/
+
+/*Pointer to function. HOW the list will compare two generic elements*/
+typedef int (*CompareFunc)(void* a, void* b);
+typedef void (*PrintFunc)(void* data);
+/*Pointer to function. Called once per element of a range scan. Return 1 to continue, 0 to stop*/
+typedef int (*VisitFunc)(void* data, void* context);
+
+/*Elements per node: next + count + 14 pointers = 128 bytes (two cache lines)*/
+#define UL_NODE_CAPACITY 14
+
+/*A node holds a small sorted array of UL_NODE_CAPACITY / 2 .. UL_NODE_CAPACITY elements (a lone node: 1 ..)*/
+typedef struct ULNode{
+    struct ULNode* next;
+    int count;
+    void* items[UL_NODE_CAPACITY];
+}ULNode;
+
+typedef struct{
+    ULNode* head;
+    int counter;        /*Elements*/
+    int node_count;
+    CompareFunc compare;
+}UnrolledList;
+
+/*FUNCTION PROTOTYPES*/
+
+UnrolledList* ul_create(CompareFunc compare_func);
+void ul_free(UnrolledList* list);
+int ul_insert_sorted(UnrolledList* list, void* data);
+void* ul_remove(UnrolledList* list, void* data_to_remove);
+void* ul_find(UnrolledList* list, void* data_to_find);
+void ul_print(UnrolledList* list, PrintFunc print_func);
+int ul_range(UnrolledList* list, void* low, void* high, VisitFunc visit, void* context);
+
+#endif // UNROLLEDLIST_H_INCLUDED
@@ -0,0 +1,602 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "bPlusTree.h"
+
+/*
+ * bPlusTree.c
+ *
+ * Implements a generic ordered B+-tree. Elements live only in the leaves,
+ * which are chained left-to-right; internal nodes hold separators that
+ * point at elements (the smallest element of the subtree to their right).
+ *
+ * Every node holds up to BPT_MAX_KEYS pointers in an array that spans a
+ * few cache lines, so a lookup touches O(log_B n) nodes instead of the
+ * O(log2 n) scattered probes of a binary search over heap pointers.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH: O(log n) - One binary search per level, few levels.
+ * - INSERT: O(log n) - Shifts at most BPT_MAX_KEYS pointers per level.
+ * - REMOVE: O(log n) - Borrows from / merges with a sibling on underflow.
+ * - RANGE:  O(log n + k) - Descend once, then follow the leaf chain
+ *           (forwards, or backwards through 'prev' for descending scans).
+ * - MEMORY: Dynamic. One malloc per node (~BPT_MAX_KEYS elements), nodes
+ *           are at least half full.
+ */
+
+
+/**
+ * @brief (Private) Index of the first key in 'node' that is >= 'data'.
+ */
+static int _bpt_lower_bound(BPlusTree* tree, BPTNode* node, void* data){
+    int low = 0;
+    int high = node->count;
+    while(low < high){
+        int mid = (low + high) / 2;
+        if(tree->compare(node->keys[mid], data) < 0) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief (Private) Index of the child of an internal node that may hold 'data'.
+ *
+ * That is the number of separators <= data (an element equal to a
+ * separator lives in the subtree to the separator's right).
+ */
+static int _bpt_child_index(BPlusTree* tree, BPTNode* node, void* data){
+    int low = 0;
+    int high = node->count;
+    while(low < high){
+        int mid = (low + high) / 2;
+        if(tree->compare(data, node->keys[mid]) >= 0) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+static BPTLeaf* _bpt_leaf_create(void){
+    BPTLeaf* leaf = (BPTLeaf*)malloc(sizeof(BPTLeaf));
+    if(leaf == NULL) return NULL;
+    leaf->base.is_leaf = 1;
+    leaf->base.count = 0;
+    leaf->next = NULL;
+    leaf->prev = NULL;
+    return leaf;
+}
+
+static BPTInternal* _bpt_internal_create(void){
+    BPTInternal* node = (BPTInternal*)malloc(sizeof(BPTInternal));
+    if(node == NULL) return NULL;
+    node->base.is_leaf = 0;
+    node->base.count = 0;
+    return node;
+}
+
+/**
+ * @brief (Private) Smallest element of a subtree (its leftmost leaf key).
+ */
+static void* _bpt_min(BPTNode* node){
+    while(!node->is_leaf) node = ((BPTInternal*)node)->children[0];
+    return node->keys[0];
+}
+
+/**
+ * @brief (Private) Frees a subtree (nodes only, not the elements).
+ */
+static void _bpt_free_node(BPTNode* node){
+    if(!node->is_leaf){
+        BPTInternal* internal = (BPTInternal*)node;
+        for(int i = 0; i <= node->count; i++) _bpt_free_node(internal->children[i]);
+    }
+    free(node);
+}
+
+/**
+ * @brief Creates a new, empty BPlusTree (the root is an empty leaf).
+ *
+ * @param compare_func A function pointer used to compare elements.
+ * @return A pointer to the new BPlusTree, or NULL if memory fails.
+ */
+BPlusTree* bpt_create(CompareFunc compare_func){
+    BPlusTree* tree = (BPlusTree*)malloc(sizeof(BPlusTree));
+    if(tree == NULL) return NULL;
+    BPTLeaf* leaf = _bpt_leaf_create();
+    if(leaf == NULL){
+        free(tree);
+        return NULL;
+    }
+    tree->root = &leaf->base;
+    tree->first = leaf;
+    tree->last = leaf;
+    tree->counter = 0;
+    tree->height = 1;
+    tree->compare = compare_func;
+    return tree;
+}
+
+/**
+ * @brief Frees all memory associated with the BPlusTree.
+ *
+ * Note: This does NOT free the actual data stored in the tree.
+ * That is the caller's responsibility.
+ *
+ * @param tree The BPlusTree to free.
+ */
+void bpt_free(BPlusTree* tree){
+    if(tree == NULL) return;
+    _bpt_free_node(tree->root);
+    free(tree);
+}
+
+/**
+ * @brief (Private) Descends to the leaf that may contain 'data'.
+ */
+static BPTLeaf* _bpt_find_leaf(BPlusTree* tree, void* data){
+    BPTNode* node = tree->root;
+    while(!node->is_leaf){
+        node = ((BPTInternal*)node)->children[_bpt_child_index(tree, node, data)];
+    }
+    return (BPTLeaf*)node;
+}
+
+/**
+ * @brief Finds an element in the tree.
+ *
+ * @param tree The tree to search in.
+ * @param data_to_find A "template" data object to search for.
+ * @return A pointer to the data if found, or NULL otherwise.
+ */
+void* bpt_find(BPlusTree* tree, void* data_to_find){
+    if(tree == NULL || tree->counter == 0) return NULL;
+    BPTNode* leaf = &_bpt_find_leaf(tree, data_to_find)->base;
+    int pos = _bpt_lower_bound(tree, leaf, data_to_find);
+    if(pos < leaf->count && tree->compare(data_to_find, leaf->keys[pos]) == 0) return leaf->keys[pos];
+    return NULL;
+}
+
+/*Results of the recursive insert*/
+#define BPT_DUPLICATE   -1
+#define BPT_NO_MEMORY    0
+#define BPT_INSERTED     1
+#define BPT_SPLIT        2
+
+/**
+ * @brief (Private) Recursive insert. Splits full nodes on the way back up.
+ *
+ * Nodes that could split allocate their new sibling before anything is
+ * modified, so a failed malloc never leaves the tree half-updated.
+ *
+ * @param tree The tree.
+ * @param node Root of the subtree to insert into.
+ * @param data The element to insert.
+ * @param up_key [out] On BPT_SPLIT, the smallest element of 'up_node'.
+ * @param up_node [out] On BPT_SPLIT, the new right sibling of 'node'.
+ * @return BPT_DUPLICATE, BPT_NO_MEMORY, BPT_INSERTED or BPT_SPLIT.
+ */
+static int _bpt_insert(BPlusTree* tree, BPTNode* node, void* data, void** up_key, BPTNode** up_node){
+    if(node->is_leaf){
+        int pos = _bpt_lower_bound(tree, node, data);
+        if(pos < node->count && tree->compare(data, node->keys[pos]) == 0) return BPT_DUPLICATE;
+        if(node->count < BPT_MAX_KEYS){
+            memmove(&node->keys[pos + 1], &node->keys[pos], (size_t)(node->count - pos) * sizeof(void*));
+            node->keys[pos] = data;
+            node->count++;
+            return BPT_INSERTED;
+        }
+        BPTLeaf* leaf = (BPTLeaf*)node;
+        BPTLeaf* right = _bpt_leaf_create();
+        if(right == NULL) return BPT_NO_MEMORY;
+        void* all[BPT_MAX_KEYS + 1];
+        memcpy(all, node->keys, (size_t)pos * sizeof(void*));
+        all[pos] = data;
+        memcpy(&all[pos + 1], &node->keys[pos], (size_t)(BPT_MAX_KEYS - pos) * sizeof(void*));
+        int left_count = (BPT_MAX_KEYS + 1) / 2;
+        node->count = left_count;
+        memcpy(node->keys, all, (size_t)left_count * sizeof(void*));
+        right->base.count = BPT_MAX_KEYS + 1 - left_count;
+        memcpy(right->base.keys, &all[left_count], (size_t)right->base.count * sizeof(void*));
+        right->next = leaf->next;
+        right->prev = leaf;
+        if(leaf->next != NULL) leaf->next->prev = right;
+        else tree->last = right;
+        leaf->next = right;
+        *up_key = right->base.keys[0];
+        *up_node = &right->base;
+        return BPT_SPLIT;
+    }
+
+    BPTInternal* internal = (BPTInternal*)node;
+    BPTInternal* spare = NULL;
+    if(node->count == BPT_MAX_KEYS){
+        spare = _bpt_internal_create();
+        if(spare == NULL) return BPT_NO_MEMORY;
+    }
+    int i = _bpt_child_index(tree, node, data);
+    void* child_key;
+    BPTNode* child_right;
+    int result = _bpt_insert(tree, internal->children[i], data, &child_key, &child_right);
+    if(result != BPT_SPLIT){
+        free(spare);
+        return result;
+    }
+    if(spare == NULL){
+        memmove(&node->keys[i + 1], &node->keys[i], (size_t)(node->count - i) * sizeof(void*));
+        memmove(&internal->children[i + 2], &internal->children[i + 1], (size_t)(node->count - i) * sizeof(BPTNode*));
+        node->keys[i] = child_key;
+        internal->children[i + 1] = child_right;
+        node->count++;
+        return BPT_INSERTED;
+    }
+
+    /* Split a full internal node: the middle separator moves up */
+    void* keys[BPT_MAX_KEYS + 1];
+    BPTNode* children[BPT_MAX_KEYS + 2];
+    memcpy(keys, node->keys, (size_t)i * sizeof(void*));
+    keys[i] = child_key;
+    memcpy(&keys[i + 1], &node->keys[i], (size_t)(BPT_MAX_KEYS - i) * sizeof(void*));
+    memcpy(children, internal->children, (size_t)(i + 1) * sizeof(BPTNode*));
+    children[i + 1] = child_right;
+    memcpy(&children[i + 2], &internal->children[i + 1], (size_t)(BPT_MAX_KEYS - i) * sizeof(BPTNode*));
+    int mid = (BPT_MAX_KEYS + 1) / 2;
+    node->count = mid;
+    memcpy(node->keys, keys, (size_t)mid * sizeof(void*));
+    memcpy(internal->children, children, (size_t)(mid + 1) * sizeof(BPTNode*));
+    spare->base.count = BPT_MAX_KEYS - mid;
+    memcpy(spare->base.keys, &keys[mid + 1], (size_t)spare->base.count * sizeof(void*));
+    memcpy(spare->children, &children[mid + 1], (size_t)(spare->base.count + 1) * sizeof(BPTNode*));
+    *up_key = keys[mid];
+    *up_node = &spare->base;
+    return BPT_SPLIT;
+}
+
+/**
+ * @brief Inserts an element into the tree, maintaining sort order.
+ *
+ * @param tree The tree to insert into.
+ * @param data The data to insert.
+ * @return 1 on success, 0 on failure (data exists or malloc fails).
+ */
+int bpt_insert(BPlusTree* tree, void* data){
+    if(tree == NULL) return 0;
+    BPTInternal* new_root = NULL;
+    if(tree->root->count == BPT_MAX_KEYS){
+        new_root = _bpt_internal_create();
+        if(new_root == NULL) return 0;
+    }
+    void* up_key;
+    BPTNode* up_node;
+    int result = _bpt_insert(tree, tree->root, data, &up_key, &up_node);
+    if(result == BPT_SPLIT){
+        new_root->base.count = 1;
+        new_root->base.keys[0] = up_key;
+        new_root->children[0] = tree->root;
+        new_root->children[1] = up_node;
+        tree->root = &new_root->base;
+        tree->height++;
+    }
+    else free(new_root);
+    if(result == BPT_INSERTED || result == BPT_SPLIT){
+        tree->counter++;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief (Private) Fixes an underflowing child by borrowing or merging.
+ *
+ * Borrows one element from a sibling that has more than the minimum;
+ * otherwise merges the child with a sibling and drops their separator
+ * from 'parent' (which may then underflow itself).
+ *
+ * @param tree The tree.
+ * @param parent The internal node holding the child.
+ * @param i Index of the underflowing child.
+ */
+static void _bpt_rebalance(BPlusTree* tree, BPTInternal* parent, int i){
+    BPTNode* child = parent->children[i];
+    BPTNode* left = i > 0 ? parent->children[i - 1] : NULL;
+    BPTNode* right = i < parent->base.count ? parent->children[i + 1] : NULL;
+
+    if(left != NULL && left->count > BPT_MIN_KEYS){
+        memmove(&child->keys[1], &child->keys[0], (size_t)child->count * sizeof(void*));
+        if(child->is_leaf){
+            child->keys[0] = left->keys[left->count - 1];
+            parent->base.keys[i - 1] = child->keys[0];
+        }
+        else{
+            BPTInternal* c = (BPTInternal*)child;
+            BPTInternal* l = (BPTInternal*)left;
+            memmove(&c->children[1], &c->children[0], (size_t)(child->count + 1) * sizeof(BPTNode*));
+            child->keys[0] = parent->base.keys[i - 1];
+            c->children[0] = l->children[left->count];
+            parent->base.keys[i - 1] = left->keys[left->count - 1];
+        }
+        child->count++;
+        left->count--;
+        return;
+    }
+    if(right != NULL && right->count > BPT_MIN_KEYS){
+        if(child->is_leaf){
+            child->keys[child->count] = right->keys[0];
+            memmove(&right->keys[0], &right->keys[1], (size_t)(right->count - 1) * sizeof(void*));
+            parent->base.keys[i] = right->keys[0];
+        }
+        else{
+            BPTInternal* c = (BPTInternal*)child;
+            BPTInternal* r = (BPTInternal*)right;
+            child->keys[child->count] = parent->base.keys[i];
+            c->children[child->count + 1] = r->children[0];
+            parent->base.keys[i] = right->keys[0];
+            memmove(&right->keys[0], &right->keys[1], (size_t)(right->count - 1) * sizeof(void*));
+            memmove(&r->children[0], &r->children[1], (size_t)right->count * sizeof(BPTNode*));
+        }
+        child->count++;
+        right->count--;
+        return;
+    }
+
+    /* Merge: 'dst' absorbs its right neighbour 'src' (separator index 'sep') */
+    int sep = left != NULL ? i - 1 : i;
+    BPTNode* dst = left != NULL ? left : child;
+    BPTNode* src = left != NULL ? child : right;
+    if(src == NULL) return;
+    if(dst->is_leaf){
+        BPTLeaf* d = (BPTLeaf*)dst;
+        BPTLeaf* s = (BPTLeaf*)src;
+        memcpy(&dst->keys[dst->count], src->keys, (size_t)src->count * sizeof(void*));
+        dst->count += src->count;
+        d->next = s->next;
+        if(s->next != NULL) s->next->prev = d;
+        else tree->last = d;
+    }
+    else{
+        BPTInternal* d = (BPTInternal*)dst;
+        BPTInternal* s = (BPTInternal*)src;
+        dst->keys[dst->count] = parent->base.keys[sep];
+        memcpy(&dst->keys[dst->count + 1], src->keys, (size_t)src->count * sizeof(void*));
+        memcpy(&d->children[dst->count + 1], s->children, (size_t)(src->count + 1) * sizeof(BPTNode*));
+        dst->count += src->count + 1;
+    }
+    free(src);
+    memmove(&parent->base.keys[sep], &parent->base.keys[sep + 1],
+            (size_t)(parent->base.count - sep - 1) * sizeof(void*));
+    memmove(&parent->children[sep + 1], &parent->children[sep + 2],
+            (size_t)(parent->base.count - sep - 1) * sizeof(BPTNode*));
+    parent->base.count--;
+}
+
+/**
+ * @brief (Private) Recursive remove.
+ *
+ * On the way back up it replaces any separator that pointed at the removed
+ * element (the caller is about to free it) and rebalances underflowing
+ * children.
+ *
+ * @return The removed element, or NULL if it was not found.
+ */
+static void* _bpt_remove(BPlusTree* tree, BPTNode* node, void* data){
+    if(node->is_leaf){
+        int pos = _bpt_lower_bound(tree, node, data);
+        if(pos == node->count || tree->compare(data, node->keys[pos]) != 0) return NULL;
+        void* removed = node->keys[pos];
+        memmove(&node->keys[pos], &node->keys[pos + 1], (size_t)(node->count - pos - 1) * sizeof(void*));
+        node->count--;
+        return removed;
+    }
+    BPTInternal* internal = (BPTInternal*)node;
+    int i = _bpt_child_index(tree, node, data);
+    void* removed = _bpt_remove(tree, internal->children[i], data);
+    if(removed == NULL) return NULL;
+    if(i > 0 && node->keys[i - 1] == removed){
+        node->keys[i - 1] = _bpt_min(internal->children[i]);
+    }
+    if(internal->children[i]->count < BPT_MIN_KEYS) _bpt_rebalance(tree, internal, i);
+    return removed;
+}
+
+/**
+ * @brief Removes an element from the tree.
+ *
+ * @param tree The tree to remove from.
+ * @param data_to_remove A "template" data object to find and remove.
+ * @return The pointer to the removed data (so the caller can free it),
+ * or NULL if the element was not found.
+ */
+void* bpt_remove(BPlusTree* tree, void* data_to_remove){
+    if(tree == NULL || tree->counter == 0) return NULL;
+    void* removed = _bpt_remove(tree, tree->root, data_to_remove);
+    if(removed == NULL) return NULL;
+    tree->counter--;
+    if(!tree->root->is_leaf && tree->root->count == 0){
+        BPTNode* old_root = tree->root;
+        tree->root = ((BPTInternal*)old_root)->children[0];
+        free(old_root);
+        tree->height--;
+    }
+    return removed;
+}
+
+/**
+ * @brief Builds the tree bottom-up from already sorted elements in O(n).
+ *
+ * Leaves are filled almost completely (evenly spread, so every node stays
+ * above the minimum), then each internal level is built over the one
+ * below. Much cheaper than n calls to bpt_insert.
+ *
+ * @param tree An empty tree.
+ * @param sorted Elements in strictly ascending order.
+ * @param count Number of elements.
+ * @return 1 on success, 0 if the tree is not empty, the input is not
+ * strictly ascending, or memory fails (the tree is left empty).
+ */
+int bpt_bulk_load(BPlusTree* tree, void** sorted, int count){
+    if(tree == NULL || tree->counter != 0 || (count > 0 && sorted == NULL)) return 0;
+    for(int i = 1; i < count; i++){
+        if(tree->compare(sorted[i - 1], sorted[i]) >= 0) return 0;
+    }
+    if(count == 0) return 1;
+
+    int nodes = (count + BPT_MAX_KEYS - 1) / BPT_MAX_KEYS;
+    BPTNode** level = (BPTNode**)malloc((size_t)nodes * sizeof(BPTNode*));
+    void** mins = (void**)malloc((size_t)nodes * sizeof(void*));
+    if(level == NULL || mins == NULL){
+        free(level);
+        free(mins);
+        return 0;
+    }
+    int built = 0;
+    int offset = 0;
+    BPTLeaf* previous = NULL;
+    for(int n = 0; n < nodes; n++){
+        int take = count / nodes + (n < count % nodes ? 1 : 0);
+        BPTLeaf* leaf = _bpt_leaf_create();
+        if(leaf == NULL) break;
+        memcpy(leaf->base.keys, &sorted[offset], (size_t)take * sizeof(void*));
+        leaf->base.count = take;
+        leaf->prev = previous;
+        if(previous != NULL) previous->next = leaf;
+        previous = leaf;
+        level[n] = &leaf->base;
+        mins[n] = sorted[offset];
+        offset += take;
+        built++;
+    }
+
+    int height = 1;
+    while(built == nodes && nodes > 1){
+        int parents = (nodes + BPT_MAX_KEYS) / (BPT_MAX_KEYS + 1);
+        int child = 0;
+        int made = 0;
+        for(int p = 0; p < parents; p++){
+            int take = nodes / parents + (p < nodes % parents ? 1 : 0);
+            BPTInternal* internal = _bpt_internal_create();
+            if(internal == NULL) break;
+            for(int k = 0; k < take; k++){
+                internal->children[k] = level[child + k];
+                if(k > 0) internal->base.keys[k - 1] = mins[child + k];
+            }
+            internal->base.count = take - 1;
+            void* min = mins[child];
+            level[p] = &internal->base;
+            mins[p] = min;
+            child += take;
+            made++;
+        }
+        if(made != parents){
+            /* Free the new parents, then everything still orphaned below them */
+            for(int p = 0; p < made; p++) _bpt_free_node(level[p]);
+            for(int k = child; k < nodes; k++) _bpt_free_node(level[k]);
+            built = 0;
+            break;
+        }
+        nodes = parents;
+        built = parents;
+        height++;
+    }
+    if(built != nodes){
+        /* Out of memory: release what was built and leave the tree empty */
+        for(int k = 0; k < built; k++) _bpt_free_node(level[k]);
+        free(level);
+        free(mins);
+        return 0;
+    }
+
+    free(tree->root);
+    tree->root = level[0];
+    BPTNode* node = tree->root;
+    while(!node->is_leaf) node = ((BPTInternal*)node)->children[0];
+    tree->first = (BPTLeaf*)node;
+    tree->last = previous;
+    tree->counter = count;
+    tree->height = height;
+    free(level);
+    free(mins);
+    return 1;
+}
+
+/**
+ * @brief Visits, in order, every element in the range [low, high).
+ *
+ * Descends once to the first leaf that may contain 'low', then follows
+ * the leaf chain: O(log n + k) for k visited elements.
+ *
+ * @param tree The tree to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int bpt_range(BPlusTree* tree, void* low, void* high, VisitFunc visit, void* context){
+    if(tree == NULL || visit == NULL || tree->counter == 0) return 0;
+    BPTLeaf* leaf = tree->first;
+    int pos = 0;
+    if(low != NULL){
+        leaf = _bpt_find_leaf(tree, low);
+        pos = _bpt_lower_bound(tree, &leaf->base, low);
+    }
+    int visited = 0;
+    while(leaf != NULL){
+        for(; pos < leaf->base.count; pos++){
+            void* data = leaf->base.keys[pos];
+            if(high != NULL && tree->compare(data, high) >= 0) return visited;
+            visited++;
+            if(!visit(data, context)) return visited;
+        }
+        leaf = leaf->next;
+        pos = 0;
+    }
+    return visited;
+}
+
+/**
+ * @brief Visits, in descending order, every element in the range [low, high).
+ *
+ * Mirror of bpt_range: descends once to the leaf that may contain 'high'
+ * (or starts at the last leaf), then follows the leaf chain backwards.
+ * O(log n + k), so "the k largest" never touches the rest of the tree.
+ *
+ * @param tree The tree to scan.
+ * @param low Inclusive lower bound template, or NULL to run to the first element.
+ * @param high Exclusive upper bound template, or NULL to start at the last element.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int bpt_range_reverse(BPlusTree* tree, void* low, void* high, VisitFunc visit, void* context){
+    if(tree == NULL || visit == NULL || tree->counter == 0) return 0;
+    BPTLeaf* leaf = tree->last;
+    int pos = leaf->base.count - 1;
+    if(high != NULL){
+        leaf = _bpt_find_leaf(tree, high);
+        pos = _bpt_lower_bound(tree, &leaf->base, high) - 1;
+    }
+    int visited = 0;
+    while(leaf != NULL){
+        for(; pos >= 0; pos--){
+            void* data = leaf->base.keys[pos];
+            if(low != NULL && tree->compare(data, low) < 0) return visited;
+            visited++;
+            if(!visit(data, context)) return visited;
+        }
+        leaf = leaf->prev;
+        if(leaf != NULL) pos = leaf->base.count - 1;
+    }
+    return visited;
+}
+
+/**
+ * @brief Prints all elements in the tree to the console, in order.
+ *
+ * @param tree The tree to print.
+ * @param print_func The function that knows how to print a single element.
+ */
+void bpt_print(BPlusTree* tree, PrintFunc print_func){
+    if(tree == NULL || print_func == NULL) return;
+    for(BPTLeaf* leaf = tree->first; leaf != NULL; leaf = leaf->next){
+        for(int i = 0; i < leaf->base.count; i++) print_func(leaf->base.keys[i]);
+    }
+}
@@ -0,0 +1,393 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "bulkBuild.h"
+
+/*
+ * bulkBuild.c
+ *
+ * Builds an OrderedArray or LinkedList from a large unsorted set of rows
+ * (e.g. the output of csv_load_students) in three steps:
+ *
+ * 1. SORT:   a stable merge sort with the container's CompareFunc. The
+ *            input is split into one chunk per thread, the chunks are
+ *            sorted in parallel by a small thread pool, then adjacent runs
+ *            are merged pairwise, every merge of a round in parallel.
+ * 2. DEDUPE: one linear pass over the sorted rows. Rows that compare
+ *            equal are neighbours and still in input order (the sort is
+ *            stable), so the policy keeps the first or the last of each
+ *            group and moves the rest behind the kept rows.
+ * 3. LOAD:   oa_append_sorted/list_append_sorted take the sorted unique
+ *            run in one linear pass: no search and no shifting per row.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - TIME:   O((n / T) log(n / T)) for the chunk sorts on T threads, plus
+ *           log T merge rounds of O(n) work each, spread over fewer
+ *           threads as the runs get longer (the last round is one merge).
+ *           Then O(n) to dedupe and O(n) to load.
+ * - MEMORY: One scratch array of n pointers while sorting.
+ * - INPUT:  Small inputs (under BULK_MIN_CHUNK rows per thread) are
+ *           sorted on fewer threads, down to the calling thread alone.
+ */
+
+
+/*One unit of work for the pool*/
+typedef struct{
+    void (*run)(void* arg);
+    void* arg;
+}BulkTask;
+
+/*Fixed set of worker threads that run batches of tasks*/
+typedef struct{
+    pthread_t workers[BULK_MAX_THREADS];
+    int worker_count;
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    BulkTask* tasks;
+    int task_count;
+    int next_task;
+    int pending;        /*Tasks of the current batch not finished yet*/
+    int stop;
+}BulkPool;
+
+/*A sort or merge over [lo, hi) of 'src', written to 'dst'*/
+typedef struct{
+    void** src;
+    void** dst;
+    int lo;
+    int mid;            /*Merges: start of the second run*/
+    int hi;
+    CompareFunc compare;
+}BulkRun;
+
+/*Runs shorter than this are sorted by insertion before merging*/
+#define BULK_INSERTION_RUN 16
+
+
+/**
+ * @brief (Private) Worker loop: takes tasks until the pool stops.
+ */
+static void* _bulk_worker(void* arg){
+    BulkPool* pool = (BulkPool*)arg;
+    pthread_mutex_lock(&pool->lock);
+    for(;;){
+        while(!pool->stop && pool->next_task >= pool->task_count) pthread_cond_wait(&pool->work_ready, &pool->lock);
+        if(pool->next_task >= pool->task_count) break;
+        BulkTask task = pool->tasks[pool->next_task++];
+        pthread_mutex_unlock(&pool->lock);
+        task.run(task.arg);
+        pthread_mutex_lock(&pool->lock);
+        if(--pool->pending == 0) pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief (Private) Starts up to 'threads' workers.
+ *
+ * If threads cannot be created the pool keeps the ones it has; with none,
+ * _bulk_pool_run runs the tasks on the calling thread.
+ */
+static void _bulk_pool_start(BulkPool* pool, int threads){
+    pool->worker_count = 0;
+    pool->tasks = NULL;
+    pool->task_count = 0;
+    pool->next_task = 0;
+    pool->pending = 0;
+    pool->stop = 0;
+    if(threads <= 1) return;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    while(pool->worker_count < threads
+          && pthread_create(&pool->workers[pool->worker_count], NULL, _bulk_worker, pool) == 0){
+        pool->worker_count++;
+    }
+    if(pool->worker_count == 0){
+        pthread_cond_destroy(&pool->work_done);
+        pthread_cond_destroy(&pool->work_ready);
+        pthread_mutex_destroy(&pool->lock);
+    }
+}
+
+/**
+ * @brief (Private) Runs a batch of tasks and waits until all of them finish.
+ */
+static void _bulk_pool_run(BulkPool* pool, BulkTask* tasks, int count){
+    if(pool->worker_count == 0){
+        for(int i = 0; i < count; i++) tasks[i].run(tasks[i].arg);
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->tasks = tasks;
+    pool->task_count = count;
+    pool->next_task = 0;
+    pool->pending = count;
+    pthread_cond_broadcast(&pool->work_ready);
+    while(pool->pending > 0) pthread_cond_wait(&pool->work_done, &pool->lock);
+    pool->tasks = NULL;
+    pool->task_count = 0;
+    pool->next_task = 0;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief (Private) Stops and joins the workers.
+ */
+static void _bulk_pool_stop(BulkPool* pool){
+    if(pool->worker_count == 0) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for(int i = 0; i < pool->worker_count; i++) pthread_join(pool->workers[i], NULL);
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+/**
+ * @brief (Private) Stable merge of src[lo, mid) and src[mid, hi) into dst[lo, hi).
+ */
+static void _bulk_merge(void** src, void** dst, int lo, int mid, int hi, CompareFunc compare){
+    int i = lo, j = mid, k = lo;
+    while(i < mid && j < hi){
+        if(compare(src[j], src[i]) < 0) dst[k++] = src[j++];
+        else dst[k++] = src[i++];
+    }
+    while(i < mid) dst[k++] = src[i++];
+    while(j < hi) dst[k++] = src[j++];
+}
+
+/**
+ * @brief (Private) Task: stable sort of src[lo, hi), result left in src.
+ *
+ * Insertion sort on runs of BULK_INSERTION_RUN, then bottom-up merging
+ * through dst[lo, hi), copied back if the last pass ended there.
+ */
+static void _bulk_sort_task(void* arg){
+    BulkRun* run = (BulkRun*)arg;
+    void** a = run->src;
+    for(int start = run->lo; start < run->hi; start += BULK_INSERTION_RUN){
+        int end = start + BULK_INSERTION_RUN < run->hi ? start + BULK_INSERTION_RUN : run->hi;
+        for(int i = start + 1; i < end; i++){
+            void* item = a[i];
+            int j = i;
+            while(j > start && run->compare(item, a[j - 1]) < 0){
+                a[j] = a[j - 1];
+                j--;
+            }
+            a[j] = item;
+        }
+    }
+    void** src = run->src;
+    void** dst = run->dst;
+    for(int width = BULK_INSERTION_RUN; width < run->hi - run->lo; width *= 2){
+        for(int lo = run->lo; lo < run->hi; lo += 2 * width){
+            int mid = lo + width < run->hi ? lo + width : run->hi;
+            int hi = lo + 2 * width < run->hi ? lo + 2 * width : run->hi;
+            _bulk_merge(src, dst, lo, mid, hi, run->compare);
+        }
+        void** swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if(src != run->src) memcpy(&run->src[run->lo], &src[run->lo], (size_t)(run->hi - run->lo) * sizeof(void*));
+}
+
+/**
+ * @brief (Private) Task: merges two adjacent runs (or copies a lone one).
+ */
+static void _bulk_merge_task(void* arg){
+    BulkRun* run = (BulkRun*)arg;
+    _bulk_merge(run->src, run->dst, run->lo, run->mid, run->hi, run->compare);
+}
+
+/**
+ * @brief (Private) Number of sorting threads for 'count' rows.
+ */
+static int _bulk_thread_count(const BulkOptions* options, int count){
+    int threads = options != NULL ? options->threads : 0;
+    if(threads <= 0){
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (int)online : 1;
+    }
+    if(threads > BULK_MAX_THREADS) threads = BULK_MAX_THREADS;
+    int useful = count / BULK_MIN_CHUNK;
+    if(threads > useful) threads = useful;
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * @brief (Private) Stable parallel merge sort of items[0, count).
+ *
+ * @param tmp Scratch buffer with room for 'count' pointers.
+ * @param threads Chunks to sort in parallel (1 = calling thread only).
+ * @return 1 on success, 0 if memory fails (items are left untouched).
+ */
+static int _bulk_parallel_sort(void** items, void** tmp, int count, CompareFunc compare, int threads){
+    BulkRun* runs = (BulkRun*)malloc((size_t)threads * sizeof(BulkRun));
+    BulkTask* tasks = (BulkTask*)malloc((size_t)threads * sizeof(BulkTask));
+    int* bounds = (int*)malloc((size_t)(threads + 1) * sizeof(int));
+    if(runs == NULL || tasks == NULL || bounds == NULL){
+        free(runs);
+        free(tasks);
+        free(bounds);
+        return 0;
+    }
+    BulkPool pool;
+    _bulk_pool_start(&pool, threads);
+
+    for(int t = 0; t <= threads; t++) bounds[t] = (int)((long long)count * t / threads);
+    for(int t = 0; t < threads; t++){
+        runs[t] = (BulkRun){items, tmp, bounds[t], bounds[t], bounds[t + 1], compare};
+        tasks[t] = (BulkTask){_bulk_sort_task, &runs[t]};
+    }
+    _bulk_pool_run(&pool, tasks, threads);
+
+    void** src = items;
+    void** dst = tmp;
+    int run_count = threads;
+    while(run_count > 1){
+        int merges = 0;
+        for(int r = 0; r < run_count; r += 2){
+            int hi = r + 2 <= run_count ? bounds[r + 2] : bounds[r + 1];
+            runs[merges] = (BulkRun){src, dst, bounds[r], bounds[r + 1], hi, compare};
+            tasks[merges] = (BulkTask){_bulk_merge_task, &runs[merges]};
+            bounds[merges] = bounds[r];
+            merges++;
+        }
+        bounds[merges] = count;
+        _bulk_pool_run(&pool, tasks, merges);
+        run_count = merges;
+        void** swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if(src != items) memcpy(items, src, (size_t)count * sizeof(void*));
+
+    _bulk_pool_stop(&pool);
+    free(runs);
+    free(tasks);
+    free(bounds);
+    return 1;
+}
+
+/**
+ * @brief Sorts rows in parallel and removes duplicate keys.
+ *
+ * The 'items' array is reordered: on return items[0 .. result) are the
+ * kept rows, sorted and unique, and items[result .. count) the rows the
+ * dedupe policy dropped (so the caller can free them).
+ *
+ * @param items The rows to sort.
+ * @param count Number of rows.
+ * @param compare_func The ordering (and equality) of the target container.
+ * @param options Threads and dedupe policy (NULL: all CPUs, BULK_KEEP_FIRST).
+ * @param report [out] Optional. Receives the counts of the build.
+ * @return The number of unique rows, or 0 if there is no input or memory
+ * fails (in which case 'items' is left in its original order).
+ */
+int bulk_sort(void** items, int count, CompareFunc compare_func, const BulkOptions* options, BulkReport* report){
+    BulkReport local;
+    if(report == NULL) report = &local;
+    memset(report, 0, sizeof(BulkReport));
+    if(items == NULL || compare_func == NULL || count <= 0) return 0;
+    report->input = count;
+    void** tmp = (void**)malloc((size_t)count * sizeof(void*));
+    if(tmp == NULL) return 0;
+    report->threads = _bulk_thread_count(options, count);
+    if(!_bulk_parallel_sort(items, tmp, count, compare_func, report->threads)){
+        free(tmp);
+        return 0;
+    }
+
+    BulkDedupe dedupe = options != NULL ? options->dedupe : BULK_KEEP_FIRST;
+    int kept = 0;
+    int dropped = 0;
+    for(int i = 0; i < count; ){
+        int end = i + 1;
+        while(end < count && compare_func(items[i], items[end]) == 0) end++;
+        int keep = dedupe == BULK_KEEP_LAST ? end - 1 : i;
+        void* survivor = items[keep];
+        for(int k = i; k < end; k++){
+            if(k != keep) tmp[dropped++] = items[k];
+        }
+        items[kept++] = survivor;
+        i = end;
+    }
+    memcpy(&items[kept], tmp, (size_t)dropped * sizeof(void*));
+    free(tmp);
+
+    if(dedupe == BULK_REPORT && dropped > 0){
+        int listed = 0;
+        for(; options->key_func != NULL && listed < dropped && listed < BULK_MAX_REPORTED; listed++){
+            fprintf(stderr, "Duplicate row dropped: key %ld\n", options->key_func(items[kept + listed]));
+        }
+        if(dropped > listed) fprintf(stderr, "%d %sduplicate rows dropped\n", dropped - listed, listed > 0 ? "more " : "");
+    }
+    report->unique = kept;
+    report->duplicates = dropped;
+    return kept;
+}
+
+/**
+ * @brief Builds an OrderedArray from unsorted rows: parallel sort, dedupe, linear load.
+ *
+ * Replaces N oa_insert_sorted calls (O(N^2) shifting, duplicates rejected
+ * one by one) with bulk_sort and one oa_append_sorted. The array is
+ * created with exactly the capacity it needs and can be made growable
+ * afterwards (oa_set_growth).
+ *
+ * @param items The rows. Reordered like bulk_sort: the rows after the
+ * array's counter were dropped as duplicates and belong to the caller.
+ * @param count Number of rows.
+ * @param compare_func The array's ordering.
+ * @param options Threads and dedupe policy (NULL: all CPUs, BULK_KEEP_FIRST).
+ * @param report [out] Optional. Receives the counts of the build.
+ * @return The new array, or NULL if memory fails.
+ */
+OrderedArray* bulk_build_oa(void** items, int count, CompareFunc compare_func,
+                            const BulkOptions* options, BulkReport* report){
+    int unique = bulk_sort(items, count, compare_func, options, report);
+    if(count > 0 && unique == 0) return NULL;
+    OrderedArray* arr = oa_create(unique > 0 ? unique : 1, compare_func);
+    if(arr == NULL) return NULL;
+    if(unique > 0 && oa_append_sorted(arr, items, unique) != unique){
+        oa_free(arr);
+        return NULL;
+    }
+    return arr;
+}
+
+/**
+ * @brief Builds a LinkedList from unsorted rows: parallel sort, dedupe, linear load.
+ *
+ * The list is pooled (list_create_pooled), so its nodes come from a few
+ * slabs instead of one malloc each.
+ *
+ * @param items The rows. Reordered like bulk_sort: the rows after the
+ * list's counter were dropped as duplicates and belong to the caller.
+ * @param count Number of rows.
+ * @param compare_func The list's ordering.
+ * @param options Threads and dedupe policy (NULL: all CPUs, BULK_KEEP_FIRST).
+ * @param report [out] Optional. Receives the counts of the build.
+ * @return The new list, or NULL if memory fails.
+ */
+LinkedList* bulk_build_list(void** items, int count, CompareFunc compare_func,
+                            const BulkOptions* options, BulkReport* report){
+    int unique = bulk_sort(items, count, compare_func, options, report);
+    if(count > 0 && unique == 0) return NULL;
+    LinkedList* list = list_create_pooled(compare_func, LIST_DEFAULT_SLAB_SIZE);
+    if(list == NULL) return NULL;
+    if(unique > 0 && list_append_sorted(list, items, unique) != unique){
+        list_free(list);
+        return NULL;
+    }
+    return list;
+}
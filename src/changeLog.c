@@ -0,0 +1,705 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include "changeLog.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define WAL_HAVE_POSIX 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * changeLog.c
+ *
+ * Append-only write-ahead log of the inserts and removes applied to the
+ * Student/Product containers, so changes survive a restart without
+ * rewriting the whole dataset. The base data (CSV or snapshot) is loaded
+ * first, then wal_replay_* applies the log on top of it.
+ *
+ * - ENTRIES: a 16-byte header (CRC-32, op, id) plus, for inserts, the
+ *            fixed-width snapshot record (SnapStudent/SnapProduct) and
+ *            the name bytes it counts. An insert of an existing id
+ *            replaces it, a remove of a missing id does nothing, so
+ *            replaying an entry twice is harmless.
+ * - COMMIT:  wal_log_* only appends to a memory buffer. wal_commit (run
+ *            on its own every 'group_size' entries) writes the buffer
+ *            with one fwrite and makes it durable with one fsync, so the
+ *            fsync cost is shared by the whole group. Entries logged
+ *            since the last commit are lost on a crash.
+ * - RECOVERY: a crash in the middle of a commit leaves a torn last entry.
+ *            Replay stops at the first entry whose CRC does not match and
+ *            reports the ignored bytes; wal_open truncates them.
+ * - COMPACTION: wal_compact_* writes the containers to a fresh sorted
+ *            CSV or snapshot (temporary file + rename, fsynced), then
+ *            empties the log. A crash between the two steps only leaves
+ *            entries that replay to the same state.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - LOG:     O(1) per change, amortized one fsync per group instead of one
+ *            per change (or one full rewrite per change).
+ * - REPLAY:  O(e) entries, each an insert or remove in the container.
+ * - COMPACT: O(n) sequential write. Worth it once the log holds more
+ *            entries than the containers hold records.
+ * - DISK:    16 bytes per remove, 16 + record size + name length per insert.
+ */
+
+_Static_assert(sizeof(WalHeader) == 32, "WalHeader must stay 32 bytes");
+_Static_assert(sizeof(WalEntry) == 16, "WalEntry must stay 16 bytes");
+
+/*Called by _wal_scan for every valid entry ('record' and 'name' NULL for removes). Returns 1 to go on, 0 to fail*/
+typedef int (*WalApplyFunc)(WalOp op, int64_t id, const void* record, const char* name, void* context);
+
+/*Replay state shared with the apply callbacks*/
+typedef struct{
+    OrderedArray* arr;
+    LinkedList* list;
+    WalReplayReport* report;
+}WalReplayTarget;
+
+/*One record of either type*/
+typedef union{
+    SnapStudent student;
+    SnapProduct product;
+}WalRecord;
+
+static uint32_t WAL_CRC_TABLE[256];
+static pthread_once_t WAL_CRC_ONCE = PTHREAD_ONCE_INIT;
+
+
+/**
+ * @brief (Private) Fills the CRC-32 (IEEE, reflected) lookup table.
+ */
+static void _wal_crc_init(void){
+    for(uint32_t i = 0; i < 256; i++){
+        uint32_t crc = i;
+        for(int bit = 0; bit < 8; bit++) crc = (crc & 1u) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        WAL_CRC_TABLE[i] = crc;
+    }
+}
+
+/**
+ * @brief (Private) CRC-32 of an entry: its header after the crc field, then its record and name.
+ */
+static uint32_t _wal_entry_crc(const WalEntry* entry, const void* record, size_t record_size,
+                               const char* name, size_t name_length){
+    pthread_once(&WAL_CRC_ONCE, _wal_crc_init);
+    uint32_t crc = 0xFFFFFFFFu;
+    const unsigned char* parts[3] = {(const unsigned char*)&entry->op, (const unsigned char*)record,
+                                     (const unsigned char*)name};
+    size_t sizes[3] = {sizeof(WalEntry) - sizeof(entry->crc), record != NULL ? record_size : 0,
+                       record != NULL ? name_length : 0};
+    for(int part = 0; part < 3; part++){
+        for(size_t i = 0; i < sizes[part]; i++) crc = WAL_CRC_TABLE[(crc ^ parts[part][i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief (Private) Length of the name that follows an insert's record.
+ */
+static uint32_t _wal_name_length(SnapshotType type, const WalRecord* record){
+    return type == SNAP_STUDENTS ? record->student.name_length : record->product.name_length;
+}
+
+/**
+ * @brief (Private) Record size of a log type.
+ *
+ * @return sizeof(SnapStudent), sizeof(SnapProduct), or 0 for an unknown type.
+ */
+static size_t _wal_record_size(SnapshotType type){
+    if(type == SNAP_STUDENTS) return sizeof(SnapStudent);
+    if(type == SNAP_PRODUCTS) return sizeof(SnapProduct);
+    return 0;
+}
+
+/**
+ * @brief (Private) Flushes a stream and forces its data to disk.
+ *
+ * @return 1 on success, 0 on a write error.
+ */
+static int _wal_sync(FILE* file){
+    if(fflush(file) != 0) return 0;
+#ifdef WAL_HAVE_POSIX
+    if(fsync(fileno(file)) != 0) return 0;
+#endif
+    return 1;
+}
+
+/**
+ * @brief (Private) Forces a renamed file and its directory entry to disk.
+ *
+ * @return 1 on success, 0 if the file cannot be opened or synced.
+ */
+static int _wal_sync_path(const char* path){
+#ifdef WAL_HAVE_POSIX
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return 0;
+    int ok = fsync(fd) == 0;
+    close(fd);
+    /* The rename itself lives in the directory */
+    char* directory = (char*)malloc(strlen(path) + 2);
+    if(directory == NULL) return 0;
+    strcpy(directory, path);
+    char* slash = strrchr(directory, '/');
+    if(slash == NULL) strcpy(directory, ".");
+    else if(slash == directory) slash[1] = '\0';
+    else *slash = '\0';
+    fd = open(directory, O_RDONLY);
+    free(directory);
+    if(fd >= 0){
+        fsync(fd);
+        close(fd);
+    }
+    return ok;
+#else
+    (void)path;
+    return 1;
+#endif
+}
+
+/**
+ * @brief (Private) Cuts the log file back to 'size' bytes and moves to its end.
+ *
+ * @return 1 on success, 0 if the file cannot be truncated.
+ */
+static int _wal_truncate(FILE* file, long size){
+    if(fflush(file) != 0) clearerr(file);
+#ifdef WAL_HAVE_POSIX
+    if(ftruncate(fileno(file), (off_t)size) != 0) return 0;
+#else
+    (void)size;
+    return 0;
+#endif
+    return fseek(file, 0, SEEK_END) == 0;
+}
+
+/**
+ * @brief (Private) Reads a log's header and its valid entries.
+ *
+ * @param file The log, read from the start.
+ * @param type The record type the log must hold.
+ * @param apply Called for each valid entry, or NULL to only validate.
+ * @param context Passed through to 'apply'.
+ * @param valid_end [out] Offset just past the last valid entry.
+ * @param entries [out] Number of valid entries.
+ * @param torn_bytes [out] Bytes after the last valid entry.
+ * @return 1 on success (a torn tail included), 0 if the header does not
+ * match 'type', a read fails or 'apply' fails.
+ */
+static int _wal_scan(FILE* file, SnapshotType type, WalApplyFunc apply, void* context,
+                     long* valid_end, long* entries, long* torn_bytes){
+    *valid_end = 0;
+    *entries = 0;
+    *torn_bytes = 0;
+    WalHeader header;
+    size_t record_size = _wal_record_size(type);
+    if(fseek(file, 0, SEEK_SET) != 0 || fread(&header, sizeof(WalHeader), 1, file) != 1) return 0;
+    if(memcmp(header.magic, WAL_MAGIC, sizeof(header.magic)) != 0 || header.version != WAL_VERSION
+       || header.endian_tag != SNAP_ENDIAN_TAG || header.record_type != (uint32_t)type
+       || header.record_size != record_size){
+        return 0;
+    }
+    long file_size = -1;
+    if(fseek(file, 0, SEEK_END) == 0) file_size = ftell(file);
+    if(file_size < 0 || fseek(file, (long)sizeof(WalHeader), SEEK_SET) != 0) return 0;
+    long offset = (long)sizeof(WalHeader);
+    WalEntry entry;
+    WalRecord record;
+    char* name = NULL;
+    size_t name_capacity = 0;
+    int ok = 1;
+    for(;;){
+        if(fread(&entry, sizeof(WalEntry), 1, file) != 1) break;
+        if(entry.op != WAL_INSERT && entry.op != WAL_REMOVE) break;
+        int has_record = entry.op == WAL_INSERT;
+        size_t name_length = 0;
+        if(has_record){
+            if(fread(&record, record_size, 1, file) != 1) break;
+            name_length = _wal_name_length(type, &record);
+            /* A torn entry can hold any length: never read past the file */
+            long end = offset + (long)(sizeof(WalEntry) + record_size);
+            if((long long)name_length > (long long)(file_size - end)) break;
+            if(name_length + 1 > name_capacity){
+                char* grown = (char*)realloc(name, name_length + 1);
+                if(grown == NULL){
+                    ok = 0;
+                    break;
+                }
+                name = grown;
+                name_capacity = name_length + 1;
+            }
+            if(fread(name, 1, name_length, file) != name_length) break;
+            name[name_length] = '\0';
+        }
+        if(entry.crc != _wal_entry_crc(&entry, has_record ? &record : NULL, record_size, name, name_length)) break;
+        if(apply != NULL && !apply((WalOp)entry.op, entry.id, has_record ? &record : NULL, has_record ? name : NULL, context)){
+            ok = 0;
+            break;
+        }
+        offset += (long)(sizeof(WalEntry) + (has_record ? record_size + name_length : 0));
+        (*entries)++;
+    }
+    free(name);
+    if(!ok || ferror(file)) return 0;
+    *valid_end = offset;
+    *torn_bytes = file_size - offset;
+    return 1;
+}
+
+/**
+ * @brief (Private) Writes a fresh header at the start of an empty log.
+ *
+ * @return 1 on success, 0 on a write error.
+ */
+static int _wal_write_header(ChangeLog* log){
+    WalHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, WAL_MAGIC, sizeof(header.magic));
+    header.version = WAL_VERSION;
+    header.endian_tag = SNAP_ENDIAN_TAG;
+    header.record_type = (uint32_t)log->type;
+    header.record_size = (uint32_t)log->record_size;
+    if(fseek(log->file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, log->file) != 1) return 0;
+    return _wal_sync(log->file);
+}
+
+/**
+ * @brief Opens (or creates) a change log for appending.
+ *
+ * An existing log is validated first. Bytes after its last valid entry
+ * (left by a crash in the middle of a commit) are cut off with a warning.
+ * Replay the log into the containers (wal_replay_*) before logging new
+ * changes.
+ *
+ * @param filename The log file.
+ * @param type SNAP_STUDENTS or SNAP_PRODUCTS: the records the log holds.
+ * @param group_size Entries per automatic commit (e.g. WAL_DEFAULT_GROUP;
+ * 1 = fsync every change, 0 = only when wal_commit is called).
+ * @return The open log, or NULL if the file cannot be opened, is not a
+ * log of this type, or memory fails.
+ */
+ChangeLog* wal_open(const char* filename, SnapshotType type, int group_size){
+    size_t record_size = _wal_record_size(type);
+    if(filename == NULL || record_size == 0 || group_size < 0) return NULL;
+    ChangeLog* log = (ChangeLog*)calloc(1, sizeof(ChangeLog));
+    if(log == NULL) return NULL;
+    log->type = type;
+    log->record_size = record_size;
+    log->group_size = group_size;
+    log->file = fopen(filename, "r+b");
+    if(log->file == NULL) log->file = fopen(filename, "w+b");
+    if(log->file == NULL){
+        fprintf(stderr, "Error: couldn't open change log %s\n", filename);
+        free(log);
+        return NULL;
+    }
+    int ok = fseek(log->file, 0, SEEK_END) == 0;
+    if(ok && ftell(log->file) == 0) ok = _wal_write_header(log);
+    else if(ok){
+        long valid_end, entries, torn_bytes;
+        ok = _wal_scan(log->file, type, NULL, NULL, &valid_end, &entries, &torn_bytes);
+        if(!ok) fprintf(stderr, "Error: %s is not a change log of this record type\n", filename);
+        if(ok && torn_bytes > 0){
+            fprintf(stderr, "Warning: %s: %ld bytes after the last valid entry discarded\n", filename, torn_bytes);
+            ok = _wal_truncate(log->file, valid_end) && _wal_sync(log->file);
+        }
+        log->entries = (unsigned long long)entries;
+    }
+    if(!ok || fseek(log->file, 0, SEEK_END) != 0){
+        fclose(log->file);
+        free(log);
+        return NULL;
+    }
+    return log;
+}
+
+/**
+ * @brief (Private) Appends one entry to the pending group, committing a full group.
+ *
+ * @return 1 on success, 0 if memory or the commit fails (the entry is
+ * still pending after a failed commit).
+ */
+static int _wal_append(ChangeLog* log, WalOp op, int64_t id, const void* record, const char* name, size_t name_length){
+    size_t size = sizeof(WalEntry) + (record != NULL ? log->record_size + name_length : 0);
+    if(log->used + size > log->capacity){
+        size_t capacity = log->capacity > 0 ? log->capacity * 2 : 64 * (sizeof(WalEntry) + log->record_size);
+        while(capacity < log->used + size) capacity *= 2;
+        unsigned char* buffer = (unsigned char*)realloc(log->buffer, capacity);
+        if(buffer == NULL) return 0;
+        log->buffer = buffer;
+        log->capacity = capacity;
+    }
+    WalEntry entry;
+    entry.op = (uint32_t)op;
+    entry.id = id;
+    entry.crc = _wal_entry_crc(&entry, record, log->record_size, name, name_length);
+    memcpy(log->buffer + log->used, &entry, sizeof(WalEntry));
+    if(record != NULL){
+        memcpy(log->buffer + log->used + sizeof(WalEntry), record, log->record_size);
+        memcpy(log->buffer + log->used + sizeof(WalEntry) + log->record_size, name, name_length);
+    }
+    log->used += size;
+    log->pending++;
+    log->entries++;
+    if(log->group_size > 0 && log->pending >= log->group_size) return wal_commit(log);
+    return 1;
+}
+
+/**
+ * @brief Logs the insert (or replacement) of a student.
+ *
+ * Call it next to oa_insert_sorted. The name is stored whole.
+ *
+ * @param log A log of SNAP_STUDENTS.
+ * @param student The inserted student.
+ * @return 1 on success, 0 on invalid arguments or if memory or the
+ * group commit fails.
+ */
+int wal_log_student(ChangeLog* log, const Student* student){
+    if(log == NULL || student == NULL || log->type != SNAP_STUDENTS) return 0;
+    SnapStudent record;
+    memset(&record, 0, sizeof(record));
+    record.id = student->id;
+    record.gpa = student->gpa;
+    size_t name_length = strlen(student->name);
+    if(name_length >= UINT32_MAX) return 0;
+    record.name_length = (uint32_t)name_length;
+    return _wal_append(log, WAL_INSERT, record.id, &record, student->name, name_length);
+}
+
+/**
+ * @brief Logs the insert (or replacement) of a product.
+ *
+ * Call it next to list_insert_sorted. The name is stored whole.
+ *
+ * @param log A log of SNAP_PRODUCTS.
+ * @param product The inserted product.
+ * @return 1 on success, 0 on invalid arguments or if memory or the
+ * group commit fails.
+ */
+int wal_log_product(ChangeLog* log, const Product* product){
+    if(log == NULL || product == NULL || log->type != SNAP_PRODUCTS) return 0;
+    SnapProduct record;
+    memset(&record, 0, sizeof(record));
+    record.id = product->id;
+    record.stock = product->stock;
+    record.price = product->price;
+    record.cost = product->cost;
+    size_t name_length = strlen(product->name);
+    if(name_length >= UINT32_MAX) return 0;
+    record.name_length = (uint32_t)name_length;
+    return _wal_append(log, WAL_INSERT, record.id, &record, product->name, name_length);
+}
+
+/**
+ * @brief Logs the removal of the record with 'id'.
+ *
+ * @param log The log.
+ * @param id The id removed from the container.
+ * @return 1 on success, 0 if memory or the group commit fails.
+ */
+int wal_log_remove(ChangeLog* log, long id){
+    if(log == NULL) return 0;
+    return _wal_append(log, WAL_REMOVE, (int64_t)id, NULL, NULL, 0);
+}
+
+/**
+ * @brief Writes the pending entries and makes them durable (one fsync).
+ *
+ * @param log The log.
+ * @return 1 on success (also with nothing pending), 0 on a write error:
+ * the file is cut back to its last commit and the entries stay pending,
+ * so the commit can be retried.
+ */
+int wal_commit(ChangeLog* log){
+    if(log == NULL) return 0;
+    if(log->pending == 0) return 1;
+    long committed = ftell(log->file);
+    if(committed < 0) return 0;
+    if(fwrite(log->buffer, 1, log->used, log->file) != log->used || !_wal_sync(log->file)){
+        _wal_truncate(log->file, committed);
+        return 0;
+    }
+    log->used = 0;
+    log->pending = 0;
+    log->commits++;
+    return 1;
+}
+
+/**
+ * @brief Commits the pending entries and closes the log.
+ *
+ * @param log The log to close (freed in any case).
+ * @return 1 if the final commit succeeded, 0 otherwise.
+ */
+int wal_close(ChangeLog* log){
+    if(log == NULL) return 0;
+    int ok = wal_commit(log);
+    if(fclose(log->file) != 0) ok = 0;
+    free(log->buffer);
+    free(log);
+    return ok;
+}
+
+/**
+ * @brief (Private) Applies one student entry: remove the id, then insert the new record.
+ */
+static int _wal_apply_student(WalOp op, int64_t id, const void* record, const char* name, void* context){
+    WalReplayTarget* target = (WalReplayTarget*)context;
+    Student key;
+    memset(&key, 0, sizeof(key));
+    key.id = (long)id;
+    Student* previous = (Student*)oa_remove(target->arr, &key);
+    student_free(previous);
+    target->report->applied++;
+    if(op == WAL_REMOVE){
+        target->report->removes++;
+        target->report->missing += previous == NULL;
+        return 1;
+    }
+    target->report->inserts++;
+    target->report->replaced += previous != NULL;
+    SnapStudent copy;
+    memcpy(&copy, record, sizeof(copy));
+    Student* student = student_create((long)copy.id, name, copy.gpa);
+    if(student == NULL || !oa_insert_sorted(target->arr, student)){
+        fprintf(stderr, "Error: couldn't replay the insert of student %ld\n", (long)id);
+        student_free(student);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief (Private) Applies one product entry: remove the id, then insert the new record.
+ */
+static int _wal_apply_product(WalOp op, int64_t id, const void* record, const char* name, void* context){
+    WalReplayTarget* target = (WalReplayTarget*)context;
+    Product key;
+    memset(&key, 0, sizeof(key));
+    key.id = (long)id;
+    Product* previous = (Product*)list_remove(target->list, &key);
+    product_free(previous);
+    target->report->applied++;
+    if(op == WAL_REMOVE){
+        target->report->removes++;
+        target->report->missing += previous == NULL;
+        return 1;
+    }
+    target->report->inserts++;
+    target->report->replaced += previous != NULL;
+    SnapProduct copy;
+    memcpy(&copy, record, sizeof(copy));
+    Product* product = product_create((long)copy.id, name, copy.price, copy.cost, (long)copy.stock);
+    if(product == NULL || !list_insert_sorted(target->list, product)){
+        fprintf(stderr, "Error: couldn't replay the insert of product %ld\n", (long)id);
+        product_free(product);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief (Private) Replays a log file through 'apply'.
+ *
+ * @return 1 on success (a missing file is an empty log), 0 otherwise.
+ */
+static int _wal_replay(const char* filename, SnapshotType type, WalApplyFunc apply, WalReplayTarget* target){
+    memset(target->report, 0, sizeof(WalReplayReport));
+    FILE* file = fopen(filename, "rb");
+    if(file == NULL) return errno == ENOENT;
+    long valid_end, entries, torn_bytes;
+    int ok = _wal_scan(file, type, apply, target, &valid_end, &entries, &torn_bytes);
+    fclose(file);
+    if(!ok){
+        fprintf(stderr, "Error: couldn't replay change log %s\n", filename);
+        return 0;
+    }
+    target->report->torn_bytes = torn_bytes;
+    if(torn_bytes > 0) fprintf(stderr, "Warning: %s: %ld bytes after the last valid entry ignored\n", filename, torn_bytes);
+    return 1;
+}
+
+/**
+ * @brief Applies a student log to an OrderedArray, in log order.
+ *
+ * Meant for startup, after the base data is loaded. An insert replaces
+ * any student with the same id, a remove frees the removed student, so
+ * the array owns its students as csv_load_students hands them out.
+ *
+ * @param filename The log file (a missing file counts as an empty log).
+ * @param arr An OrderedArray of Student* ordered by id, created with student_create
+ * (replaced and removed students are freed with student_free, so not arena records).
+ * @param report [out] Optional. Receives what was replayed.
+ * @return 1 on success, 0 if the file is not a student log, cannot be
+ * read, or an insert fails (entries before it stay applied).
+ */
+int wal_replay_students(const char* filename, OrderedArray* arr, WalReplayReport* report){
+    if(filename == NULL || arr == NULL) return 0;
+    WalReplayReport local;
+    WalReplayTarget target = {arr, NULL, report != NULL ? report : &local};
+    return _wal_replay(filename, SNAP_STUDENTS, _wal_apply_student, &target);
+}
+
+/**
+ * @brief Applies a product log to a LinkedList, in log order.
+ *
+ * @param filename The log file (a missing file counts as an empty log).
+ * @param list A LinkedList of Product* ordered by id, created with product_create
+ * (replaced and removed products are freed with product_free, so not arena records).
+ * @param report [out] Optional. Receives what was replayed.
+ * @return 1 on success, 0 if the file is not a product log, cannot be
+ * read, or an insert fails (entries before it stay applied).
+ */
+int wal_replay_products(const char* filename, LinkedList* list, WalReplayReport* report){
+    if(filename == NULL || list == NULL) return 0;
+    WalReplayReport local;
+    WalReplayTarget target = {NULL, list, report != NULL ? report : &local};
+    return _wal_replay(filename, SNAP_PRODUCTS, _wal_apply_product, &target);
+}
+
+/**
+ * @brief (Private) Writes a float with the fewest digits that read back to the same value.
+ */
+static void _wal_put_float(FILE* out, float value){
+    char text[32];
+    snprintf(text, sizeof(text), "%.6g", value);
+    if(strtof(text, NULL) != value) snprintf(text, sizeof(text), "%.9g", value);
+    fputs(text, out);
+}
+
+/**
+ * @brief (Private) Checks that a name can be a CSV field (no separators, not empty).
+ */
+static int _wal_csv_name_ok(const char* name, long id){
+    if(name[0] != '\0' && strpbrk(name, ",\r\n") == NULL) return 1;
+    fprintf(stderr, "Error: the name of id %ld can't be written as a CSV field\n", id);
+    return 0;
+}
+
+/**
+ * @brief (Private) Opens "<path>.tmp" for a CSV rewrite.
+ *
+ * @param temp_path [out] The temporary path (to pass to _wal_csv_end).
+ * @return The file, or NULL if it cannot be created or memory fails.
+ */
+static FILE* _wal_csv_begin(const char* path, char** temp_path){
+    *temp_path = (char*)malloc(strlen(path) + 5);
+    if(*temp_path == NULL) return NULL;
+    strcpy(*temp_path, path);
+    strcat(*temp_path, ".tmp");
+    FILE* out = fopen(*temp_path, "w");
+    if(out == NULL) free(*temp_path);
+    return out;
+}
+
+/**
+ * @brief (Private) Syncs the temporary CSV and renames it over 'path'.
+ *
+ * @return 1 on success, 0 on any error (the temporary file is removed).
+ */
+static int _wal_csv_end(FILE* out, char* temp_path, const char* path, int ok){
+    if(ok && (ferror(out) || !_wal_sync(out))) ok = 0;
+    if(fclose(out) != 0) ok = 0;
+    if(ok && rename(temp_path, path) != 0) ok = 0;
+    if(!ok) remove(temp_path);
+    free(temp_path);
+    return ok;
+}
+
+/**
+ * @brief (Private) Writes the students as "id,name,gpa" rows, in array order.
+ */
+static int _wal_write_students_csv(const char* path, OrderedArray* arr){
+    char* temp_path;
+    FILE* out = _wal_csv_begin(path, &temp_path);
+    if(out == NULL) return 0;
+    int ok = 1;
+    for(int i = 0; ok && i < arr->counter; i++){
+        Student* student = (Student*)arr->data[i];
+        ok = _wal_csv_name_ok(student->name, student->id);
+        if(!ok) break;
+        fprintf(out, "%ld,%s,", student->id, student->name);
+        _wal_put_float(out, student->gpa);
+        fputc('\n', out);
+    }
+    return _wal_csv_end(out, temp_path, path, ok);
+}
+
+/**
+ * @brief (Private) Writes the products as "id,name,price,cost,stock" rows, in list order.
+ */
+static int _wal_write_products_csv(const char* path, LinkedList* list){
+    char* temp_path;
+    FILE* out = _wal_csv_begin(path, &temp_path);
+    if(out == NULL) return 0;
+    int ok = 1;
+    for(Node* node = list->head; ok && node != NULL; node = node->next){
+        Product* product = (Product*)node->data;
+        ok = _wal_csv_name_ok(product->name, product->id);
+        if(!ok) break;
+        fprintf(out, "%ld,%s,", product->id, product->name);
+        _wal_put_float(out, product->price);
+        fputc(',', out);
+        _wal_put_float(out, product->cost);
+        fprintf(out, ",%ld\n", product->stock);
+    }
+    return _wal_csv_end(out, temp_path, path, ok);
+}
+
+/**
+ * @brief (Private) Empties the log after a compaction (keeps the header).
+ */
+static int _wal_reset(ChangeLog* log){
+    if(!_wal_truncate(log->file, (long)sizeof(WalHeader)) || !_wal_sync(log->file)) return 0;
+    log->entries = 0;
+    return 1;
+}
+
+/**
+ * @brief Rewrites the student base file from the array and empties the log.
+ *
+ * Commits the pending entries, writes the whole array to 'base_path'
+ * (replaced atomically and fsynced), then cuts the log back to its
+ * header. Next startup loads the new base file and replays only the
+ * changes logged after this call.
+ *
+ * @param log A log of SNAP_STUDENTS.
+ * @param arr The array the log was replayed into and kept in step with.
+ * @param base_path The CSV or snapshot file loaded at startup.
+ * @param format WAL_COMPACT_CSV or WAL_COMPACT_SNAPSHOT.
+ * @return 1 on success, 0 on failure (the log is then left as it was,
+ * apart from the commit).
+ */
+int wal_compact_students(ChangeLog* log, OrderedArray* arr, const char* base_path, WalFormat format){
+    if(log == NULL || arr == NULL || base_path == NULL || log->type != SNAP_STUDENTS) return 0;
+    if(!wal_commit(log)) return 0;
+    int written = format == WAL_COMPACT_SNAPSHOT ? snap_write_students(base_path, arr)
+                                                 : _wal_write_students_csv(base_path, arr);
+    if(!written || !_wal_sync_path(base_path)) return 0;
+    return _wal_reset(log);
+}
+
+/**
+ * @brief Rewrites the product base file from the list and empties the log.
+ *
+ * See wal_compact_students.
+ *
+ * @param log A log of SNAP_PRODUCTS.
+ * @param list The list the log was replayed into and kept in step with.
+ * @param base_path The CSV or snapshot file loaded at startup.
+ * @param format WAL_COMPACT_CSV or WAL_COMPACT_SNAPSHOT.
+ * @return 1 on success, 0 on failure.
+ */
+int wal_compact_products(ChangeLog* log, LinkedList* list, const char* base_path, WalFormat format){
+    if(log == NULL || list == NULL || base_path == NULL || log->type != SNAP_PRODUCTS) return 0;
+    if(!wal_commit(log)) return 0;
+    int written = format == WAL_COMPACT_SNAPSHOT ? snap_write_products(base_path, list)
+                                                 : _wal_write_products_csv(base_path, list);
+    if(!written || !_wal_sync_path(base_path)) return 0;
+    return _wal_reset(log);
+}
@@ -0,0 +1,490 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include "concurrentContainers.h"
+
+/*
+ * concurrentContainers.c
+ *
+ * Thread-safe wrappers around OrderedArray and LinkedList. The wrapped
+ * containers are unchanged: every call takes the right lock and forwards
+ * to the ordinary oa_ and list_ functions.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - ConcurrentOA: one reader-writer lock. Any number of finds proceed
+ *   together; an insert/remove waits for them and blocks everyone while
+ *   it shifts the array. Read-mostly workloads scale with the core count
+ *   until the lock word itself (written by every reader) becomes the
+ *   bottleneck. Writes do not scale at all.
+ * - ShardedOA / ShardedList: the id space is cut into contiguous ranges,
+ *   each one a separate keyed container with its own lock. Operations on
+ *   different shards never touch the same lock or data, so writes scale
+ *   as well as reads, and every O(n) shift or walk only covers one shard
+ *   (n / shard_count elements on a uniform key spread). Skewed keys
+ *   concentrate on a few shards and lose most of that benefit.
+ * - Elements are owned by the caller. A pointer returned by a find stays
+ *   valid only while no other thread removes and frees that element.
+ * - Whole-container operations (count) lock the shards one at a time, so
+ *   their result is not an atomic snapshot under concurrent writes.
+ */
+
+
+/**
+ * @brief (Private) Maps a key to its shard: contiguous ranges of 'width' ids from 'min_key'.
+ */
+static int _conc_shard_index(long min_key, unsigned long width, int shard_count, long key){
+    if(key < min_key) return 0;
+    unsigned long offset = (unsigned long)key - (unsigned long)min_key;
+    unsigned long index = offset / width;
+    return index >= (unsigned long)shard_count ? shard_count - 1 : (int)index;
+}
+
+/**
+ * @brief (Private) Allocates the shard array and the lock of every shard.
+ * @return The shards (containers still NULL), or NULL on failure.
+ */
+static ContainerShard* _conc_shards_create(int shard_count){
+    ContainerShard* shards = (ContainerShard*)calloc((size_t)shard_count, sizeof(ContainerShard));
+    if(shards == NULL) return NULL;
+    for(int i = 0; i < shard_count; i++){
+        if(pthread_rwlock_init(&shards[i].lock, NULL) != 0){
+            while(i-- > 0) pthread_rwlock_destroy(&shards[i].lock);
+            free(shards);
+            return NULL;
+        }
+    }
+    return shards;
+}
+
+/**
+ * @brief (Private) Computes the width of each shard's id range, rounded up.
+ */
+static unsigned long _conc_shard_width(long min_key, long max_key, int shard_count){
+    unsigned long span = max_key > min_key ? (unsigned long)max_key - (unsigned long)min_key : 1;
+    unsigned long width = span / (unsigned long)shard_count + (span % (unsigned long)shard_count != 0);
+    return width > 0 ? width : 1;
+}
+
+
+/* --- ConcurrentOA --- */
+
+/**
+ * @brief (Private) Wraps an already created OrderedArray.
+ */
+static ConcurrentOA* _coa_wrap(OrderedArray* arr){
+    if(arr == NULL) return NULL;
+    ConcurrentOA* coa = (ConcurrentOA*)malloc(sizeof(ConcurrentOA));
+    if(coa == NULL){
+        oa_free(arr);
+        return NULL;
+    }
+    if(pthread_rwlock_init(&coa->lock, NULL) != 0){
+        oa_free(arr);
+        free(coa);
+        return NULL;
+    }
+    coa->arr = arr;
+    return coa;
+}
+
+/**
+ * @brief Creates a thread-safe OrderedArray.
+ *
+ * @param capacity Capacity of the wrapped array (fixed, as in oa_create).
+ * @param compare_func The function used to order the elements.
+ * @return A pointer to the new ConcurrentOA, or NULL on failure.
+ */
+ConcurrentOA* coa_create(int capacity, CompareFunc compare_func){
+    return _coa_wrap(oa_create(capacity, compare_func));
+}
+
+/**
+ * @brief Creates a thread-safe OrderedArray in keyed mode (see oa_create_keyed).
+ *
+ * @param capacity Capacity of the wrapped array.
+ * @param key_func Extracts the long key of an element.
+ * @return A pointer to the new ConcurrentOA, or NULL on failure.
+ */
+ConcurrentOA* coa_create_keyed(int capacity, KeyFunc key_func){
+    return _coa_wrap(oa_create_keyed(capacity, key_func));
+}
+
+/**
+ * @brief Frees the wrapper and the array (not the elements).
+ *
+ * No other thread may be using the container.
+ *
+ * @param coa The container to free.
+ */
+void coa_free(ConcurrentOA* coa){
+    if(coa == NULL) return;
+    pthread_rwlock_destroy(&coa->lock);
+    oa_free(coa->arr);
+    free(coa);
+}
+
+/**
+ * @brief Finds an element under the shared (read) lock.
+ *
+ * @param coa The container to search in.
+ * @param data_to_find A "template" element holding the key.
+ * @return The element, or NULL if not found.
+ */
+void* coa_find(ConcurrentOA* coa, void* data_to_find){
+    if(coa == NULL) return NULL;
+    pthread_rwlock_rdlock(&coa->lock);
+    void* found = oa_find_binary(coa->arr, data_to_find);
+    pthread_rwlock_unlock(&coa->lock);
+    return found;
+}
+
+/**
+ * @brief Finds an element by key under the shared lock (keyed mode only).
+ *
+ * @param coa The container to search in.
+ * @param key The key to look up.
+ * @return The element, or NULL if not found or not keyed.
+ */
+void* coa_find_key(ConcurrentOA* coa, long key){
+    if(coa == NULL) return NULL;
+    pthread_rwlock_rdlock(&coa->lock);
+    void* found = oa_find_key(coa->arr, key);
+    pthread_rwlock_unlock(&coa->lock);
+    return found;
+}
+
+/**
+ * @brief Finds a batch of elements under a single acquisition of the shared lock.
+ *
+ * @param coa The container to search in.
+ * @param keys The "template" elements to look up.
+ * @param count Number of keys.
+ * @param results [out] results[i] is the match of keys[i], or NULL.
+ * @return The number of keys found.
+ */
+int coa_find_batch(ConcurrentOA* coa, void** keys, int count, void** results){
+    if(coa == NULL) return 0;
+    pthread_rwlock_rdlock(&coa->lock);
+    int found = oa_find_batch(coa->arr, keys, count, results);
+    pthread_rwlock_unlock(&coa->lock);
+    return found;
+}
+
+/**
+ * @brief Inserts an element under the exclusive (write) lock.
+ *
+ * @param coa The container to insert into.
+ * @param data The element to insert.
+ * @return 1 on success, 0 if duplicate or full.
+ */
+int coa_insert(ConcurrentOA* coa, void* data){
+    if(coa == NULL) return 0;
+    pthread_rwlock_wrlock(&coa->lock);
+    int inserted = oa_insert_sorted(coa->arr, data);
+    pthread_rwlock_unlock(&coa->lock);
+    return inserted;
+}
+
+/**
+ * @brief Inserts a batch under one acquisition of the exclusive lock (see oa_insert_batch).
+ *
+ * @param coa The container to insert into.
+ * @param items The elements to insert (reordered as in oa_insert_batch).
+ * @param count Number of elements.
+ * @return The number of elements inserted.
+ */
+int coa_insert_batch(ConcurrentOA* coa, void** items, int count){
+    if(coa == NULL) return 0;
+    pthread_rwlock_wrlock(&coa->lock);
+    int inserted = oa_insert_batch(coa->arr, items, count);
+    pthread_rwlock_unlock(&coa->lock);
+    return inserted;
+}
+
+/**
+ * @brief Removes an element under the exclusive lock.
+ *
+ * @param coa The container to remove from.
+ * @param data_to_remove A "template" element holding the key.
+ * @return The removed element (to be freed by the caller), or NULL.
+ */
+void* coa_remove(ConcurrentOA* coa, void* data_to_remove){
+    if(coa == NULL) return NULL;
+    pthread_rwlock_wrlock(&coa->lock);
+    void* removed = oa_remove(coa->arr, data_to_remove);
+    pthread_rwlock_unlock(&coa->lock);
+    return removed;
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+int coa_count(ConcurrentOA* coa){
+    if(coa == NULL) return 0;
+    pthread_rwlock_rdlock(&coa->lock);
+    int count = coa->arr->counter;
+    pthread_rwlock_unlock(&coa->lock);
+    return count;
+}
+
+
+/* --- ShardedOA --- */
+
+/**
+ * @brief Creates an OrderedArray sharded by key range.
+ *
+ * Each shard is a growable keyed OrderedArray holding the keys of
+ * one range of [min_key, max_key).
+ *
+ * @param key_func Extracts the long key (id) of an element.
+ * @param min_key Lowest expected key.
+ * @param max_key One past the highest expected key.
+ * @param shard_count Number of shards (CONC_DEFAULT_SHARDS if < 1).
+ * @return A pointer to the new ShardedOA, or NULL on failure.
+ */
+ShardedOA* shoa_create(KeyFunc key_func, long min_key, long max_key, int shard_count){
+    if(key_func == NULL) return NULL;
+    if(shard_count < 1) shard_count = CONC_DEFAULT_SHARDS;
+    ShardedOA* shoa = (ShardedOA*)malloc(sizeof(ShardedOA));
+    if(shoa == NULL) return NULL;
+    shoa->shards = _conc_shards_create(shard_count);
+    if(shoa->shards == NULL){
+        free(shoa);
+        return NULL;
+    }
+    shoa->shard_count = shard_count;
+    shoa->min_key = min_key;
+    shoa->width = _conc_shard_width(min_key, max_key, shard_count);
+    shoa->key_of = key_func;
+    for(int i = 0; i < shard_count; i++){
+        OrderedArray* arr = oa_create_keyed(16, key_func);
+        shoa->shards[i].container = arr;
+        if(arr == NULL){
+            shoa_free(shoa);
+            return NULL;
+        }
+        oa_set_growth(arr, 1, 0.25f);
+    }
+    return shoa;
+}
+
+/**
+ * @brief Frees every shard (not the elements). No other thread may be using it.
+ */
+void shoa_free(ShardedOA* shoa){
+    if(shoa == NULL) return;
+    for(int i = 0; i < shoa->shard_count; i++){
+        pthread_rwlock_destroy(&shoa->shards[i].lock);
+        oa_free((OrderedArray*)shoa->shards[i].container);
+    }
+    free(shoa->shards);
+    free(shoa);
+}
+
+/**
+ * @brief Returns the index of the shard that holds 'key'.
+ */
+int shoa_shard_of(ShardedOA* shoa, long key){
+    return _conc_shard_index(shoa->min_key, shoa->width, shoa->shard_count, key);
+}
+
+/**
+ * @brief Finds an element by key, locking only its shard for reading.
+ *
+ * @param shoa The container to search in.
+ * @param key The key to look up.
+ * @return The element, or NULL if not found.
+ */
+void* shoa_find_key(ShardedOA* shoa, long key){
+    if(shoa == NULL) return NULL;
+    ContainerShard* shard = &shoa->shards[shoa_shard_of(shoa, key)];
+    pthread_rwlock_rdlock(&shard->lock);
+    void* found = oa_find_key((OrderedArray*)shard->container, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return found;
+}
+
+/**
+ * @brief Finds an element from a "template" element holding its key.
+ */
+void* shoa_find(ShardedOA* shoa, void* data_to_find){
+    if(shoa == NULL || data_to_find == NULL) return NULL;
+    return shoa_find_key(shoa, shoa->key_of(data_to_find));
+}
+
+/**
+ * @brief Inserts an element, locking only its shard for writing.
+ *
+ * @param shoa The container to insert into.
+ * @param data The element to insert.
+ * @return 1 on success, 0 if duplicate or out of memory.
+ */
+int shoa_insert(ShardedOA* shoa, void* data){
+    if(shoa == NULL || data == NULL) return 0;
+    ContainerShard* shard = &shoa->shards[shoa_shard_of(shoa, shoa->key_of(data))];
+    pthread_rwlock_wrlock(&shard->lock);
+    int inserted = oa_insert_sorted((OrderedArray*)shard->container, data);
+    pthread_rwlock_unlock(&shard->lock);
+    return inserted;
+}
+
+/**
+ * @brief Removes an element, locking only its shard for writing.
+ *
+ * @param shoa The container to remove from.
+ * @param data_to_remove A "template" element holding the key.
+ * @return The removed element (to be freed by the caller), or NULL.
+ */
+void* shoa_remove(ShardedOA* shoa, void* data_to_remove){
+    if(shoa == NULL || data_to_remove == NULL) return NULL;
+    ContainerShard* shard = &shoa->shards[shoa_shard_of(shoa, shoa->key_of(data_to_remove))];
+    pthread_rwlock_wrlock(&shard->lock);
+    void* removed = oa_remove((OrderedArray*)shard->container, data_to_remove);
+    pthread_rwlock_unlock(&shard->lock);
+    return removed;
+}
+
+/**
+ * @brief Returns the number of elements over all shards.
+ */
+int shoa_count(ShardedOA* shoa){
+    if(shoa == NULL) return 0;
+    int count = 0;
+    for(int i = 0; i < shoa->shard_count; i++){
+        pthread_rwlock_rdlock(&shoa->shards[i].lock);
+        count += ((OrderedArray*)shoa->shards[i].container)->counter;
+        pthread_rwlock_unlock(&shoa->shards[i].lock);
+    }
+    return count;
+}
+
+
+/* --- ShardedList --- */
+
+/**
+ * @brief Creates a LinkedList sharded by key range.
+ *
+ * Each shard is a keyed list with its own node pool, so inserts on
+ * different shards do not even share the allocator.
+ *
+ * @param key_func Extracts the long key (id) of an element.
+ * @param min_key Lowest expected key.
+ * @param max_key One past the highest expected key.
+ * @param shard_count Number of shards (CONC_DEFAULT_SHARDS if < 1).
+ * @return A pointer to the new ShardedList, or NULL on failure.
+ */
+ShardedList* shlist_create(KeyFunc key_func, long min_key, long max_key, int shard_count){
+    if(key_func == NULL) return NULL;
+    if(shard_count < 1) shard_count = CONC_DEFAULT_SHARDS;
+    ShardedList* shlist = (ShardedList*)malloc(sizeof(ShardedList));
+    if(shlist == NULL) return NULL;
+    shlist->shards = _conc_shards_create(shard_count);
+    if(shlist->shards == NULL){
+        free(shlist);
+        return NULL;
+    }
+    shlist->shard_count = shard_count;
+    shlist->min_key = min_key;
+    shlist->width = _conc_shard_width(min_key, max_key, shard_count);
+    shlist->key_of = key_func;
+    for(int i = 0; i < shard_count; i++){
+        shlist->shards[i].container = list_create_keyed(key_func, LIST_DEFAULT_SLAB_SIZE);
+        if(shlist->shards[i].container == NULL){
+            shlist_free(shlist);
+            return NULL;
+        }
+    }
+    return shlist;
+}
+
+/**
+ * @brief Frees every shard (not the elements). No other thread may be using it.
+ */
+void shlist_free(ShardedList* shlist){
+    if(shlist == NULL) return;
+    for(int i = 0; i < shlist->shard_count; i++){
+        pthread_rwlock_destroy(&shlist->shards[i].lock);
+        list_free((LinkedList*)shlist->shards[i].container);
+    }
+    free(shlist->shards);
+    free(shlist);
+}
+
+/**
+ * @brief Returns the index of the shard that holds 'key'.
+ */
+int shlist_shard_of(ShardedList* shlist, long key){
+    return _conc_shard_index(shlist->min_key, shlist->width, shlist->shard_count, key);
+}
+
+/**
+ * @brief Finds an element by key, locking only its shard for reading.
+ *
+ * @param shlist The container to search in.
+ * @param key The key to look up.
+ * @return The element, or NULL if not found.
+ */
+void* shlist_find_key(ShardedList* shlist, long key){
+    if(shlist == NULL) return NULL;
+    ContainerShard* shard = &shlist->shards[shlist_shard_of(shlist, key)];
+    pthread_rwlock_rdlock(&shard->lock);
+    void* found = list_find_key((LinkedList*)shard->container, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return found;
+}
+
+/**
+ * @brief Finds an element from a "template" element holding its key.
+ */
+void* shlist_find(ShardedList* shlist, void* data_to_find){
+    if(shlist == NULL || data_to_find == NULL) return NULL;
+    return shlist_find_key(shlist, shlist->key_of(data_to_find));
+}
+
+/**
+ * @brief Inserts an element, locking only its shard for writing.
+ *
+ * Like list_insert_sorted, duplicate keys are allowed.
+ *
+ * @param shlist The container to insert into.
+ * @param data The element to insert.
+ * @return 1 on success, 0 if out of memory.
+ */
+int shlist_insert(ShardedList* shlist, void* data){
+    if(shlist == NULL || data == NULL) return 0;
+    ContainerShard* shard = &shlist->shards[shlist_shard_of(shlist, shlist->key_of(data))];
+    pthread_rwlock_wrlock(&shard->lock);
+    int inserted = list_insert_sorted((LinkedList*)shard->container, data);
+    pthread_rwlock_unlock(&shard->lock);
+    return inserted;
+}
+
+/**
+ * @brief Removes an element, locking only its shard for writing.
+ *
+ * @param shlist The container to remove from.
+ * @param data_to_remove A "template" element holding the key.
+ * @return The removed element (to be freed by the caller), or NULL.
+ */
+void* shlist_remove(ShardedList* shlist, void* data_to_remove){
+    if(shlist == NULL || data_to_remove == NULL) return NULL;
+    ContainerShard* shard = &shlist->shards[shlist_shard_of(shlist, shlist->key_of(data_to_remove))];
+    pthread_rwlock_wrlock(&shard->lock);
+    void* removed = list_remove((LinkedList*)shard->container, data_to_remove);
+    pthread_rwlock_unlock(&shard->lock);
+    return removed;
+}
+
+/**
+ * @brief Returns the number of elements over all shards.
+ */
+int shlist_count(ShardedList* shlist){
+    if(shlist == NULL) return 0;
+    int count = 0;
+    for(int i = 0; i < shlist->shard_count; i++){
+        pthread_rwlock_rdlock(&shlist->shards[i].lock);
+        count += ((LinkedList*)shlist->shards[i].container)->counter;
+        pthread_rwlock_unlock(&shlist->shards[i].lock);
+    }
+    return count;
+}
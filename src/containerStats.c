@@ -0,0 +1,230 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "containerStats.h"
+
+/*
+ * containerStats.c
+ *
+ * Cost counters and latency histograms for the containers. orderedArray.c
+ * and linkedList.c update them through the CS_* hooks of containerStats.h
+ * when the project is built with -DTRADEOFFS_STATS; oa_stats/list_stats
+ * return a container's ContainerStats (NULL in normal builds).
+ *
+ * TRADE-OFF ANALYSIS:
+ * - RECORD: O(1) - a histogram bucket is found with one bit scan. Every
+ *           update is a relaxed atomic add, so threads reading one
+ *           container under a shared lock can all record into its stats.
+ * - QUERY:  O(buckets) - cs_percentile and cs_dump_json walk the histogram.
+ * - MEMORY: About 10 KB per instrumented container (CS_OP_COUNT histograms
+ *           of CS_HIST_BUCKETS counters). Normal builds pay nothing: the
+ *           hooks compile away and the containers carry no stats pointer.
+ */
+
+
+/**
+ * @brief (Private) Histogram bucket of a latency.
+ */
+static int _cs_bucket_of(unsigned long long ns){
+    if(ns < CS_HIST_SUB) return (int)ns;
+    int magnitude = 63;
+#if defined(__GNUC__)
+    magnitude -= __builtin_clzll(ns);
+#else
+    while(!(ns >> magnitude)) magnitude--;
+#endif
+    if(magnitude > CS_HIST_MAX_MAGNITUDE) return CS_HIST_BUCKETS - 1;
+    int sub = (int)(ns >> (magnitude - CS_HIST_SUB_BITS)) & (CS_HIST_SUB - 1);
+    return CS_HIST_SUB + (magnitude - CS_HIST_SUB_BITS) * CS_HIST_SUB + sub;
+}
+
+/**
+ * @brief (Private) Largest latency that falls in 'bucket'.
+ */
+static unsigned long long _cs_bucket_high(int bucket){
+    if(bucket < CS_HIST_SUB) return (unsigned long long)bucket;
+    int magnitude = CS_HIST_SUB_BITS + (bucket - CS_HIST_SUB) / CS_HIST_SUB;
+    unsigned long long sub = (unsigned long long)((bucket - CS_HIST_SUB) % CS_HIST_SUB);
+    unsigned long long width = 1ULL << (magnitude - CS_HIST_SUB_BITS);
+    return (CS_HIST_SUB + sub) * width + width - 1;
+}
+
+/*All zeros: what cs_reset copies from*/
+static ContainerStats _cs_zero;
+
+/**
+ * @brief (Private) Copies one counter (relaxed atomic load and store).
+ */
+static void _cs_move(atomic_ullong* to, const atomic_ullong* from){
+    atomic_store_explicit(to, atomic_load_explicit((atomic_ullong*)from, memory_order_relaxed), memory_order_relaxed);
+}
+
+/**
+ * @brief (Private) Copies 'from' into 'to' one counter at a time.
+ *
+ * @param keep_bytes 1 to leave to->bytes_in_use as it is.
+ */
+static void _cs_copy(ContainerStats* to, const ContainerStats* from, int keep_bytes){
+    _cs_move(&to->comparisons, &from->comparisons);
+    _cs_move(&to->shifts, &from->shifts);
+    _cs_move(&to->hops, &from->hops);
+    _cs_move(&to->allocations, &from->allocations);
+    _cs_move(&to->frees, &from->frees);
+    if(!keep_bytes){
+        long long bytes = atomic_load_explicit((atomic_llong*)&from->bytes_in_use, memory_order_relaxed);
+        atomic_store_explicit(&to->bytes_in_use, bytes, memory_order_relaxed);
+    }
+    for(int op = 0; op < CS_OP_COUNT; op++){
+        _cs_move(&to->latency[op].count, &from->latency[op].count);
+        _cs_move(&to->latency[op].total_ns, &from->latency[op].total_ns);
+        _cs_move(&to->latency[op].max_ns, &from->latency[op].max_ns);
+        for(int i = 0; i < CS_HIST_BUCKETS; i++) _cs_move(&to->latency[op].buckets[i], &from->latency[op].buckets[i]);
+    }
+}
+
+/**
+ * @brief Allocates a zeroed ContainerStats.
+ *
+ * @return A pointer to the new stats, or NULL if memory fails.
+ */
+ContainerStats* cs_create(void){
+    return (ContainerStats*)calloc(1, sizeof(ContainerStats));
+}
+
+/**
+ * @brief Frees a ContainerStats.
+ */
+void cs_free(ContainerStats* stats){
+    free(stats);
+}
+
+/**
+ * @brief Zeroes every counter and histogram.
+ *
+ * bytes_in_use is a gauge of the container's current memory, not a
+ * running total, so it is kept.
+ *
+ * @param stats The stats to reset.
+ */
+void cs_reset(ContainerStats* stats){
+    if(stats == NULL) return;
+    _cs_copy(stats, &_cs_zero, 1);
+}
+
+/**
+ * @brief Copies the current values, e.g. to diff them after a workload.
+ *
+ * Safe while other threads record; the copy is then exact per field but
+ * not across fields.
+ *
+ * @param stats The stats to copy.
+ * @param out [out] Receives the copy (zeroed if 'stats' is NULL).
+ */
+void cs_snapshot(const ContainerStats* stats, ContainerStats* out){
+    if(out == NULL) return;
+    _cs_copy(out, stats != NULL ? stats : &_cs_zero, 0);
+}
+
+/**
+ * @brief Monotonic clock in nanoseconds, used to time operations.
+ */
+unsigned long long cs_now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * @brief Adds one operation latency to the histogram of 'op'.
+ *
+ * @param stats The stats to update (NULL is ignored).
+ * @param op The operation that was timed.
+ * @param ns Its latency in nanoseconds.
+ */
+void cs_record_latency(ContainerStats* stats, ContainerOp op, unsigned long long ns){
+    if(stats == NULL || op < 0 || op >= CS_OP_COUNT) return;
+    LatencyHistogram* histogram = &stats->latency[op];
+    atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->total_ns, ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->buckets[_cs_bucket_of(ns)], 1, memory_order_relaxed);
+    unsigned long long max = atomic_load_explicit(&histogram->max_ns, memory_order_relaxed);
+    while(ns > max && !atomic_compare_exchange_weak_explicit(&histogram->max_ns, &max, ns,
+                                                             memory_order_relaxed, memory_order_relaxed));
+}
+
+/**
+ * @brief Estimates a latency percentile from the histogram.
+ *
+ * @param histogram The histogram to query.
+ * @param percentile Between 0 and 100 (e.g. 99.9).
+ * @return The upper edge of the bucket holding that percentile (never
+ * above the largest recorded latency), or 0 if nothing was recorded.
+ */
+unsigned long long cs_percentile(const LatencyHistogram* histogram, double percentile){
+    if(histogram == NULL || histogram->count == 0) return 0;
+    if(percentile < 0.0) percentile = 0.0;
+    if(percentile > 100.0) percentile = 100.0;
+    unsigned long long rank = (unsigned long long)(percentile / 100.0 * (double)histogram->count + 0.5);
+    if(rank == 0) rank = 1;
+    unsigned long long seen = 0;
+    for(int i = 0; i < CS_HIST_BUCKETS; i++){
+        seen += histogram->buckets[i];
+        if(seen >= rank){
+            unsigned long long high = _cs_bucket_high(i);
+            return high < histogram->max_ns ? high : histogram->max_ns;
+        }
+    }
+    return histogram->max_ns;
+}
+
+/**
+ * @brief Returns the JSON name of an operation ("find", "insert", ...).
+ */
+const char* cs_op_name(ContainerOp op){
+    switch(op){
+        case CS_OP_FIND: return "find";
+        case CS_OP_INSERT: return "insert";
+        case CS_OP_REMOVE: return "remove";
+        case CS_OP_BATCH: return "batch";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Writes the stats as one JSON object.
+ *
+ * Counters are written as numbers. Each operation gets its count, mean,
+ * p50/p90/p99/max latencies and its non-empty buckets as
+ * [upper edge ns, count] pairs.
+ *
+ * @param stats The stats to dump.
+ * @param name Label stored in the "container" field.
+ * @param out The stream to write to.
+ * @return 1 on success, 0 on invalid arguments or a write error.
+ */
+int cs_dump_json(const ContainerStats* stats, const char* name, FILE* out){
+    if(stats == NULL || out == NULL) return 0;
+    fprintf(out, "{\"container\":\"%s\",\"comparisons\":%llu,\"shifts\":%llu,\"hops\":%llu,"
+                 "\"allocations\":%llu,\"frees\":%llu,\"bytes_in_use\":%lld,\"latency\":{",
+            name != NULL ? name : "", stats->comparisons, stats->shifts, stats->hops,
+            stats->allocations, stats->frees, stats->bytes_in_use);
+    for(int op = 0; op < CS_OP_COUNT; op++){
+        const LatencyHistogram* histogram = &stats->latency[op];
+        double mean = histogram->count > 0 ? (double)histogram->total_ns / (double)histogram->count : 0.0;
+        fprintf(out, "%s\"%s\":{\"count\":%llu,\"mean_ns\":%.1f,\"p50_ns\":%llu,\"p90_ns\":%llu,"
+                     "\"p99_ns\":%llu,\"max_ns\":%llu,\"buckets\":[",
+                op > 0 ? "," : "", cs_op_name((ContainerOp)op), histogram->count, mean,
+                cs_percentile(histogram, 50.0), cs_percentile(histogram, 90.0),
+                cs_percentile(histogram, 99.0), histogram->max_ns);
+        int first = 1;
+        for(int i = 0; i < CS_HIST_BUCKETS; i++){
+            if(histogram->buckets[i] == 0) continue;
+            fprintf(out, "%s[%llu,%llu]", first ? "" : ",", _cs_bucket_high(i), histogram->buckets[i]);
+            first = 0;
+        }
+        fprintf(out, "]}");
+    }
+    fprintf(out, "}}\n");
+    return !ferror(out);
+}
@@ -0,0 +1,444 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include "csvLoader.h"
+#include "student.h"
+#include "product.h"
+#include "recordArena.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CSV_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * csvLoader.c
+ *
+ * Bulk CSV ingestion for the sample data files. The whole file is
+ * memory-mapped (or, where mmap is not available, read with one large
+ * fread), so there is no per-line read call and no line length limit.
+ * Rows are split in place with a hand-written tokenizer and the numbers
+ * are parsed directly from the mapped bytes, without sscanf and without
+ * copying the line. Malformed rows are skipped and reported with their
+ * line number.
+ *
+ * The loaders return every record in one array, ready for a bulk insert
+ * (oa_insert_batch / list_insert_batch). csv_load_students and
+ * csv_load_products make each record its own heap object, freed one by
+ * one (student_free / product_free); csv_load_students_in and
+ * csv_load_products_in carve them out of a RecordArena instead, with
+ * interned names, and ra_free releases them all at once.
+ */
+
+/*Maximum fields split per row (more means the row is malformed)*/
+#define CSV_MAX_FIELDS 8
+/*Malformed rows printed individually before only counting them*/
+#define CSV_MAX_REPORTED 20
+/*Names shorter than this are copied on the stack; longer ones (any length is accepted) are malloc'd*/
+#define CSV_NAME_BUFFER 128
+
+typedef struct{
+    const char* data;
+    size_t size;
+    int mapped;
+}CsvFile;
+
+/*A field is a [start, end) slice of the file, never NUL-terminated*/
+typedef struct{
+    const char* start;
+    const char* end;
+}CsvField;
+
+/*Builds a record from a row, in 'arena' if not NULL. Returns NULL and sets 'reason' on bad input (reason stays NULL if memory fails)*/
+typedef void* (*CsvRowFunc)(const CsvField* fields, RecordArena* arena, const char** reason);
+
+
+/**
+ * @brief (Private) Maps the file read-only, or reads it into one buffer.
+ *
+ * @return 1 on success, 0 if the file cannot be opened or read.
+ */
+static int _csv_open(const char* filename, CsvFile* file){
+    file->data = NULL;
+    file->size = 0;
+    file->mapped = 0;
+#ifdef CSV_HAVE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return 0;
+    struct stat info;
+    /* Empty files and pipes go through the buffered path below */
+    if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0){
+        void* map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED){
+            posix_madvise(map, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+            close(fd);
+            file->data = (const char*)map;
+            file->size = (size_t)info.st_size;
+            file->mapped = 1;
+            return 1;
+        }
+    }
+    close(fd);
+#endif
+    FILE* stream = fopen(filename, "rb");
+    if(stream == NULL) return 0;
+    size_t capacity = 1 << 20;
+    size_t used = 0;
+    char* buffer = (char*)malloc(capacity);
+    while(buffer != NULL){
+        used += fread(buffer + used, 1, capacity - used, stream);
+        if(used < capacity) break;
+        char* bigger = (char*)realloc(buffer, capacity * 2);
+        if(bigger == NULL){
+            free(buffer);
+            buffer = NULL;
+            break;
+        }
+        buffer = bigger;
+        capacity *= 2;
+    }
+    int failed = buffer == NULL || ferror(stream);
+    fclose(stream);
+    if(failed){
+        free(buffer);
+        return 0;
+    }
+    file->data = buffer;
+    file->size = used;
+    return 1;
+}
+
+static void _csv_close(CsvFile* file){
+#ifdef CSV_HAVE_MMAP
+    if(file->mapped){
+        munmap((void*)file->data, file->size);
+        return;
+    }
+#endif
+    free((void*)file->data);
+}
+
+static int _csv_is_space(char c){
+    return c == ' ' || c == '\t';
+}
+
+static int _csv_is_digit(char c){
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief (Private) Splits [line, end) on commas, trimming blanks around each field.
+ *
+ * @return The number of fields, or CSV_MAX_FIELDS + 1 if there are more.
+ */
+static int _csv_split(const char* line, const char* end, CsvField* fields){
+    int count = 0;
+    const char* p = line;
+    while(1){
+        if(count == CSV_MAX_FIELDS) return CSV_MAX_FIELDS + 1;
+        const char* comma = (const char*)memchr(p, ',', (size_t)(end - p));
+        const char* field_end = comma != NULL ? comma : end;
+        const char* start = p;
+        while(start < field_end && _csv_is_space(*start)) start++;
+        while(field_end > start && _csv_is_space(field_end[-1])) field_end--;
+        fields[count].start = start;
+        fields[count].end = field_end;
+        count++;
+        if(comma == NULL) return count;
+        p = comma + 1;
+    }
+}
+
+/**
+ * @brief (Private) Parses a whole field as a base-10 long.
+ *
+ * @return 1 on success, 0 if the field is empty, has stray characters or overflows.
+ */
+static int _csv_parse_long(const CsvField* field, long* out){
+    const char* p = field->start;
+    int negative = 0;
+    if(p < field->end && (*p == '-' || *p == '+')){
+        negative = *p == '-';
+        p++;
+    }
+    if(p == field->end) return 0;
+    unsigned long limit = negative ? (unsigned long)LONG_MAX + 1UL : (unsigned long)LONG_MAX;
+    unsigned long value = 0;
+    for(; p < field->end; p++){
+        if(!_csv_is_digit(*p)) return 0;
+        unsigned long digit = (unsigned long)(*p - '0');
+        if(value > (limit - digit) / 10) return 0;
+        value = value * 10 + digit;
+    }
+    *out = negative ? (long)(0UL - value) : (long)value;
+    return 1;
+}
+
+/**
+ * @brief (Private) Parses a whole field as a decimal number ("12", "-3.5", "1e3").
+ *
+ * @return 1 on success, 0 if the field is empty, has stray characters or
+ * does not fit in a float.
+ */
+static int _csv_parse_float(const CsvField* field, float* out){
+    static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                   1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    const char* p = field->start;
+    const char* end = field->end;
+    int negative = 0;
+    if(p < end && (*p == '-' || *p == '+')){
+        negative = *p == '-';
+        p++;
+    }
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    for(; p < end && _csv_is_digit(*p); p++, digits++){
+        if(mantissa < 100000000000000000ULL) mantissa = mantissa * 10 + (unsigned)(*p - '0');
+        else exponent++;
+    }
+    if(p < end && *p == '.'){
+        for(p++; p < end && _csv_is_digit(*p); p++, digits++){
+            if(mantissa < 100000000000000000ULL){
+                mantissa = mantissa * 10 + (unsigned)(*p - '0');
+                exponent--;
+            }
+        }
+    }
+    if(digits == 0) return 0;
+    if(p < end && (*p == 'e' || *p == 'E')){
+        int exponent_negative = 0;
+        int value = 0;
+        p++;
+        if(p < end && (*p == '-' || *p == '+')){
+            exponent_negative = *p == '-';
+            p++;
+        }
+        if(p == end) return 0;
+        for(; p < end && _csv_is_digit(*p); p++){
+            if(value < 10000) value = value * 10 + (*p - '0');
+        }
+        exponent += exponent_negative ? -value : value;
+    }
+    if(p != end) return 0;
+    double result = (double)mantissa;
+    while(exponent > 0){
+        int step = exponent > 18 ? 18 : exponent;
+        result *= POW10[step];
+        exponent -= step;
+    }
+    while(exponent < 0 && result != 0.0){
+        int step = -exponent > 18 ? 18 : -exponent;
+        result /= POW10[step];
+        exponent += step;
+    }
+    if(result > FLT_MAX) return 0;
+    *out = (float)(negative ? -result : result);
+    return 1;
+}
+
+/**
+ * @brief (Private) Copies a non-empty name field into a NUL-terminated string.
+ *
+ * Uses 'buffer' (CSV_NAME_BUFFER bytes) when the name fits, so only
+ * unusually long names cost a malloc.
+ *
+ * @return The name ('buffer' or a malloc'd copy to free), or NULL if memory fails.
+ */
+static char* _csv_copy_name(const CsvField* field, char* buffer){
+    size_t length = (size_t)(field->end - field->start);
+    char* name = length < CSV_NAME_BUFFER ? buffer : (char*)malloc(length + 1);
+    if(name == NULL) return NULL;
+    memcpy(name, field->start, length);
+    name[length] = '\0';
+    return name;
+}
+
+/*Row layout: id,name,gpa*/
+static void* _csv_make_student(const CsvField* fields, RecordArena* arena, const char** reason){
+    long id;
+    float gpa;
+    if(!_csv_parse_long(&fields[0], &id)) *reason = "invalid id";
+    else if(fields[1].start == fields[1].end) *reason = "empty name";
+    else if(!_csv_parse_float(&fields[2], &gpa)) *reason = "invalid gpa";
+    else{
+        char buffer[CSV_NAME_BUFFER];
+        char* name = _csv_copy_name(&fields[1], buffer);
+        if(name == NULL) return NULL;
+        Student* student = arena != NULL ? student_create_in(arena, id, name, gpa) : student_create(id, name, gpa);
+        if(name != buffer) free(name);
+        return student;
+    }
+    return NULL;
+}
+
+/*Row layout: id,name,price,cost,stock*/
+static void* _csv_make_product(const CsvField* fields, RecordArena* arena, const char** reason){
+    long id, stock;
+    float price, cost;
+    if(!_csv_parse_long(&fields[0], &id)) *reason = "invalid id";
+    else if(fields[1].start == fields[1].end) *reason = "empty name";
+    else if(!_csv_parse_float(&fields[2], &price)) *reason = "invalid price";
+    else if(!_csv_parse_float(&fields[3], &cost)) *reason = "invalid cost";
+    else if(!_csv_parse_long(&fields[4], &stock)) *reason = "invalid stock";
+    else{
+        char buffer[CSV_NAME_BUFFER];
+        char* name = _csv_copy_name(&fields[1], buffer);
+        if(name == NULL) return NULL;
+        Product* product = arena != NULL ? product_create_in(arena, id, name, price, cost, stock)
+                                         : product_create(id, name, price, cost, stock);
+        if(name != buffer) free(name);
+        return product;
+    }
+    return NULL;
+}
+
+/**
+ * @brief (Private) Loads every row of a CSV file through 'make_row'.
+ *
+ * Blank lines are ignored, and so is a first line whose first field is
+ * not a number (a header). CRLF line endings are accepted.
+ *
+ * @return A malloc'd array of records (never NULL on success, even if
+ * empty), or NULL if the file cannot be read or memory fails.
+ */
+static void** _csv_load(const char* filename, int expected_fields, CsvRowFunc make_row, RecordArena* arena,
+                        int* count, CsvReport* report){
+    CsvReport local;
+    if(report == NULL) report = &local;
+    memset(report, 0, sizeof(CsvReport));
+    *count = 0;
+    CsvFile file;
+    if(!_csv_open(filename, &file)){
+        printf("Error: Couldn't open the file %s\n", filename);
+        return NULL;
+    }
+    report->bytes = (long long)file.size;
+    report->mapped = file.mapped;
+    const char* end = file.data + file.size;
+
+    /* Size the result once: there cannot be more rows than lines */
+    size_t lines = 1;
+    for(const char* p = file.data; p < end; p++){
+        p = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if(p == NULL) break;
+        lines++;
+    }
+    if(lines > INT_MAX){
+        printf("Error: %s has too many rows\n", filename);
+        _csv_close(&file);
+        return NULL;
+    }
+    void** records = (void**)malloc(lines * sizeof(void*));
+    if(records == NULL){
+        printf("Memory error loading %s\n", filename);
+        _csv_close(&file);
+        return NULL;
+    }
+
+    CsvField fields[CSV_MAX_FIELDS];
+    const char* line = file.data;
+    while(line < end){
+        const char* newline = (const char*)memchr(line, '\n', (size_t)(end - line));
+        const char* line_end = newline != NULL ? newline : end;
+        const char* next = newline != NULL ? newline + 1 : end;
+        if(line_end > line && line_end[-1] == '\r') line_end--;
+        report->lines++;
+
+        const char* first = line;
+        while(first < line_end && _csv_is_space(*first)) first++;
+        int header = report->lines == 1 && first < line_end && !_csv_is_digit(*first)
+                     && *first != '-' && *first != '+';
+        if(first < line_end && !header){
+            const char* reason = NULL;
+            void* record = NULL;
+            if(_csv_split(line, line_end, fields) != expected_fields) reason = "wrong number of fields";
+            else record = make_row(fields, arena, &reason);
+            if(record != NULL) records[(*count)++] = record;
+            else{
+                if(reason == NULL) reason = "out of memory";
+                if(report->malformed < CSV_MAX_REPORTED){
+                    printf("%s:%ld: malformed row skipped (%s)\n", filename, report->lines, reason);
+                }
+                report->malformed++;
+            }
+        }
+        line = next;
+    }
+    if(report->malformed > CSV_MAX_REPORTED){
+        printf("%s: %ld more malformed rows skipped\n", filename, report->malformed - CSV_MAX_REPORTED);
+    }
+    report->loaded = *count;
+    _csv_close(&file);
+    return records;
+}
+
+/**
+ * @brief Loads every student (id,name,gpa) of a CSV file.
+ *
+ * @param filename The file to load.
+ * @param count [out] Number of students returned.
+ * @param report [out] Optional statistics about the load. May be NULL.
+ * @return A malloc'd array of 'count' heap-allocated Students (free the
+ * array with free and each Student with student_free), or NULL if the
+ * file cannot be read or memory fails.
+ */
+void** csv_load_students(const char* filename, int* count, CsvReport* report){
+    return _csv_load(filename, 3, _csv_make_student, NULL, count, report);
+}
+
+/**
+ * @brief Loads every product (id,name,price,cost,stock) of a CSV file.
+ *
+ * @param filename The file to load.
+ * @param count [out] Number of products returned.
+ * @param report [out] Optional statistics about the load. May be NULL.
+ * @return A malloc'd array of 'count' heap-allocated Products (free the
+ * array with free and each Product with product_free), or NULL if the
+ * file cannot be read or memory fails.
+ */
+void** csv_load_products(const char* filename, int* count, CsvReport* report){
+    return _csv_load(filename, 5, _csv_make_product, NULL, count, report);
+}
+
+/**
+ * @brief Loads every student (id,name,gpa) of a CSV file into a RecordArena.
+ *
+ * Same rows as csv_load_students, but each Student is carved out of
+ * 'arena' (no malloc per row) and names are interned there. Rows that are
+ * skipped or later rejected by the container need no cleanup.
+ *
+ * @param arena The arena that will own the students.
+ * @param filename The file to load.
+ * @param count [out] Number of students returned.
+ * @param report [out] Optional statistics about the load. May be NULL.
+ * @return A malloc'd array of 'count' Students (free the array with free;
+ * the Students go with ra_free), or NULL if the file cannot be read or
+ * memory fails.
+ */
+void** csv_load_students_in(RecordArena* arena, const char* filename, int* count, CsvReport* report){
+    if(arena == NULL) return NULL;
+    return _csv_load(filename, 3, _csv_make_student, arena, count, report);
+}
+
+/**
+ * @brief Loads every product (id,name,price,cost,stock) of a CSV file into a RecordArena.
+ *
+ * @param arena The arena that will own the products.
+ * @param filename The file to load.
+ * @param count [out] Number of products returned.
+ * @param report [out] Optional statistics about the load. May be NULL.
+ * @return A malloc'd array of 'count' Products (free the array with free;
+ * the Products go with ra_free), or NULL if the file cannot be read or
+ * memory fails.
+ */
+void** csv_load_products_in(RecordArena* arena, const char* filename, int* count, CsvReport* report){
+    if(arena == NULL) return NULL;
+    return _csv_load(filename, 5, _csv_make_product, arena, count, report);
+}
@@ -0,0 +1,229 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include "frozenArray.h"
+
+/*
+ * frozenArray.c
+ *
+ * Cache-oblivious read-only snapshot of an OrderedArray. Binary search
+ * over the sorted array touches a different cache line (and page) at
+ * almost every level. fz_freeze stores the same elements as a complete
+ * binary search tree in van Emde Boas order instead: the tree is split at
+ * half its height, the top tree is stored first, then each bottom tree,
+ * and every part is split the same way. Any subtree of height h is then
+ * contiguous, so a search crosses a cache line (or a page, or a TLB
+ * entry) only every ~log2(block) levels, whatever the block size - no
+ * tuning for the machine.
+ *
+ * Searches use the array's CompareFunc, like oa_find_binary. A keyed
+ * snapshot (keyed array, or a KeyFunc given) also copies the keys into
+ * the same order, so a search reads no element but the one it returns.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH:  O(log n) comparisons, O(log_B n) cache misses for any block
+ *            size B (binary search: O(log n - log B)).
+ * - UPDATE:  Not supported. fz_refresh re-copies the array in O(n): one
+ *            pass over a rank table kept from the layout, no recursion and
+ *            no allocation while the height stays the same.
+ * - MEMORY:  The tree is padded to 2^h - 1 slots (up to 2x the elements):
+ *            12 bytes per slot (element pointer + rank), 20 when keyed.
+ */
+
+
+/**
+ * @brief (Private) Fills the navigation tables for a subtree whose root is at 'depth' and whose height is 'height'.
+ *
+ * Splits it into a top tree of height/2 levels and the bottom trees below
+ * them, then splits both parts again. Every depth below the root heads
+ * bottom trees at exactly one level of the recursion, and all subtrees
+ * starting at the same depth are split alike, so one entry per depth is
+ * enough.
+ */
+static void _fz_split(FrozenArray* frozen, int depth, int height){
+    if(height < 2) return;
+    int top = height / 2;
+    int below = depth + top;
+    frozen->top[below] = ((size_t)1 << top) - 1;
+    frozen->bottom[below] = ((size_t)1 << (height - top)) - 1;
+    frozen->root_depth[below] = depth;
+    _fz_split(frozen, depth, top);
+    _fz_split(frozen, below, height - top);
+}
+
+/**
+ * @brief (Private) Position of BFS node 'node' at 'depth', given the positions of its ancestors.
+ *
+ * The node heads the (node & top)-th bottom tree below the top tree rooted
+ * at 'positions[root_depth]'; bottom trees follow the top tree in order.
+ */
+static inline size_t _fz_position(const FrozenArray* frozen, const size_t* positions, size_t node, int depth){
+    size_t top = frozen->top[depth];
+    return positions[frozen->root_depth[depth]] + top + (node & top) * frozen->bottom[depth];
+}
+
+/**
+ * @brief (Private) In-order walk of the implicit tree: records the sorted rank stored in every slot.
+ *
+ * @return The next rank to place.
+ */
+static int _fz_layout(FrozenArray* frozen, size_t* positions, size_t node, int depth, int rank){
+    if(depth > frozen->height) return rank;
+    if(depth > 1) positions[depth] = _fz_position(frozen, positions, node, depth);
+    rank = _fz_layout(frozen, positions, 2 * node, depth + 1, rank);
+    frozen->ranks[positions[depth]] = rank++;
+    return _fz_layout(frozen, positions, 2 * node + 1, depth + 1, rank);
+}
+
+/**
+ * @brief (Private) Resizes the snapshot for 'count' elements and recomputes its layout if the height changes.
+ *
+ * @return 1 on success, 0 if memory fails (the snapshot is left as it was).
+ */
+static int _fz_reshape(FrozenArray* frozen, int count){
+    int height = 0;
+    while((((size_t)1 << height) - 1) < (size_t)count) height++;
+    if(height == frozen->height && frozen->ranks != NULL) return 1;
+    size_t slots = ((size_t)1 << height) - 1;
+    /* One spare slot, so an empty snapshot still has valid buffers */
+    void** data = (void**)malloc((slots + 1) * sizeof(void*));
+    int* ranks = (int*)malloc((slots + 1) * sizeof(int));
+    long* keys = frozen->key_of != NULL ? (long*)malloc((slots + 1) * sizeof(long)) : NULL;
+    if(data == NULL || ranks == NULL || (frozen->key_of != NULL && keys == NULL)){
+        free(data);
+        free(ranks);
+        free(keys);
+        return 0;
+    }
+    free(frozen->data);
+    free(frozen->ranks);
+    free(frozen->keys);
+    frozen->data = data;
+    frozen->ranks = ranks;
+    frozen->keys = keys;
+    frozen->slots = slots;
+    frozen->height = height;
+    _fz_split(frozen, 1, height);
+    size_t positions[FZ_MAX_HEIGHT + 1];
+    positions[1] = 0;
+    _fz_layout(frozen, positions, 1, 1, 0);
+    return 1;
+}
+
+/**
+ * @brief Builds a van Emde Boas ordered snapshot of an OrderedArray.
+ *
+ * @param arr The array to snapshot.
+ * @param key_func Makes a keyed snapshot: keys are copied next to the
+ * elements and searches compare them instead of calling the CompareFunc.
+ * Its order must match the array's (e.g. student_get_id with
+ * student_compare_by_id). NULL for a plain snapshot; keyed arrays always
+ * give a keyed one.
+ * @return A pointer to the new FrozenArray, or NULL on invalid arguments
+ * or if memory fails.
+ */
+FrozenArray* fz_freeze(OrderedArray* arr, KeyFunc key_func){
+    if(arr == NULL || (arr->compare == NULL && arr->keys == NULL)) return NULL;
+    FrozenArray* frozen = (FrozenArray*)calloc(1, sizeof(FrozenArray));
+    if(frozen == NULL) return NULL;
+    frozen->compare = arr->compare;
+    frozen->key_of = arr->keys != NULL ? arr->key_of : key_func;
+    frozen->height = -1;
+    if(!fz_refresh(frozen, arr)){
+        fprintf(stderr, "Error: not enough memory to freeze %d elements\n", arr->counter);
+        fz_free(frozen);
+        return NULL;
+    }
+    return frozen;
+}
+
+/**
+ * @brief Re-copies the array into an existing snapshot after the array changed.
+ *
+ * Much cheaper than a new fz_freeze: while the tree height stays the same
+ * (the element count stays between two powers of two) the buffers and the
+ * layout are reused, and the copy is a single pass over the slots.
+ *
+ * @param frozen The snapshot to update.
+ * @param arr The array it was frozen from (or one with the same ordering).
+ * @return 1 on success, 0 on invalid arguments or if memory fails (the
+ * snapshot then keeps its previous contents).
+ */
+int fz_refresh(FrozenArray* frozen, OrderedArray* arr){
+    if(frozen == NULL || arr == NULL) return 0;
+    if(frozen->key_of == NULL && arr->compare == NULL) return 0;
+    if(!_fz_reshape(frozen, arr->counter)) return 0;
+    int count = arr->counter;
+    for(size_t slot = 0; slot < frozen->slots; slot++){
+        int rank = frozen->ranks[slot];
+        frozen->data[slot] = rank < count ? arr->data[rank] : NULL;
+    }
+    if(frozen->keys != NULL){
+        for(size_t slot = 0; slot < frozen->slots; slot++){
+            int rank = frozen->ranks[slot];
+            if(rank >= count) frozen->keys[slot] = LONG_MAX;
+            else frozen->keys[slot] = arr->keys != NULL ? arr->keys[rank] : frozen->key_of(arr->data[rank]);
+        }
+    }
+    frozen->count = count;
+    return 1;
+}
+
+/**
+ * @brief Frees the snapshot (not the array or its elements).
+ */
+void fz_free(FrozenArray* frozen){
+    if(frozen == NULL) return;
+    free(frozen->data);
+    free(frozen->keys);
+    free(frozen->ranks);
+    free(frozen);
+}
+
+/**
+ * @brief Finds an element by key in a keyed snapshot.
+ *
+ * @param frozen A snapshot with keys (see fz_freeze).
+ * @param key The key to search for.
+ * @return A pointer to the element if found, or NULL otherwise (also
+ * NULL for a plain snapshot).
+ */
+void* fz_find_key(FrozenArray* frozen, long key){
+    if(frozen == NULL || frozen->keys == NULL || frozen->count == 0) return NULL;
+    size_t positions[FZ_MAX_HEIGHT + 1];
+    size_t node = 1;
+    positions[1] = 0;
+    for(int depth = 1; ; depth++){
+        size_t slot = positions[depth];
+        long stored = frozen->keys[slot];
+        if(key == stored && frozen->data[slot] != NULL) return frozen->data[slot];
+        if(depth == frozen->height) return NULL;
+        /* Padding holds LONG_MAX but sorts after it: go left on a tie */
+        node = 2 * node + (key > stored);
+        positions[depth + 1] = _fz_position(frozen, positions, node, depth + 1);
+    }
+}
+
+/**
+ * @brief Finds an element in the snapshot with the array's CompareFunc.
+ *
+ * @param frozen The snapshot built by fz_freeze.
+ * @param data_to_find A template element holding the key (e.g. a Student
+ * with only the id set).
+ * @return A pointer to the element if found, or NULL otherwise.
+ */
+void* fz_find(FrozenArray* frozen, void* data_to_find){
+    if(frozen == NULL || data_to_find == NULL || frozen->count == 0) return NULL;
+    if(frozen->keys != NULL) return fz_find_key(frozen, frozen->key_of(data_to_find));
+    size_t positions[FZ_MAX_HEIGHT + 1];
+    size_t node = 1;
+    positions[1] = 0;
+    for(int depth = 1; ; depth++){
+        void* stored = frozen->data[positions[depth]];
+        int cmp = stored != NULL ? frozen->compare(data_to_find, stored) : -1;
+        if(cmp == 0) return stored;
+        if(depth == frozen->height) return NULL;
+        node = 2 * node + (cmp > 0);
+        positions[depth + 1] = _fz_position(frozen, positions, node, depth + 1);
+    }
+}
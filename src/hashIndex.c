@@ -0,0 +1,265 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "hashIndex.h"
+
+/*
+ * hashIndex.c
+ *
+ * Implements an open-addressing hash table keyed by an element's long key
+ * (e.g. student_get_id), used as a side index for exact-key lookups on
+ * top of an ordered container (oa_attach_hash_index, list_attach_hash_index).
+ *
+ * Collisions use Robin Hood linear probing: every slot records how far it
+ * sits from its home slot, and a run of slots stays sorted by home slot.
+ * A lookup can then stop at the first slot closer to home than the probe,
+ * so misses are as short as hits, and an insert shifts the rest of its
+ * run one slot to the right. Removals shift the run back (no tombstones).
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH: O(1) expected - one hash, then a short scan of metadata bytes.
+ * - INSERT: O(1) amortized - the table doubles once it is 4/5 full.
+ * - REMOVE: O(1) expected - backward shift of the rest of the run.
+ * - ORDER:  None. Range scans and ordered walks stay with the container.
+ * - MEMORY: 17 bytes per slot (key, element pointer, metadata byte) at a
+ *           load factor between 2/5 and 4/5.
+ */
+
+
+/**
+ * @brief (Private) Home slot of 'key'.
+ *
+ * Fibonacci hashing: the key times 2^64 / phi, keeping the top bits, so
+ * consecutive ids land far apart instead of filling one run.
+ */
+static int _hi_home(HashIndex* hi, long key){
+    return (int)(((uint64_t)key * UINT64_C(0x9E3779B97F4A7C15)) >> hi->shift);
+}
+
+/**
+ * @brief (Private) Places a key in the table, shifting its run to make room.
+ *
+ * @param hi The table (must have a free slot).
+ * @param key The key to place.
+ * @param value The element to store with it.
+ * @return 1 if placed, 0 if the key is already present, -1 if a probe
+ * distance would exceed HI_MAX_PROBE (the table is left untouched).
+ */
+static int _hi_place(HashIndex* hi, long key, void* value){
+    int mask = hi->capacity - 1;
+    int slot = _hi_home(hi, key);
+    int distance = 1;
+    while(hi->meta[slot] >= distance){
+        if(hi->meta[slot] == distance && hi->keys[slot] == key) return 0;
+        slot = (slot + 1) & mask;
+        if(++distance > HI_MAX_PROBE) return -1;
+    }
+    int end = slot;
+    while(hi->meta[end] != 0){
+        if(hi->meta[end] + 1 > HI_MAX_PROBE) return -1;
+        end = (end + 1) & mask;
+    }
+    while(end != slot){
+        int previous = (end - 1) & mask;
+        hi->meta[end] = (uint8_t)(hi->meta[previous] + 1);
+        hi->keys[end] = hi->keys[previous];
+        hi->values[end] = hi->values[previous];
+        end = previous;
+    }
+    hi->meta[slot] = (uint8_t)distance;
+    hi->keys[slot] = key;
+    hi->values[slot] = value;
+    return 1;
+}
+
+/**
+ * @brief (Private) Finds the slot holding 'key'.
+ *
+ * @return The slot, or -1 if the key is not present.
+ */
+static int _hi_find_slot(HashIndex* hi, long key){
+    int mask = hi->capacity - 1;
+    int slot = _hi_home(hi, key);
+    int distance = 1;
+    while(hi->meta[slot] >= distance){
+        if(hi->meta[slot] == distance && hi->keys[slot] == key) return slot;
+        slot = (slot + 1) & mask;
+        distance++;
+    }
+    return -1;
+}
+
+/**
+ * @brief (Private) Rebuilds the table with 'new_capacity' slots.
+ *
+ * @param hi The table to rebuild.
+ * @param new_capacity A power of two larger than counter.
+ * @return 1 on success, 0 if memory fails (the table is left untouched).
+ */
+static int _hi_resize(HashIndex* hi, int new_capacity){
+    HashIndex bigger = *hi;
+    bigger.capacity = new_capacity;
+    bigger.shift = 64;
+    for(int size = new_capacity; size > 1; size /= 2) bigger.shift--;
+    bigger.meta = (uint8_t*)calloc((size_t)new_capacity, sizeof(uint8_t));
+    bigger.keys = (long*)malloc((size_t)new_capacity * sizeof(long));
+    bigger.values = (void**)malloc((size_t)new_capacity * sizeof(void*));
+    int ok = bigger.meta != NULL && bigger.keys != NULL && bigger.values != NULL;
+    for(int i = 0; ok && i < hi->capacity; i++){
+        if(hi->meta[i] != 0) ok = _hi_place(&bigger, hi->keys[i], hi->values[i]) == 1;
+    }
+    if(!ok){
+        free(bigger.meta);
+        free(bigger.keys);
+        free(bigger.values);
+        return 0;
+    }
+    free(hi->meta);
+    free(hi->keys);
+    free(hi->values);
+    *hi = bigger;
+    return 1;
+}
+
+/**
+ * @brief (Private) Smallest table size that holds 'count' keys under the load limit.
+ */
+static int _hi_capacity_for(int count){
+    int capacity = HI_MIN_CAPACITY;
+    while((long long)capacity * 4 < (long long)count * 5 && capacity <= INT_MAX / 2) capacity *= 2;
+    return capacity;
+}
+
+/**
+ * @brief Creates a new, empty HashIndex.
+ *
+ * @param expected_size Number of keys to size the table for (no rehash
+ * until then). It grows past that on demand.
+ * @param key_func A function pointer that extracts an element's key.
+ * @return A pointer to the new HashIndex, or NULL if memory fails.
+ */
+HashIndex* hi_create(int expected_size, KeyFunc key_func){
+    if(key_func == NULL) return NULL;
+    HashIndex* hi = (HashIndex*)malloc(sizeof(HashIndex));
+    if(hi == NULL) return NULL;
+    hi->meta = NULL;
+    hi->keys = NULL;
+    hi->values = NULL;
+    hi->capacity = 0;
+    hi->counter = 0;
+    hi->key_of = key_func;
+    if(!_hi_resize(hi, _hi_capacity_for(expected_size))){
+        free(hi);
+        return NULL;
+    }
+    return hi;
+}
+
+/**
+ * @brief Frees the table. The indexed elements are not freed.
+ *
+ * @param hi The HashIndex to free.
+ */
+void hi_free(HashIndex* hi){
+    if(hi == NULL) return;
+    free(hi->meta);
+    free(hi->keys);
+    free(hi->values);
+    free(hi);
+}
+
+/**
+ * @brief Grows the table so 'expected_size' keys fit without a rehash.
+ *
+ * @param hi The HashIndex to grow.
+ * @param expected_size The number of keys it must hold.
+ * @return 1 on success (or if already large enough), 0 if memory fails.
+ */
+int hi_reserve(HashIndex* hi, int expected_size){
+    if(hi == NULL) return 0;
+    int capacity = _hi_capacity_for(expected_size);
+    if(capacity <= hi->capacity) return 1;
+    return _hi_resize(hi, capacity);
+}
+
+/**
+ * @brief Indexes an element under its key.
+ *
+ * @param hi The HashIndex to insert into.
+ * @param data The element to index.
+ * @return 1 on success, 0 on failure (the key is already indexed or
+ * memory fails).
+ */
+int hi_insert(HashIndex* hi, void* data){
+    if(hi == NULL || data == NULL) return 0;
+    if((long long)(hi->counter + 1) * 5 > (long long)hi->capacity * 4
+       && (hi->capacity > INT_MAX / 2 || !_hi_resize(hi, hi->capacity * 2))) return 0;
+    long key = hi->key_of(data);
+    int placed = _hi_place(hi, key, data);
+    /* Only a pathological cluster gets here: spread it over a bigger table */
+    while(placed < 0){
+        if(hi->capacity > INT_MAX / 2 || !_hi_resize(hi, hi->capacity * 2)) return 0;
+        placed = _hi_place(hi, key, data);
+    }
+    hi->counter += placed;
+    return placed;
+}
+
+/**
+ * @brief Finds the element indexed under 'key'. O(1) expected.
+ *
+ * @param hi The HashIndex to search in.
+ * @param key The key to search for.
+ * @return A pointer to the element if found, or NULL otherwise.
+ */
+void* hi_find(HashIndex* hi, long key){
+    if(hi == NULL) return NULL;
+    int slot = _hi_find_slot(hi, key);
+    return slot >= 0 ? hi->values[slot] : NULL;
+}
+
+/**
+ * @brief Removes 'key' from the index.
+ *
+ * The rest of the run moves back one slot, so the table never holds
+ * tombstones and lookups do not slow down after many removals.
+ *
+ * @param hi The HashIndex to remove from.
+ * @param key The key to remove.
+ * @return The element that was indexed under 'key', or NULL if absent.
+ */
+void* hi_remove(HashIndex* hi, long key){
+    if(hi == NULL) return NULL;
+    int slot = _hi_find_slot(hi, key);
+    if(slot < 0) return NULL;
+    void* removed = hi->values[slot];
+    int mask = hi->capacity - 1;
+    int next = (slot + 1) & mask;
+    while(hi->meta[next] > 1){
+        hi->meta[slot] = (uint8_t)(hi->meta[next] - 1);
+        hi->keys[slot] = hi->keys[next];
+        hi->values[slot] = hi->values[next];
+        slot = next;
+        next = (next + 1) & mask;
+    }
+    hi->meta[slot] = 0;
+    hi->counter--;
+    return removed;
+}
+
+/**
+ * @brief Removes every key, keeping the table's memory.
+ */
+void hi_clear(HashIndex* hi){
+    if(hi == NULL) return;
+    memset(hi->meta, 0, (size_t)hi->capacity);
+    hi->counter = 0;
+}
+
+/**
+ * @brief Returns the number of indexed keys.
+ */
+int hi_count(HashIndex* hi){
+    return hi != NULL ? hi->counter : 0;
+}
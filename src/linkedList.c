@@ -1,6 +1,17 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "linkedList.h"
+#include "hashIndex.h"
+#include "lookupCache.h"
+#include "secondaryIndex.h"
+#include "containerStats.h"
+
+#if defined(__GNUC__)
+#define LIST_PREFETCH(address) __builtin_prefetch((const void*)(address))
+#else
+#define LIST_PREFETCH(address) ((void)0)
+#endif
 
 /*
  * linkedList.c
@@ -11,8 +22,163 @@
  * - SEARCH:   O(n)     - Must use linear search (list_find_linear).
  * - INSERT:   O(n)     - O(n) to find the position, but O(1) to insert.
  * - REMOVE:   O(n)     - O(n) to find the position, but O(1) to remove.
+ * - BATCH:    O(m log m + n) - list_find_batch/list_insert_batch sort the
+ *             batch and handle all of it in a single walk of the list.
+ *             list_append_sorted takes an already sorted run in O(n + m).
+ * - RANGE:    O(p + k) - list_range walks to the start of the range (p nodes)
+ *             and stops at its end; ListCursor only moves forward.
  * - MEMORY:   Dynamic. No capacity limit, but uses malloc per-node.
+ *             A pooled list (list_create_pooled) carves nodes out of slabs
+ *             instead: one malloc per slab, recycled nodes go to a free-list
+ *             and list_free releases whole slabs at once.
+ *
+ * KEYED MODE (list_create_keyed): every Node also stores its element's
+ * long key. Traversals compare that inline key instead of calling the
+ * CompareFunc and dereferencing each element, and stop as soon as they
+ * pass the target key.
+ *
+ * HASH INDEX (list_attach_hash_index): an optional HashIndex from each
+ * element's key to the element. Finds become O(1) expected instead of a
+ * walk; inserts and removes still walk to their position and update the
+ * index as well. While it is attached, keys must be unique.
+ *
+ * LOOKUP CACHE (list_attach_lookup_cache): an optional LookupCache of
+ * recently found elements in front of list_find_linear and list_find_key,
+ * so hot keys skip the walk. Removes invalidate their key, and so do
+ * inserts, since a new duplicate becomes the first match.
+ *
+ * SECONDARY INDEXES (list_add_index): optional B+-trees of the same
+ * elements ordered by other fields (price, stock, name), kept in step by
+ * every insert and remove. list_index_range and list_index_top answer
+ * "stock < 10" or "10 most expensive" in O(log n + k) instead of a walk.
+ *
+ * STATS (-DTRADEOFFS_STATS): counts comparisons, 'next' hops, node
+ * allocations and bytes in use, and times every find, insert, remove and
+ * batch call (list_stats). Normal builds compile the hooks away.
+ */
+
+
+/**
+ * @brief (Private) Gets a Node from the list's pool or from malloc.
+ *
+ * Pooled lists reuse a recycled node if there is one, otherwise take the
+ * next unused node of the current slab, allocating a new slab when full.
+ *
+ * @param list The list that will own the node.
+ * @return A new (uninitialized) Node, or NULL if memory fails.
+ */
+static Node* _list_alloc_node(LinkedList* list){
+    NodePool* pool = list->pool;
+    if(pool == NULL){
+        Node* node = (Node*)malloc(sizeof(Node));
+        if(node != NULL){
+            CS_ADD(list->stats, allocations, 1);
+            CS_ADD(list->stats, bytes_in_use, (long long)sizeof(Node));
+        }
+        return node;
+    }
+    if(pool->free_list != NULL){
+        Node* node = pool->free_list;
+        pool->free_list = node->next;
+        return node;
+    }
+    if(pool->slabs == NULL || pool->slabs->used == pool->slab_size){
+        NodeSlab* slab = (NodeSlab*)malloc(sizeof(NodeSlab) + (size_t)pool->slab_size * sizeof(Node));
+        if(slab == NULL) return NULL;
+        CS_ADD(list->stats, allocations, 1);
+        CS_ADD(list->stats, bytes_in_use, (long long)(sizeof(NodeSlab) + (size_t)pool->slab_size * sizeof(Node)));
+        slab->used = 0;
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+    }
+    return &pool->slabs->nodes[pool->slabs->used++];
+}
+
+/**
+ * @brief (Private) Returns a Node to the pool's free-list, or frees it.
+ *
+ * @param list The list that owned the node.
+ * @param node The node to release.
+ */
+static void _list_release_node(LinkedList* list, Node* node);
+
+/**
+ * @brief (Private) Keyed mode: finds the link to the first node with key >= 'key'.
+ *
+ * Returns the address of the 'next' field (or of 'head') that points at
+ * that node, so callers can insert before it or unlink it in O(1).
+ *
+ * @param list A keyed list.
+ * @param key The key to look for.
+ * @return The link; *link is NULL if every key is smaller.
+ */
+static Node** _list_key_link(LinkedList* list, long key){
+    Node** link = &list->head;
+    while(*link != NULL && (*link)->key < key){
+        CS_ADD(list->stats, comparisons, 1);
+        CS_ADD(list->stats, hops, 1);
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/**
+ * @brief (Private) Calls the list's CompareFunc (counted in stats builds).
+ */
+static int _list_compare(LinkedList* list, void* a, void* b){
+    CS_ADD(list->stats, comparisons, 1);
+    return list->compare(a, b);
+}
+
+/**
+ * @brief (Private) Compares batch keys 'a' and 'b' with the list's ordering.
+ *
+ * @param key_values Keyed mode: the precomputed keys of the batch (else NULL).
+ */
+static int _list_compare_batch(LinkedList* list, void** keys, const long* key_values, int a, int b){
+    if(key_values != NULL) return (key_values[a] > key_values[b]) - (key_values[a] < key_values[b]);
+    return _list_compare(list, keys[a], keys[b]);
+}
+
+/**
+ * @brief (Private) Stable bottom-up merge sort of batch positions by key.
+ *
+ * @param order The positions 0 .. count-1 to sort (sorted in place).
+ * @param tmp Scratch buffer with room for 'count' ints.
  */
+static void _list_sort_batch(LinkedList* list, void** keys, const long* key_values,
+                             int* order, int* tmp, int count){
+    int* src = order;
+    int* dst = tmp;
+    for(int width = 1; width < count; width *= 2){
+        for(int lo = 0; lo < count; lo += 2 * width){
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo, j = mid, k = lo;
+            while(i < mid && j < hi){
+                if(_list_compare_batch(list, keys, key_values, src[j], src[i]) < 0) dst[k++] = src[j++];
+                else dst[k++] = src[i++];
+            }
+            while(i < mid) dst[k++] = src[i++];
+            while(j < hi) dst[k++] = src[j++];
+        }
+        int* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if(src != order) memcpy(order, src, (size_t)count * sizeof(int));
+}
+
+static void _list_release_node(LinkedList* list, Node* node){
+    if(list->pool == NULL){
+        free(node);
+        CS_ADD(list->stats, frees, 1);
+        CS_ADD(list->stats, bytes_in_use, -(long long)sizeof(Node));
+        return;
+    }
+    node->next = list->pool->free_list;
+    list->pool->free_list = node;
+}
 
 
 /**
@@ -30,6 +196,66 @@ LinkedList* list_create(CompareFunc compare_func){
     lkl->head = NULL;
     lkl->counter = 0;
     lkl->compare = compare_func;
+    lkl->pool = NULL;
+    lkl->key_of = NULL;
+    lkl->index = NULL;
+    lkl->cache = NULL;
+    lkl->secondary = NULL;
+#ifdef TRADEOFFS_STATS
+    lkl->stats = cs_create();
+    if(lkl->stats == NULL){
+        free(lkl);
+        return NULL;
+    }
+    CS_ADD(lkl->stats, allocations, 1);
+    CS_ADD(lkl->stats, bytes_in_use, (long long)sizeof(LinkedList));
+#endif
+    return lkl;
+}
+
+/**
+ * @brief Creates a new, empty LinkedList whose nodes come from a pool.
+ *
+ * Nodes are allocated 'slab_size' at a time, which removes the per-insert
+ * malloc and keeps neighbouring nodes close together in memory. Removed
+ * nodes are recycled through a free-list, and list_free releases every
+ * slab in one pass regardless of the number of nodes.
+ *
+ * @param compare_func A function pointer used to compare elements.
+ * @param slab_size Nodes per slab (<= 0 uses LIST_DEFAULT_SLAB_SIZE).
+ * @return A pointer to the new LinkedList, or NULL if memory fails.
+ */
+LinkedList* list_create_pooled(CompareFunc compare_func, int slab_size){
+    LinkedList* lkl = list_create(compare_func);
+    if(lkl == NULL) return NULL;
+    lkl->pool = (NodePool*)malloc(sizeof(NodePool));
+    if(lkl->pool == NULL){
+        list_free(lkl);
+        return NULL;
+    }
+    CS_ADD(lkl->stats, allocations, 1);
+    CS_ADD(lkl->stats, bytes_in_use, (long long)sizeof(NodePool));
+    lkl->pool->slabs = NULL;
+    lkl->pool->free_list = NULL;
+    lkl->pool->slab_size = slab_size > 0 ? slab_size : LIST_DEFAULT_SLAB_SIZE;
+    return lkl;
+}
+
+/**
+ * @brief Creates a new, empty LinkedList in keyed mode.
+ *
+ * Each Node stores the key of its element (as returned by 'key_func',
+ * e.g. product_get_id), and all operations compare keys directly.
+ *
+ * @param key_func A function pointer that extracts an element's key.
+ * @param slab_size Nodes per slab for a pooled list, or 0 for one malloc per node.
+ * @return A pointer to the new LinkedList, or NULL if memory fails.
+ */
+LinkedList* list_create_keyed(KeyFunc key_func, int slab_size){
+    if(key_func == NULL) return NULL;
+    LinkedList* lkl = slab_size > 0 ? list_create_pooled(NULL, slab_size) : list_create(NULL);
+    if(lkl == NULL) return NULL;
+    lkl->key_of = key_func;
     return lkl;
 }
 
@@ -37,7 +263,8 @@ LinkedList* list_create(CompareFunc compare_func){
  * @brief Frees all memory associated with the LinkedList.
  *
  * Iterates through the list, freeing each Node, and then frees
- * the LinkedList management struct itself.
+ * the LinkedList management struct itself. A pooled list frees its
+ * slabs instead, without visiting the nodes.
  * Note: This does NOT free the actual data (e.g., Products)
  * pointed to by the nodes. That is the caller's responsibility.
  *
@@ -45,6 +272,23 @@ LinkedList* list_create(CompareFunc compare_func){
  */
 void list_free(LinkedList* list){
     if(list == NULL) return;
+    hi_free(list->index);
+    lc_free(list->cache);
+    sx_free(list->secondary);
+#ifdef TRADEOFFS_STATS
+    cs_free(list->stats);
+#endif
+    if(list->pool != NULL){
+        NodeSlab* slab = list->pool->slabs;
+        while(slab != NULL){
+            NodeSlab* next_slab = slab->next;
+            free(slab);
+            slab = next_slab;
+        }
+        free(list->pool);
+        free(list);
+        return;
+    }
     Node* current_pointer = list->head;
     Node* temp_pointer;
     while(current_pointer != NULL){
@@ -55,57 +299,229 @@ void list_free(LinkedList* list){
     free(list);
 }
 
+/**
+ * @brief (Private) Finds 'key' through the hash index or the keyed walk (no lookup cache).
+ */
+static void* _list_search_key(LinkedList* list, long key){
+    if(list->index != NULL) return hi_find(list->index, key);
+    if(list->key_of == NULL) return NULL;
+    Node* node = *_list_key_link(list, key);
+    CS_ADD(list->stats, comparisons, node != NULL);
+    return (node != NULL && node->key == key) ? node->data : NULL;
+}
+
+/**
+ * @brief (Private) Finds a template through the hash index, the keyed walk or a linear search (no lookup cache).
+ */
+static void* _list_search(LinkedList* list, void* data_to_find){
+    if(list->index != NULL) return hi_find(list->index, list->index->key_of(data_to_find));
+    if(list->key_of != NULL) return _list_search_key(list, list->key_of(data_to_find));
+    Node* current = list->head;
+    while(current != NULL){
+        int comparison = _list_compare(list, data_to_find, current->data);
+        if(comparison == 0) return current->data;
+        current = current->next;
+        CS_ADD(list->stats, hops, 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief (Private) Body of list_find_linear (the public function times it).
+ */
+static void* _list_find_linear(LinkedList* list, void* data_to_find){
+    if(list == NULL || list->head == NULL) return NULL;
+    if(list->cache == NULL) return _list_search(list, data_to_find);
+    void* found = lc_find(list->cache, list->cache->key_of(data_to_find));
+    if(found == NULL && (found = _list_search(list, data_to_find)) != NULL) lc_store(list->cache, found);
+    return found;
+}
+
 /**
  * @brief Finds an element in the list using linear search.
  *
  * Iterates from the head of the list, comparing each element.
- * This is an O(n) operation.
+ * This is an O(n) operation (O(1) with a hash index attached). With a
+ * lookup cache attached, a cached key is answered without the walk.
  *
  * @param list The list to search in.
  * @param data_to_find A "template" data object to search for.
  * @return A pointer to the data if found, or NULL otherwise.
  */
 void* list_find_linear(LinkedList* list, void* data_to_find){
-    if(list == NULL || list->head == NULL) return NULL;
+    CS_TIMER_START(started);
+    void* found = _list_find_linear(list, data_to_find);
+    CS_TIMER_STOP(list_stats(list), CS_OP_FIND, started);
+    return found;
+}
+
+/**
+ * @brief (Private) Body of list_find_key (the public function times it).
+ */
+static void* _list_find_key(LinkedList* list, long key){
+    if(list == NULL) return NULL;
+    if(list->cache == NULL) return _list_search_key(list, key);
+    void* found = lc_find(list->cache, key);
+    if(found == NULL && (found = _list_search_key(list, key)) != NULL) lc_store(list->cache, found);
+    return found;
+}
+
+/**
+ * @brief Finds an element by key in a keyed list (no template needed).
+ *
+ * Stops at the first node whose key is >= 'key', so misses cost only the
+ * distance to where the key would be.
+ *
+ * @param list A keyed list (see list_create_keyed), or one with a hash index
+ * or a lookup cache.
+ * @param key The key to search for.
+ * @return A pointer to the data if found, or NULL otherwise (also NULL
+ * if the list is neither keyed nor indexed and the key is not cached).
+ */
+void* list_find_key(LinkedList* list, long key){
+    CS_TIMER_START(started);
+    void* found = _list_find_key(list, key);
+    CS_TIMER_STOP(list_stats(list), CS_OP_FIND, started);
+    return found;
+}
+
+/**
+ * @brief (Private) Body of list_find_batch (the public function times it).
+ */
+static int _list_find_batch(LinkedList* list, void** keys, int count, void** results){
+    if(list == NULL || keys == NULL || results == NULL || count <= 0) return 0;
+    if(list->index != NULL){
+        int found = 0;
+        for(int i = 0; i < count; i++){
+            results[i] = hi_find(list->index, list->index->key_of(keys[i]));
+            found += results[i] != NULL;
+        }
+        return found;
+    }
+    int* order = (int*)malloc((size_t)count * 2 * sizeof(int));
+    long* key_values = NULL;
+    if(order == NULL) return 0;
+    if(list->key_of != NULL){
+        key_values = (long*)malloc((size_t)count * sizeof(long));
+        if(key_values == NULL){
+            free(order);
+            return 0;
+        }
+        for(int i = 0; i < count; i++) key_values[i] = list->key_of(keys[i]);
+    }
+    for(int i = 0; i < count; i++) order[i] = i;
+    _list_sort_batch(list, keys, key_values, order, order + count, count);
+
+    int found = 0;
     Node* current = list->head;
-    while(current != NULL){
-        int comparison = list->compare(data_to_find, current->data);
-        if(comparison == 0) return current->data;
-        current = current->next;
+    for(int i = 0; i < count; i++){
+        int position = order[i];
+        int comparison = 1;
+        while(current != NULL){
+            LIST_PREFETCH(current->next);
+            if(key_values != NULL){
+                CS_ADD(list->stats, comparisons, 1);
+                comparison = (key_values[position] > current->key) - (key_values[position] < current->key);
+            }
+            else comparison = _list_compare(list, keys[position], current->data);
+            if(comparison <= 0) break;
+            current = current->next;
+            CS_ADD(list->stats, hops, 1);
+        }
+        results[position] = (current != NULL && comparison == 0) ? current->data : NULL;
+        found += results[position] != NULL;
     }
-    return NULL;
+    free(order);
+    free(key_values);
+    return found;
 }
 
 /**
- * @brief Inserts a data element into the list, maintaining sort order.
+ * @brief Finds a batch of elements in a single pass over the list.
  *
- * Finds the correct insertion point by iterating (O(n)) and then
- * performs the "re-wiring" of pointers to insert the new Node (O(1)).
- * Handles insertion at the head, middle, and end of the list.
+ * Sorts the keys (O(m log m)) and then walks the list once, answering
+ * them in order like the merge step of a merge sort (O(n + m)), instead
+ * of one O(n) walk per key. The next node is prefetched while the
+ * current one is compared. With a hash index attached, each key is one
+ * O(1) index lookup instead and the list is not walked.
  *
- * @param list The list to insert into.
- * @param data The data (e.g., Product*) to insert.
- * @return 1 on success, 0 on failure (list is NULL or malloc fails).
+ * @param list The list to search in.
+ * @param keys "Template" data objects to search for (not modified).
+ * @param count Number of keys.
+ * @param results [out] Buffer with room for 'count' pointers; results[i]
+ * receives the element matching keys[i], or NULL if it is not present.
+ * @return The number of keys found (0 also if memory fails).
  */
-int list_insert_sorted(LinkedList* list, void* data){
+int list_find_batch(LinkedList* list, void** keys, int count, void** results){
+    CS_TIMER_START(started);
+    int found = _list_find_batch(list, keys, count, results);
+    CS_TIMER_STOP(list_stats(list), CS_OP_BATCH, started);
+    return found;
+}
+
+/**
+ * @brief (Private) Adds elements to the hash index and the secondary indexes: all, or none.
+ *
+ * @return 1 on success, 0 if an index runs out of memory or rejects an
+ * element (the indexes are then left as they were).
+ */
+static int _list_index_all(LinkedList* list, void** items, int count){
+    int indexed = 0;
+    while(list->index != NULL && indexed < count && hi_insert(list->index, items[indexed])) indexed++;
+    if(list->index != NULL && indexed < count){
+        while(indexed-- > 0) hi_remove(list->index, list->index->key_of(items[indexed]));
+        return 0;
+    }
+    if(!sx_insert(list->secondary, items, count)){
+        for(int i = 0; list->index != NULL && i < count; i++) hi_remove(list->index, list->index->key_of(items[i]));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief (Private) Drops a removed element from the hash index, the cache and the secondary indexes.
+ */
+static void _list_unindex(LinkedList* list, void* data){
+    if(list->index != NULL) hi_remove(list->index, list->index->key_of(data));
+    if(list->cache != NULL) lc_invalidate(list->cache, list->cache->key_of(data));
+    sx_remove(list->secondary, data);
+}
+
+/**
+ * @brief (Private) Body of list_insert_sorted (the public function times it).
+ */
+static int _list_insert_sorted(LinkedList* list, void* data){
     if(list == NULL) return 0;
-    Node* newNode = (Node*)malloc(sizeof(Node));
+    Node* newNode = _list_alloc_node(list);
     if(newNode == NULL) return 0;
+    if(!_list_index_all(list, &data, 1)){
+        _list_release_node(list, newNode);
+        return 0;
+    }
+    if(list->cache != NULL) lc_invalidate(list->cache, list->cache->key_of(data));
     newNode->data = data;
-    if(list->head == NULL){
+    if(list->key_of != NULL){
+        newNode->key = list->key_of(data);
+        Node** link = _list_key_link(list, newNode->key);
+        newNode->next = *link;
+        *link = newNode;
+    }
+    else if(list->head == NULL){
             newNode->next = NULL;
             list->head = newNode;
     }
-    else if(list->compare(data, list->head->data) < 0){
+    else if(_list_compare(list, data, list->head->data) < 0){
             newNode->next = list->head;
             list->head = newNode;
     }
         else{
             Node* previous = list->head;
             Node* current = list->head->next;
-            while(current != NULL && list->compare(data, current->data) > 0){
+            while(current != NULL && _list_compare(list, data, current->data) > 0){
                 previous = current;
                 current = current->next;
+                CS_ADD(list->stats, hops, 1);
             }
             newNode->next = current;
             previous->next = newNode;
@@ -115,22 +531,205 @@ int list_insert_sorted(LinkedList* list, void* data){
 }
 
 /**
- * @brief Removes a data element from the list.
+ * @brief Inserts a data element into the list, maintaining sort order.
  *
- * Finds the element to remove by iterating (O(n)) and then
- * performs the "re-wiring" of pointers to "skip" the node (O(1)).
- * Handles removal of the head, middle, and end nodes.
+ * Finds the correct insertion point by iterating (O(n)) and then
+ * performs the "re-wiring" of pointers to insert the new Node (O(1)).
+ * Handles insertion at the head, middle, and end of the list.
  *
- * @param list The list to remove from.
- * @param data_to_remove A "template" data object to find and remove.
- * @return The pointer to the removed data (so the caller can free it),
- * or NULL if the element was not found.
+ * @param list The list to insert into.
+ * @param data The data (e.g., Product*) to insert.
+ * @return 1 on success, 0 on failure (list is NULL, malloc fails, or an
+ * attached index already holds an equal element).
  */
-void* list_remove(LinkedList* list, void* data_to_remove){
+int list_insert_sorted(LinkedList* list, void* data){
+    CS_TIMER_START(started);
+    int inserted = _list_insert_sorted(list, data);
+    CS_TIMER_STOP(list_stats(list), CS_OP_INSERT, started);
+    return inserted;
+}
+
+/**
+ * @brief (Private) Body of list_insert_batch (the public function times it).
+ */
+static int _list_insert_batch(LinkedList* list, void** items, int count){
+    if(list == NULL || items == NULL || count <= 0) return 0;
+    int* order = (int*)malloc((size_t)count * 2 * sizeof(int));
+    void** sorted = (void**)malloc((size_t)count * sizeof(void*));
+    long* key_values = list->key_of != NULL ? (long*)malloc((size_t)count * sizeof(long)) : NULL;
+    if(order == NULL || sorted == NULL || (list->key_of != NULL && key_values == NULL)){
+        free(order);
+        free(sorted);
+        free(key_values);
+        return 0;
+    }
+    for(int i = 0; i < count; i++){
+        order[i] = i;
+        if(key_values != NULL) key_values[i] = list->key_of(items[i]);
+    }
+    _list_sort_batch(list, items, key_values, order, order + count, count);
+    for(int i = 0; i < count; i++) sorted[i] = items[order[i]];
+
+    int inserted = 0;
+    int rejected = 0;
+    Node** link = &list->head;
+    for(int i = 0; i < count; i++){
+        void* item = sorted[i];
+        int indexed = list->index != NULL || list->secondary != NULL;
+        Node* newNode = (rejected == 0 || indexed) ? _list_alloc_node(list) : NULL;
+        if(newNode != NULL && !_list_index_all(list, &item, 1)){
+            _list_release_node(list, newNode);
+            newNode = NULL;
+        }
+        if(newNode == NULL){
+            /* Rejected items are compacted at the front of 'sorted' (rejected <= i) */
+            sorted[rejected++] = item;
+            continue;
+        }
+        items[inserted++] = item;
+        if(list->cache != NULL) lc_invalidate(list->cache, list->cache->key_of(item));
+        newNode->data = item;
+        if(key_values != NULL){
+            newNode->key = key_values[order[i]];
+            while(*link != NULL && (*link)->key < newNode->key){
+                CS_ADD(list->stats, comparisons, 1);
+                CS_ADD(list->stats, hops, 1);
+                link = &(*link)->next;
+            }
+        }
+        else{
+            while(*link != NULL && _list_compare(list, item, (*link)->data) > 0){
+                CS_ADD(list->stats, hops, 1);
+                link = &(*link)->next;
+            }
+        }
+        newNode->next = *link;
+        *link = newNode;
+        link = &newNode->next;
+    }
+    list->counter += inserted;
+    memcpy(&items[inserted], sorted, (size_t)rejected * sizeof(void*));
+    free(order);
+    free(sorted);
+    free(key_values);
+    return inserted;
+}
+
+/**
+ * @brief Inserts a batch of elements in a single merge pass.
+ *
+ * Sorts the batch (O(m log m)) and splices it into the list in one walk
+ * (O(n + m)), instead of one O(n) walk per element. Like
+ * list_insert_sorted, duplicates are allowed and every new element goes
+ * before the existing elements that compare equal to it; equal elements
+ * of the batch keep their batch order.
+ *
+ * The 'items' array is reordered: on return items[0 .. result) are the
+ * inserted elements (sorted) and items[result .. count) the ones that
+ * could not be inserted: memory ran out or, with a hash index or a
+ * secondary index attached, an equal element was already present.
+ *
+ * @param list The list to insert into.
+ * @param items The elements to insert.
+ * @param count Number of elements in 'items'.
+ * @return The number of elements inserted (0 also if memory fails).
+ */
+int list_insert_batch(LinkedList* list, void** items, int count){
+    CS_TIMER_START(started);
+    int inserted = _list_insert_batch(list, items, count);
+    CS_TIMER_STOP(list_stats(list), CS_OP_BATCH, started);
+    return inserted;
+}
+
+/**
+ * @brief (Private) Body of list_append_sorted (the public function times it).
+ */
+static int _list_append_sorted(LinkedList* list, void** items, int count){
+    if(list == NULL || items == NULL || count <= 0) return 0;
+    Node** link = &list->head;
+    Node* tail = NULL;
+    while(*link != NULL){
+        tail = *link;
+        link = &tail->next;
+        CS_ADD(list->stats, hops, 1);
+    }
+    for(int i = 0; i < count; i++){
+        void* previous = i > 0 ? items[i - 1] : (tail != NULL ? tail->data : NULL);
+        if(previous == NULL) continue;
+        if(list->key_of != NULL){
+            if(list->key_of(previous) > list->key_of(items[i])) return 0;
+        }
+        else if(_list_compare(list, previous, items[i]) > 0) return 0;
+    }
+    if(!_list_index_all(list, items, count)) return 0;
+    /* The chain is built apart and linked at the end: all or nothing */
+    Node* first = NULL;
+    Node** chain = &first;
+    for(int i = 0; i < count; i++){
+        Node* newNode = _list_alloc_node(list);
+        if(newNode == NULL){
+            *chain = NULL;
+            while(first != NULL){
+                Node* next = first->next;
+                _list_release_node(list, first);
+                first = next;
+            }
+            for(int k = 0; k < count; k++) _list_unindex(list, items[k]);
+            return 0;
+        }
+        newNode->data = items[i];
+        if(list->key_of != NULL) newNode->key = list->key_of(items[i]);
+        *chain = newNode;
+        chain = &newNode->next;
+    }
+    *chain = NULL;
+    *link = first;
+    list->counter += count;
+    return count;
+}
+
+/**
+ * @brief Appends an already sorted run after the last element.
+ *
+ * The fast path for building a list from sorted input (see
+ * bulk_build_list): no search per element, just one walk to the tail
+ * (O(1) on an empty list) and O(m) new nodes. The run is checked in the
+ * same pass: it must be in non-decreasing order and not start before the
+ * list's current last element. With a hash index attached its keys must
+ * also be new.
+ *
+ * @param list The list to append to.
+ * @param items The elements to append, in order (not modified).
+ * @param count Number of elements in 'items'.
+ * @return 'count' on success, or 0 if the run is out of order, a key is
+ * already indexed, or memory fails (nothing is appended).
+ */
+int list_append_sorted(LinkedList* list, void** items, int count){
+    CS_TIMER_START(started);
+    int appended = _list_append_sorted(list, items, count);
+    CS_TIMER_STOP(list_stats(list), CS_OP_BATCH, started);
+    return appended;
+}
+
+/**
+ * @brief (Private) Body of list_remove (the public function times it).
+ */
+static void* _list_remove(LinkedList* list, void* data_to_remove){
     if(list == NULL || list->head == NULL) return NULL;
+    /* The index answers misses without walking the list */
+    if(list->index != NULL && hi_find(list->index, list->index->key_of(data_to_remove)) == NULL) return NULL;
     void* removed_data = NULL;
     Node* node_to_free = NULL;
-    if(list->compare(data_to_remove, list->head->data) == 0){
+    if(list->key_of != NULL){
+        long key = list->key_of(data_to_remove);
+        Node** link = _list_key_link(list, key);
+        if(*link != NULL && (*link)->key == key){
+            node_to_free = *link;
+            removed_data = node_to_free->data;
+            *link = node_to_free->next;
+        }
+    }
+    else if(_list_compare(list, data_to_remove, list->head->data) == 0){
         removed_data = list->head->data;
         node_to_free = list->head;
         list->head = list->head->next;
@@ -138,9 +737,10 @@ void* list_remove(LinkedList* list, void* data_to_remove){
     else{
         Node* previous = list->head;
         Node* current = list->head->next;
-        while(current != NULL && list->compare(data_to_remove, current->data) != 0){
+        while(current != NULL && _list_compare(list, data_to_remove, current->data) != 0){
             previous = current;
             current = current->next;
+            CS_ADD(list->stats, hops, 1);
         }
         if (current != NULL) {
             removed_data = current->data;
@@ -149,12 +749,32 @@ void* list_remove(LinkedList* list, void* data_to_remove){
         }
     }
     if(node_to_free != NULL){
-        free(node_to_free);
+        _list_unindex(list, removed_data);
+        _list_release_node(list, node_to_free);
         list->counter--;
     }
     return removed_data;
 }
 
+/**
+ * @brief Removes a data element from the list.
+ *
+ * Finds the element to remove by iterating (O(n)) and then
+ * performs the "re-wiring" of pointers to "skip" the node (O(1)).
+ * Handles removal of the head, middle, and end nodes.
+ *
+ * @param list The list to remove from.
+ * @param data_to_remove A "template" data object to find and remove.
+ * @return The pointer to the removed data (so the caller can free it),
+ * or NULL if the element was not found.
+ */
+void* list_remove(LinkedList* list, void* data_to_remove){
+    CS_TIMER_START(started);
+    void* removed = _list_remove(list, data_to_remove);
+    CS_TIMER_STOP(list_stats(list), CS_OP_REMOVE, started);
+    return removed;
+}
+
 /**
  * @brief Prints all elements in the list to the console.
  *
@@ -172,3 +792,266 @@ void list_print(LinkedList* list, PrintFunc print_func){
         current = current->next;
     }
 }
+
+/**
+ * @brief (Private) Returns the first node not ordered before 'key' (NULL = end of list).
+ */
+static Node* _list_lower_bound_node(LinkedList* list, void* key){
+    if(list->key_of != NULL) return *_list_key_link(list, list->key_of(key));
+    Node* current = list->head;
+    while(current != NULL && _list_compare(list, key, current->data) > 0){
+        CS_ADD(list->stats, hops, 1);
+        current = current->next;
+    }
+    return current;
+}
+
+/**
+ * @brief Positions a cursor on the first element.
+ *
+ * The cursor holds a node: removing that node invalidates it.
+ *
+ * @param list The list to walk.
+ * @param cursor [out] The cursor to position.
+ * @return 1 if the cursor is on an element, 0 if the list is empty.
+ */
+int list_begin(LinkedList* list, ListCursor* cursor){
+    if(cursor == NULL) return 0;
+    cursor->node = list != NULL ? list->head : NULL;
+    return cursor->node != NULL;
+}
+
+/**
+ * @brief Positions a cursor on the first element not ordered before 'key'. O(n).
+ *
+ * @param list The list to walk.
+ * @param key A "template" element holding the key, or NULL for the first element.
+ * @param cursor [out] The cursor to position.
+ * @return 1 if the cursor is on an element, 0 if it is past the end.
+ */
+int list_lower_bound(LinkedList* list, void* key, ListCursor* cursor){
+    if(cursor == NULL) return 0;
+    if(list == NULL || key == NULL) return list_begin(list, cursor);
+    cursor->node = _list_lower_bound_node(list, key);
+    return cursor->node != NULL;
+}
+
+/**
+ * @brief Returns the element under the cursor, or NULL past the end.
+ */
+void* list_cursor_get(ListCursor* cursor){
+    if(cursor == NULL || cursor->node == NULL) return NULL;
+    return cursor->node->data;
+}
+
+/**
+ * @brief Moves the cursor to the next element (singly linked: forward only).
+ *
+ * @param cursor The cursor to move.
+ * @return 1 if the cursor is on an element, 0 past the end.
+ */
+int list_cursor_next(ListCursor* cursor){
+    if(cursor == NULL || cursor->node == NULL) return 0;
+    cursor->node = cursor->node->next;
+    return cursor->node != NULL;
+}
+
+/**
+ * @brief Visits, in order, every element in the range [low, high).
+ *
+ * Walks from the head to 'low' and stops at 'high' (or when 'visit'
+ * returns 0), so the cost is the distance to the end of the range rather
+ * than a full pass. Keyed lists compare the inline keys.
+ *
+ * @param list The list to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int list_range(LinkedList* list, void* low, void* high, VisitFunc visit, void* context){
+    if(list == NULL || visit == NULL) return 0;
+    Node* current = low != NULL ? _list_lower_bound_node(list, low) : list->head;
+    long high_key = (high != NULL && list->key_of != NULL) ? list->key_of(high) : 0;
+    int visited = 0;
+    while(current != NULL){
+        if(high != NULL){
+            if(list->key_of != NULL ? current->key >= high_key : _list_compare(list, current->data, high) >= 0) break;
+        }
+        visited++;
+        if(!visit(current->data, context)) break;
+        current = current->next;
+        CS_ADD(list->stats, hops, 1);
+    }
+    return visited;
+}
+
+/**
+ * @brief Attaches a hash index for O(1) exact-key lookups.
+ *
+ * Builds a HashIndex over the current elements. From then on inserts and
+ * removes keep it up to date, and list_find_linear, list_find_key and
+ * list_find_batch answer from it without walking the list, which still
+ * serves ordered walks and ranges. Keys must be unique: while the index is
+ * attached, inserting a key that is already present fails.
+ *
+ * @param list The list to index. An existing index is rebuilt.
+ * @param key_func Extracts an element's key, or NULL to reuse the list's
+ * own (keyed mode).
+ * @return 1 on success, 0 if there is no key function, two elements
+ * share a key, or memory fails (the list is left without an index).
+ */
+int list_attach_hash_index(LinkedList* list, KeyFunc key_func){
+    if(list == NULL) return 0;
+    list_detach_hash_index(list);
+    if(key_func == NULL) key_func = list->key_of;
+    HashIndex* index = hi_create(list->counter, key_func);
+    if(index == NULL) return 0;
+    for(Node* current = list->head; current != NULL; current = current->next){
+        if(!hi_insert(index, current->data)){
+            hi_free(index);
+            return 0;
+        }
+    }
+    list->index = index;
+    return 1;
+}
+
+/**
+ * @brief Drops the list's hash index (finds go back to walking the list).
+ */
+void list_detach_hash_index(LinkedList* list){
+    if(list == NULL) return;
+    hi_free(list->index);
+    list->index = NULL;
+}
+
+/**
+ * @brief Attaches a lookup cache of recently found elements.
+ *
+ * list_find_linear and list_find_key then look the key up in a small
+ * LookupCache first and only walk the list on a miss, caching what they
+ * find. Removes invalidate the removed key; inserts invalidate theirs too,
+ * because a new duplicate goes before its equals and becomes the first
+ * match. Worth it for skewed workloads where a few keys take most
+ * lookups. Finds update the cache, so concurrent readers need exclusive
+ * access.
+ *
+ * @param list The list to cache. An existing cache is replaced.
+ * @param slots Cached elements (<= 0: LC_DEFAULT_SLOTS).
+ * @param key_func Extracts an element's key, or NULL to reuse the
+ * list's own (keyed mode).
+ * @return 1 on success, 0 if there is no key function or memory fails.
+ */
+int list_attach_lookup_cache(LinkedList* list, int slots, KeyFunc key_func){
+    if(list == NULL) return 0;
+    list_detach_lookup_cache(list);
+    list->cache = lc_create(slots, key_func != NULL ? key_func : list->key_of);
+    return list->cache != NULL;
+}
+
+/**
+ * @brief Drops the list's lookup cache.
+ */
+void list_detach_lookup_cache(LinkedList* list){
+    if(list == NULL) return;
+    lc_free(list->cache);
+    list->cache = NULL;
+}
+
+/**
+ * @brief Adds a secondary ordered index over another field.
+ *
+ * Builds a B+-tree of the current elements ordered by 'compare_func'
+ * (e.g. product_compare_by_stock). From then on every insert and remove
+ * (single and batch) keeps it up to date, and inserts of an element
+ * equal to an indexed one under 'compare_func' are rejected. The
+ * comparator must break ties (by id), and the fields it reads must not
+ * be changed in place while indexed (remove the element, change it,
+ * insert it again).
+ *
+ * @param list The list to index.
+ * @param compare_func The index's ordering.
+ * @return The index's slot (for list_index_range, list_index_top and
+ * list_drop_index), or -1 if SX_MAX_INDEXES are already in use, two
+ * elements compare equal, or memory fails.
+ */
+int list_add_index(LinkedList* list, CompareFunc compare_func){
+    if(list == NULL || compare_func == NULL) return -1;
+    void** items = (void**)malloc(((size_t)list->counter + 1) * sizeof(void*));
+    if(items == NULL) return -1;
+    int count = 0;
+    for(Node* current = list->head; current != NULL; current = current->next) items[count++] = current->data;
+    int slot = -1;
+    if(list->secondary != NULL || (list->secondary = sx_create()) != NULL){
+        slot = sx_add(list->secondary, compare_func, items, count);
+    }
+    free(items);
+    return slot;
+}
+
+/**
+ * @brief Drops the secondary index in 'slot'.
+ *
+ * @return 1 if there was an index there, 0 otherwise.
+ */
+int list_drop_index(LinkedList* list, int slot){
+    if(list == NULL || !sx_drop(list->secondary, slot)) return 0;
+    if(sx_count(list->secondary) == 0){
+        sx_free(list->secondary);
+        list->secondary = NULL;
+    }
+    return 1;
+}
+
+/**
+ * @brief Visits, in a secondary index's order, every element in the range [low, high).
+ *
+ * Same bounds as oa_index_range: a template with id = LONG_MIN bounds
+ * every element with that value. O(log n + k), no walk of the list.
+ *
+ * @param list The list to scan.
+ * @param slot The index, as returned by list_add_index.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int list_index_range(LinkedList* list, int slot, void* low, void* high, VisitFunc visit, void* context){
+    if(list == NULL) return 0;
+    return sx_range(list->secondary, slot, low, high, visit, context);
+}
+
+/**
+ * @brief Returns the k largest elements of a secondary index, largest first.
+ *
+ * @param list The list to read.
+ * @param slot The index, as returned by list_add_index.
+ * @param k Number of elements wanted.
+ * @param results [out] Buffer with room for 'k' pointers.
+ * @return The number of elements written (fewer than k if the list is smaller).
+ */
+int list_index_top(LinkedList* list, int slot, int k, void** results){
+    if(list == NULL) return 0;
+    return sx_top(list->secondary, slot, k, results);
+}
+
+/**
+ * @brief Returns the list's cost counters and latency histograms.
+ *
+ * Only stats builds (-DTRADEOFFS_STATS) collect them. Use cs_snapshot to
+ * copy them, cs_reset to clear them and cs_dump_json to export them.
+ *
+ * @param list The list to query.
+ * @return Its ContainerStats, or NULL in normal builds.
+ */
+ContainerStats* list_stats(LinkedList* list){
+#ifdef TRADEOFFS_STATS
+    return list != NULL ? list->stats : NULL;
+#else
+    (void)list;
+    return NULL;
+#endif
+}
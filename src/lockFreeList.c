@@ -0,0 +1,543 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "lockFreeList.h"
+
+/*Low bit of a 'next' word: the node holding that word is logically deleted*/
+#define LFL_MARK ((uintptr_t)1)
+#define LFL_PTR(word) ((LFNode*)((word) & ~LFL_MARK))
+#define LFL_CACHE_LINE 64
+
+/*
+ * lockFreeList.c
+ *
+ * Implements an ordered singly-linked list that any number of threads can
+ * use at once without locks (Harris' algorithm, with Michael's search).
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH:   O(n)     - Same walk as LinkedList. Finds never write to
+ *             shared memory, so readers do not slow each other down.
+ * - INSERT:   O(n)     - Walk, then one compare-and-swap on the predecessor's
+ *             'next'. A failed CAS (a neighbour changed) re-searches.
+ * - REMOVE:   O(n)     - Two steps: mark the node's own 'next' (logical
+ *             deletion, the point where the remove takes effect), then CAS
+ *             the predecessor past it. Any thread that later walks over a
+ *             marked node finishes that unlink. No thread ever waits for
+ *             another, so a stalled thread cannot block the list.
+ * - MEMORY:   One malloc per node, like a non-pooled LinkedList. Unlinked
+ *             nodes cannot be freed at once, since other threads may still
+ *             be reading them: they are retired and freed by epoch-based
+ *             reclamation once every thread has moved past them.
+ * - Unlike LinkedList, keys are unique: inserting an element equal to one
+ *   already in the list fails, which keeps concurrent inserts of the same
+ *   key well defined.
+ *
+ * EPOCH-BASED RECLAMATION: a global epoch counter, plus one slot per
+ * thread (claimed on first use) that publishes the epoch the thread saw
+ * when it entered its current operation. A node unlinked while the global
+ * epoch is E goes to the unlinking thread's limbo list for E. The epoch
+ * only advances when every thread inside an operation has seen the
+ * current one, so once it reaches E + 2 no thread can still hold a node
+ * retired in E, and that limbo list is freed. Three limbo lists per
+ * thread (E mod 3) are enough.
+ *
+ * ELEMENTS: a non-keyed list calls its CompareFunc on the elements of
+ * nodes that other threads may still be walking, and any find may return
+ * an element that is removed right after. A removed element must outlive
+ * its node, so it is freed by the same reclamation: lfl_set_release makes
+ * the list free removed elements when their node is freed. A thread that
+ * uses a found element wraps the find and the use in lfl_pin/lfl_unpin.
+ */
+
+/*Per-thread reclamation state. Only its owner thread writes the limbo lists*/
+typedef struct{
+    atomic_ulong local;             /*(epoch << 1) | 1 while inside an operation, 0 outside*/
+    atomic_int in_use;
+    LFNode* limbo[3];               /*Retired nodes, by epoch mod 3*/
+    unsigned long limbo_epoch[3];
+    int retired;                    /*Retired since the last advance attempt*/
+    char pad[LFL_CACHE_LINE];       /*Keeps neighbouring slots off the same cache line*/
+}LFLSlot;
+
+static atomic_ulong _lfl_epoch;
+static LFLSlot _lfl_slots[LFL_MAX_THREADS];
+static _Thread_local int _lfl_slot = -1;
+static _Thread_local int _lfl_depth;    /*Nested operations (lfl_pin) of this thread*/
+
+
+/**
+ * @brief (Private) Frees a chain of retired nodes.
+ */
+static void _lfl_free_chain(LFNode* node){
+    while(node != NULL){
+        LFNode* next = node->retired_next;
+        if(node->release != NULL) node->release(node->data);
+        free(node);
+        node = next;
+    }
+}
+
+/**
+ * @brief (Private) Gives the calling thread a reclamation slot.
+ *
+ * A slot released by lfl_thread_exit is reused together with its limbo
+ * lists, which the new owner frees as the epoch advances.
+ *
+ * @return 1 on success, 0 if LFL_MAX_THREADS threads already hold one.
+ */
+static int _lfl_claim_slot(void){
+    for(int i = 0; i < LFL_MAX_THREADS; i++){
+        int expected = 0;
+        if(atomic_compare_exchange_strong(&_lfl_slots[i].in_use, &expected, 1)){
+            _lfl_slot = i;
+            return 1;
+        }
+    }
+    fprintf(stderr, "Error: more than %d threads are using lock-free lists\n", LFL_MAX_THREADS);
+    return 0;
+}
+
+/**
+ * @brief (Private) Starts an operation: publishes the current epoch.
+ *
+ * Inside an lfl_pin section the epoch published by lfl_pin stays in
+ * force, so nothing seen since then can be freed.
+ *
+ * @return The thread's slot, or NULL if no slot is available.
+ */
+static LFLSlot* _lfl_enter(void){
+    if(_lfl_slot < 0 && !_lfl_claim_slot()) return NULL;
+    LFLSlot* slot = &_lfl_slots[_lfl_slot];
+    if(_lfl_depth++ > 0) return slot;
+    unsigned long epoch = atomic_load(&_lfl_epoch);
+    atomic_store(&slot->local, (epoch << 1) | 1UL);
+    atomic_thread_fence(memory_order_seq_cst);
+    return slot;
+}
+
+/**
+ * @brief (Private) Ends an operation: the thread no longer holds any node
+ * (unless an enclosing lfl_pin section is still open).
+ */
+static void _lfl_exit(LFLSlot* slot){
+    if(--_lfl_depth > 0) return;
+    atomic_store_explicit(&slot->local, 0UL, memory_order_release);
+}
+
+/**
+ * @brief (Private) Advances the global epoch if every active thread has seen it,
+ * then frees this thread's limbo lists that are two epochs old.
+ */
+static void _lfl_try_advance(LFLSlot* slot){
+    unsigned long epoch = atomic_load(&_lfl_epoch);
+    int quiescent = 1;
+    for(int i = 0; i < LFL_MAX_THREADS && quiescent; i++){
+        unsigned long local = atomic_load(&_lfl_slots[i].local);
+        if((local & 1UL) && (local >> 1) != epoch) quiescent = 0;
+    }
+    if(quiescent && atomic_compare_exchange_strong(&_lfl_epoch, &epoch, epoch + 1)) epoch++;
+    for(int b = 0; b < 3; b++){
+        if(slot->limbo[b] != NULL && slot->limbo_epoch[b] + 2 <= epoch){
+            _lfl_free_chain(slot->limbo[b]);
+            slot->limbo[b] = NULL;
+        }
+    }
+}
+
+/**
+ * @brief (Private) Hands an unlinked node to the reclamation scheme.
+ *
+ * Only the thread whose CAS unlinked the node retires it, so each node
+ * is retired exactly once. With a release function, its element is
+ * freed together with it.
+ */
+static void _lfl_retire(LockFreeList* list, LFLSlot* slot, LFNode* node){
+    unsigned long epoch = atomic_load(&_lfl_epoch);
+    int bucket = (int)(epoch % 3);
+    if(slot->limbo_epoch[bucket] != epoch){
+        /*Holds nodes from epoch - 3 or older: nobody can reach them anymore*/
+        _lfl_free_chain(slot->limbo[bucket]);
+        slot->limbo[bucket] = NULL;
+        slot->limbo_epoch[bucket] = epoch;
+    }
+    node->retired_next = slot->limbo[bucket];
+    node->release = list->release;
+    slot->limbo[bucket] = node;
+    if(++slot->retired >= LFL_RETIRE_THRESHOLD){
+        slot->retired = 0;
+        _lfl_try_advance(slot);
+    }
+}
+
+/**
+ * @brief (Private) Compares a node with the target (element or key).
+ * @return <0, 0 or >0 as the node orders before, equal to or after the target.
+ */
+static int _lfl_compare(LockFreeList* list, LFNode* node, void* data, long key){
+    if(list->key_of != NULL) return (node->key > key) - (node->key < key);
+    return -list->compare(data, node->data);
+}
+
+/**
+ * @brief (Private) Finds the first unmarked node not ordered before the target.
+ *
+ * Unlinks (and retires) every marked node it meets on the way. If an
+ * unlink CAS fails, the predecessor changed under it: start again from
+ * the head.
+ *
+ * @param prev_out [out] The link pointing to *curr_out.
+ * @param curr_out [out] The node found, or NULL at the end of the list.
+ * @return 1 if *curr_out compares equal to the target, 0 otherwise.
+ */
+static int _lfl_search(LockFreeList* list, LFLSlot* slot, void* data, long key,
+                       _Atomic(uintptr_t)** prev_out, LFNode** curr_out){
+    int restart = 1;
+    while(restart){
+        restart = 0;
+        _Atomic(uintptr_t)* prev = &list->head;
+        LFNode* curr = LFL_PTR(atomic_load_explicit(prev, memory_order_acquire));
+        while(curr != NULL){
+            uintptr_t next = atomic_load_explicit(&curr->next, memory_order_acquire);
+            if(next & LFL_MARK){
+                uintptr_t expected = (uintptr_t)curr;
+                if(!atomic_compare_exchange_strong_explicit(prev, &expected, next & ~LFL_MARK,
+                                                            memory_order_acq_rel, memory_order_acquire)){
+                    restart = 1;
+                    break;
+                }
+                _lfl_retire(list, slot, curr);
+                curr = LFL_PTR(next);
+                continue;
+            }
+            int comparison = _lfl_compare(list, curr, data, key);
+            if(comparison >= 0){
+                *prev_out = prev;
+                *curr_out = curr;
+                return comparison == 0;
+            }
+            prev = &curr->next;
+            curr = LFL_PTR(next);
+        }
+        if(!restart){
+            *prev_out = prev;
+            *curr_out = NULL;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief (Private) Read-only walk: never writes shared memory.
+ *
+ * Marked nodes are walked over (their 'next' no longer changes). A match
+ * that is marked has already been removed.
+ */
+static void* _lfl_find(LockFreeList* list, void* data, long key){
+    LFLSlot* slot = _lfl_enter();
+    if(slot == NULL) return NULL;
+    void* found = NULL;
+    LFNode* curr = LFL_PTR(atomic_load_explicit(&list->head, memory_order_acquire));
+    while(curr != NULL){
+        uintptr_t next = atomic_load_explicit(&curr->next, memory_order_acquire);
+        int comparison = _lfl_compare(list, curr, data, key);
+        if(comparison >= 0){
+            if(comparison == 0 && !(next & LFL_MARK)) found = curr->data;
+            break;
+        }
+        curr = LFL_PTR(next);
+    }
+    _lfl_exit(slot);
+    return found;
+}
+
+
+/**
+ * @brief Creates a new, empty lock-free list.
+ *
+ * Searches call 'compare_func' on elements other threads may be removing:
+ * removed elements must not be freed by the caller while other threads
+ * use the list (see lfl_set_release).
+ *
+ * @param compare_func A function pointer used to compare elements.
+ * @return A pointer to the new LockFreeList, or NULL if memory fails.
+ */
+LockFreeList* lfl_create(CompareFunc compare_func){
+    LockFreeList* list = (LockFreeList*)malloc(sizeof(LockFreeList));
+    if(list == NULL) return NULL;
+    atomic_init(&list->head, (uintptr_t)0);
+    atomic_init(&list->counter, 0);
+    list->compare = compare_func;
+    list->key_of = NULL;
+    list->release = NULL;
+    return list;
+}
+
+/**
+ * @brief Creates a new, empty lock-free list in keyed mode.
+ *
+ * Every node stores its element's long key, and traversals compare that
+ * inline key instead of calling a CompareFunc (see list_create_keyed).
+ *
+ * @param key_func Extracts the long key of an element.
+ * @return A pointer to the new LockFreeList, or NULL on failure.
+ */
+LockFreeList* lfl_create_keyed(KeyFunc key_func){
+    if(key_func == NULL) return NULL;
+    LockFreeList* list = lfl_create(NULL);
+    if(list != NULL) list->key_of = key_func;
+    return list;
+}
+
+/**
+ * @brief Frees the list and every node still linked (not the elements).
+ *
+ * No other thread may be using the list. Nodes already retired belong to
+ * the reclamation scheme (see lfl_collect).
+ *
+ * @param list The list to free.
+ */
+void lfl_free(LockFreeList* list){
+    if(list == NULL) return;
+    LFNode* node = LFL_PTR(atomic_load(&list->head));
+    while(node != NULL){
+        LFNode* next = LFL_PTR(atomic_load(&node->next));
+        free(node);
+        node = next;
+    }
+    free(list);
+}
+
+/**
+ * @brief Inserts an element in order. Safe to call from any thread.
+ *
+ * @param list The list to insert into.
+ * @param data The element to insert.
+ * @return 1 on success, 0 if an equal element is present, memory fails
+ * or the calling thread gets no reclamation slot (more than
+ * LFL_MAX_THREADS threads; reported on stderr).
+ */
+int lfl_insert_sorted(LockFreeList* list, void* data){
+    if(list == NULL) return 0;
+    LFNode* node = (LFNode*)malloc(sizeof(LFNode));
+    if(node == NULL) return 0;
+    node->data = data;
+    node->key = list->key_of != NULL ? list->key_of(data) : 0;
+    node->retired_next = NULL;
+    LFLSlot* slot = _lfl_enter();
+    if(slot == NULL){
+        free(node);
+        return 0;
+    }
+    int inserted = 0;
+    _Atomic(uintptr_t)* prev;
+    LFNode* curr;
+    while(!_lfl_search(list, slot, data, node->key, &prev, &curr)){
+        atomic_store_explicit(&node->next, (uintptr_t)curr, memory_order_relaxed);
+        uintptr_t expected = (uintptr_t)curr;
+        if(atomic_compare_exchange_strong_explicit(prev, &expected, (uintptr_t)node,
+                                                   memory_order_acq_rel, memory_order_acquire)){
+            inserted = 1;
+            break;
+        }
+    }
+    _lfl_exit(slot);
+    if(inserted) atomic_fetch_add(&list->counter, 1);
+    else free(node);
+    return inserted;
+}
+
+/**
+ * @brief Removes an element. Safe to call from any thread.
+ *
+ * When several threads remove the same element, exactly one of them (the
+ * one whose mark succeeds) gets it back.
+ *
+ * Other threads may still be reading the element (a non-keyed list
+ * compares it). With a release function the list frees it once none can
+ * be; otherwise the caller may free it only when no other thread is using
+ * the list (e.g. after joining them).
+ *
+ * @param list The list to remove from.
+ * @param data_to_remove A "template" element holding the key.
+ * @return The removed element, or NULL if not found or the calling
+ * thread gets no reclamation slot (more than LFL_MAX_THREADS threads).
+ * With a release function, dereference it only inside the lfl_pin
+ * section the call was made in.
+ */
+void* lfl_remove(LockFreeList* list, void* data_to_remove){
+    if(list == NULL) return NULL;
+    LFLSlot* slot = _lfl_enter();
+    if(slot == NULL) return NULL;
+    long key = list->key_of != NULL ? list->key_of(data_to_remove) : 0;
+    void* removed = NULL;
+    _Atomic(uintptr_t)* prev;
+    LFNode* curr;
+    while(_lfl_search(list, slot, data_to_remove, key, &prev, &curr)){
+        uintptr_t next = atomic_load_explicit(&curr->next, memory_order_acquire);
+        if(next & LFL_MARK) continue;
+        if(!atomic_compare_exchange_strong_explicit(&curr->next, &next, next | LFL_MARK,
+                                                    memory_order_acq_rel, memory_order_acquire)) continue;
+        removed = curr->data;
+        uintptr_t expected = (uintptr_t)curr;
+        if(atomic_compare_exchange_strong_explicit(prev, &expected, next,
+                                                   memory_order_acq_rel, memory_order_acquire)){
+            _lfl_retire(list, slot, curr);
+        }
+        else _lfl_search(list, slot, data_to_remove, key, &prev, &curr);
+        break;
+    }
+    _lfl_exit(slot);
+    if(removed != NULL) atomic_fetch_sub(&list->counter, 1);
+    return removed;
+}
+
+/**
+ * @brief Finds an element. Safe to call from any thread; never blocks writers.
+ *
+ * With a release function, wrap the call and every use of its result in
+ * lfl_pin/lfl_unpin: a concurrent remove may free the element otherwise.
+ *
+ * @param list The list to search in.
+ * @param data_to_find A "template" element holding the key.
+ * @return The element, or NULL if not found or the calling thread gets no
+ * reclamation slot (more than LFL_MAX_THREADS threads).
+ */
+void* lfl_find(LockFreeList* list, void* data_to_find){
+    if(list == NULL) return NULL;
+    long key = list->key_of != NULL ? list->key_of(data_to_find) : 0;
+    return _lfl_find(list, data_to_find, key);
+}
+
+/**
+ * @brief Finds an element by key (keyed mode only).
+ *
+ * @param list The list to search in.
+ * @param key The key to look up.
+ * @return The element, or NULL if not found, the list is not keyed or
+ * the calling thread gets no reclamation slot (see lfl_find).
+ */
+void* lfl_find_key(LockFreeList* list, long key){
+    if(list == NULL || list->key_of == NULL) return NULL;
+    return _lfl_find(list, NULL, key);
+}
+
+/**
+ * @brief Returns the number of elements (exact once writers are done).
+ */
+int lfl_count(LockFreeList* list){
+    if(list == NULL) return 0;
+    return atomic_load(&list->counter);
+}
+
+/**
+ * @brief Prints every element that is not logically deleted, in order.
+ *
+ * @param list The list to print.
+ * @param print_func The function used to print one element.
+ */
+void lfl_print(LockFreeList* list, PrintFunc print_func){
+    if(list == NULL || print_func == NULL) return;
+    LFLSlot* slot = _lfl_enter();
+    if(slot == NULL) return;
+    LFNode* curr = LFL_PTR(atomic_load_explicit(&list->head, memory_order_acquire));
+    while(curr != NULL){
+        uintptr_t next = atomic_load_explicit(&curr->next, memory_order_acquire);
+        if(!(next & LFL_MARK)) print_func(curr->data);
+        curr = LFL_PTR(next);
+    }
+    _lfl_exit(slot);
+}
+
+/**
+ * @brief Checks the list's invariants. Call only while no thread modifies it.
+ *
+ * @param list The list to check.
+ * @return 1 if the live elements are strictly increasing and their number
+ * matches the counter, 0 otherwise.
+ */
+int lfl_validate(LockFreeList* list){
+    if(list == NULL) return 0;
+    int live = 0;
+    LFNode* previous = NULL;
+    LFNode* curr = LFL_PTR(atomic_load(&list->head));
+    while(curr != NULL){
+        uintptr_t next = atomic_load(&curr->next);
+        if(!(next & LFL_MARK)){
+            if(previous != NULL && _lfl_compare(list, previous, curr->data, curr->key) >= 0) return 0;
+            previous = curr;
+            live++;
+        }
+        curr = LFL_PTR(next);
+    }
+    return live == atomic_load(&list->counter);
+}
+
+/**
+ * @brief Makes the list free removed elements through the reclamation scheme.
+ *
+ * Call it before other threads use the list. Afterwards every element
+ * leaving the list by lfl_remove is passed to 'release_func' once no
+ * thread can still read it, in the same epoch as its node (lfl_collect
+ * frees the remaining ones). Elements still linked when lfl_free runs
+ * remain the caller's.
+ *
+ * @param list The list to configure.
+ * @param release_func Frees one element (e.g. student_free), or NULL to
+ * leave removed elements to the caller.
+ */
+void lfl_set_release(LockFreeList* list, FreeFunc release_func){
+    if(list != NULL) list->release = release_func;
+}
+
+/**
+ * @brief Opens a section in which nothing the calling thread finds is freed.
+ *
+ * Elements returned by lfl_find/lfl_find_key/lfl_remove stay valid until
+ * the matching lfl_unpin, even if another thread removes them. Sections
+ * nest. Keep them short: while one is open, no retired node of any thread
+ * can be freed.
+ *
+ * @return 1 on success, 0 if the calling thread gets no reclamation slot
+ * (more than LFL_MAX_THREADS threads; do not call lfl_unpin then).
+ */
+int lfl_pin(void){
+    return _lfl_enter() != NULL;
+}
+
+/**
+ * @brief Closes the section opened by the matching lfl_pin.
+ */
+void lfl_unpin(void){
+    if(_lfl_slot < 0 || _lfl_depth == 0) return;
+    _lfl_exit(&_lfl_slots[_lfl_slot]);
+}
+
+/**
+ * @brief Releases the calling thread's reclamation slot.
+ *
+ * Call it before a thread that used lock-free lists terminates, so that
+ * more than LFL_MAX_THREADS threads can use them over the program's life.
+ * Its pending retired nodes are inherited by the next owner of the slot.
+ * Not to be called inside an lfl_pin section.
+ */
+void lfl_thread_exit(void){
+    if(_lfl_slot < 0) return;
+    atomic_store(&_lfl_slots[_lfl_slot].in_use, 0);
+    _lfl_slot = -1;
+}
+
+/**
+ * @brief Frees every retired node of every thread.
+ *
+ * Call it only while no thread is inside a lock-free list operation (for
+ * instance after joining the workers), typically before exiting. Removed
+ * elements of lists with a release function are freed with their nodes.
+ */
+void lfl_collect(void){
+    for(int i = 0; i < LFL_MAX_THREADS; i++){
+        for(int b = 0; b < 3; b++){
+            _lfl_free_chain(_lfl_slots[i].limbo[b]);
+            _lfl_slots[i].limbo[b] = NULL;
+        }
+        _lfl_slots[i].retired = 0;
+    }
+}
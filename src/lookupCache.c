@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "lookupCache.h"
+
+/*
+ * lookupCache.c
+ *
+ * Implements a set-associative CLOCK cache from an element's long key to
+ * the element. OrderedArray and LinkedList put one in front of their
+ * single-key finds (oa_attach_lookup_cache, list_attach_lookup_cache): a
+ * hit skips the binary search or the list walk, a miss falls through to
+ * the container and stores what it found.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - LOOKUP: O(LC_WAYS) - One hash, then up to 8 key compares in a single
+ *           cache line. Misses cost the same on top of the container's
+ *           own search.
+ * - STORE:  O(LC_WAYS) - A free way of the set, or the CLOCK victim (the
+ *           hand passes every way at most twice).
+ * - POLICY: CLOCK approximates LRU with one bit per slot and no list to
+ *           reorder on hits, so hits only set a bit. Hot keys of a skewed
+ *           (e.g. Zipfian) workload stay cached; uniform workloads larger
+ *           than the cache mostly miss and pay the extra probe.
+ * - MEMORY: Fixed. 16 bytes per slot plus 3 bytes per set, chosen at
+ *           creation and never resized.
+ */
+
+
+/**
+ * @brief (Private) Set that 'key' maps to (Fibonacci hashing, top bits).
+ */
+static int _lc_set_of(LookupCache* cache, long key){
+    unsigned long long hash = (unsigned long long)key * 0x9E3779B97F4A7C15ULL;
+    return (int)((hash >> 32) & (unsigned long long)(cache->sets - 1));
+}
+
+/**
+ * @brief (Private) Way of set 'set' that holds 'key'.
+ *
+ * @return The way, or -1 if the key is not cached.
+ */
+static int _lc_way_of(LookupCache* cache, int set, long key){
+    const long* keys = &cache->keys[set * LC_WAYS];
+    uint8_t valid = cache->state[set].valid;
+    for(int way = 0; way < LC_WAYS; way++){
+        if((valid & (1u << way)) && keys[way] == key) return way;
+    }
+    return -1;
+}
+
+/**
+ * @brief Creates an empty cache.
+ *
+ * @param slots Number of cached elements, rounded up to a power-of-two
+ * number of sets of LC_WAYS slots (<= 0: LC_DEFAULT_SLOTS).
+ * @param key_func Extracts an element's key (e.g. product_get_id).
+ * @return A pointer to the new cache, or NULL if there is no key
+ * function or memory fails.
+ */
+LookupCache* lc_create(int slots, KeyFunc key_func){
+    if(key_func == NULL) return NULL;
+    if(slots <= 0) slots = LC_DEFAULT_SLOTS;
+    int sets = 1;
+    while(sets * LC_WAYS < slots && sets < (1 << 24)) sets *= 2;
+    LookupCache* cache = (LookupCache*)malloc(sizeof(LookupCache));
+    if(cache == NULL) return NULL;
+    cache->keys = (long*)malloc((size_t)sets * LC_WAYS * sizeof(long));
+    cache->values = (void**)malloc((size_t)sets * LC_WAYS * sizeof(void*));
+    cache->state = (LCSet*)calloc((size_t)sets, sizeof(LCSet));
+    if(cache->keys == NULL || cache->values == NULL || cache->state == NULL){
+        lc_free(cache);
+        return NULL;
+    }
+    cache->sets = sets;
+    cache->key_of = key_func;
+    lc_reset_counters(cache);
+    return cache;
+}
+
+/**
+ * @brief Frees the cache (not the cached elements).
+ */
+void lc_free(LookupCache* cache){
+    if(cache == NULL) return;
+    free(cache->keys);
+    free(cache->values);
+    free(cache->state);
+    free(cache);
+}
+
+/**
+ * @brief Looks a key up, counting a hit or a miss.
+ *
+ * @param cache The cache to search in.
+ * @param key The key to search for.
+ * @return The cached element, or NULL if the key is not cached.
+ */
+void* lc_find(LookupCache* cache, long key){
+    if(cache == NULL) return NULL;
+    int set = _lc_set_of(cache, key);
+    int way = _lc_way_of(cache, set, key);
+    if(way < 0){
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    cache->state[set].referenced |= (uint8_t)(1u << way);
+    return cache->values[set * LC_WAYS + way];
+}
+
+/**
+ * @brief Caches an element under its key, evicting with CLOCK if its set is full.
+ *
+ * An element already cached under the same key is replaced.
+ *
+ * @param cache The cache to store in.
+ * @param data The element (typically just found in the container).
+ * @return 1 on success, 0 on invalid arguments.
+ */
+int lc_store(LookupCache* cache, void* data){
+    if(cache == NULL || data == NULL) return 0;
+    long key = cache->key_of(data);
+    int set = _lc_set_of(cache, key);
+    LCSet* state = &cache->state[set];
+    int way = _lc_way_of(cache, set, key);
+    if(way < 0 && state->valid != 0xFF){
+        for(way = 0; state->valid & (1u << way); way++);
+    }
+    else if(way < 0){
+        while(state->referenced & (1u << state->hand)){
+            state->referenced &= (uint8_t)~(1u << state->hand);
+            state->hand = (uint8_t)((state->hand + 1) % LC_WAYS);
+        }
+        way = state->hand;
+        state->hand = (uint8_t)((state->hand + 1) % LC_WAYS);
+        cache->evictions++;
+    }
+    cache->keys[set * LC_WAYS + way] = key;
+    cache->values[set * LC_WAYS + way] = data;
+    state->valid |= (uint8_t)(1u << way);
+    state->referenced &= (uint8_t)~(1u << way);
+    return 1;
+}
+
+/**
+ * @brief Drops a key from the cache (e.g. its element was removed).
+ *
+ * @param cache The cache to update.
+ * @param key The key to drop.
+ * @return 1 if the key was cached, 0 otherwise.
+ */
+int lc_invalidate(LookupCache* cache, long key){
+    if(cache == NULL) return 0;
+    int set = _lc_set_of(cache, key);
+    int way = _lc_way_of(cache, set, key);
+    if(way < 0) return 0;
+    cache->state[set].valid &= (uint8_t)~(1u << way);
+    cache->state[set].referenced &= (uint8_t)~(1u << way);
+    return 1;
+}
+
+/**
+ * @brief Drops every cached element (counters are kept).
+ */
+void lc_clear(LookupCache* cache){
+    if(cache == NULL) return;
+    memset(cache->state, 0, (size_t)cache->sets * sizeof(LCSet));
+}
+
+/**
+ * @brief Zeroes the hit, miss and eviction counters.
+ */
+void lc_reset_counters(LookupCache* cache){
+    if(cache == NULL) return;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
+
+/**
+ * @brief Fraction of lookups answered by the cache.
+ *
+ * @return hits / (hits + misses), or 0 if nothing was looked up.
+ */
+double lc_hit_rate(LookupCache* cache){
+    if(cache == NULL || cache->hits + cache->misses == 0) return 0.0;
+    return (double)cache->hits / (double)(cache->hits + cache->misses);
+}
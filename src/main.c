@@ -5,10 +5,12 @@
 #include "linkedList.h"
 #include "student.h"
 #include "product.h"
+#include "csvLoader.h"
+#include "recordArena.h"
 
 /* --- FUNCTION PROTOTYPES --- */
-void load_students(OrderedArray* db, const char* filename);
-void load_products(LinkedList* db, const char* filename);
+void load_students(OrderedArray* db, RecordArena* records, const char* filename);
+void load_products(LinkedList* db, RecordArena* records, const char* filename);
 void cleanup_students(OrderedArray* db);
 void cleanup_products(LinkedList* db);
 
@@ -16,17 +18,21 @@ int main() {
     printf("Initializing trade-offs test...\n\n");
 
     /* --- CREATION --- */
-    OrderedArray* student_db = oa_create(100, student_compare_by_id);
+    OrderedArray* student_db = oa_create(4, student_compare_by_id);
     LinkedList* product_db = list_create(product_compare_by_id);
+    /* Every student and product lives here, and goes away with one ra_free */
+    RecordArena* records = ra_create(0);
 
-    if (student_db == NULL || product_db == NULL) {
+    if (student_db == NULL || product_db == NULL || records == NULL) {
         printf("Fatal ERROR: Couldn't create the database\n");
         return 1;
     }
+    /* The roster grows on demand instead of dropping rows once full */
+    oa_set_growth(student_db, 1, 0.25f);
 
     /* --- FILE LOADING --- */
-    load_students(student_db, "data/students.csv");
-    load_products(product_db, "data/products.csv");
+    load_students(student_db, records, "data/students.csv");
+    load_products(product_db, records, "data/products.csv");
 
     printf("\n--- INITIAL LOADING COMPLETE ---\n");
 
@@ -38,13 +44,13 @@ int main() {
     printf("\n--- INITIALIZING STRESS TEST ---\n");
 
     printf("Inserting 'Zoe (ID 50)' (at beginning)...\n");
-    oa_insert_sorted(student_db, student_create(50, "Zoe (First)", 9.9));
+    oa_insert_sorted(student_db, student_create_in(records, 50, "Zoe (First)", 9.9));
 
     printf("Inserting 'Alex (ID 500)' (at final)...\n");
-    oa_insert_sorted(student_db, student_create(500, "Alex (Final)", 6.0));
+    oa_insert_sorted(student_db, student_create_in(records, 500, "Alex (Final)", 6.0));
 
     printf("Inserting 'Pedro (ID 103)' (at the middle)...\n");
-    oa_insert_sorted(student_db, student_create(103, "Pedro (Middle)", 7.5));
+    oa_insert_sorted(student_db, student_create_in(records, 103, "Pedro (Middle)", 7.5));
 
     printf("Eliminating 'Juan (ID 101)' (From the middle)...\n");
 
@@ -55,7 +61,6 @@ int main() {
 
         if (data_borrada != NULL) {
             printf("  -> Success at eliminating %s\n", data_borrada->name);
-            student_free(data_borrada);
         }
         student_free(plantilla_juan);
     }
@@ -68,7 +73,6 @@ int main() {
 
         if (data_borrada_lista != NULL) {
             printf("  -> Success at eliminating: %s\n", data_borrada_lista->name);
-            product_free(data_borrada_lista);
         }
         product_free(plantilla_teclado);
     }
@@ -82,96 +86,57 @@ int main() {
     printf("\nInitializing memory cleanse...\n");
     cleanup_students(student_db);
     cleanup_products(product_db);
+    printf("Releasing %zu bytes of records and names (%zu distinct names)...\n",
+           records->bytes_used, records->name_count);
+    ra_free(records);
 
     printf("Cleanse complete.\n");
     return 0;
 }
 
-void load_students(OrderedArray* db, const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("Error: Couldn't open the file %s\n", filename);
-        return;
-    }
+void load_students(OrderedArray* db, RecordArena* records, const char* filename) {
     printf("Loading students from %s...\n", filename);
 
-    char line_buffer[256];
-    while (fgets(line_buffer, sizeof(line_buffer), file) != NULL) {
-        long id;
-        char name[100];
-        float gpa;
-
-        int items_matched = sscanf(line_buffer, " %ld ,%[^,] ,%f ", &id, name, &gpa);
-
-        if (items_matched == 3) {
-            Student* newStudent = student_create(id, name, gpa);
-            if (newStudent != NULL) {
-                int result = oa_insert_sorted(db, newStudent);
-                if (result == 0) {
-                    printf("Array's full. Couldn't insert %s\n", name);
-                    free(newStudent);
-                }
-            }
-        }
+    /* The whole file is parsed at once and inserted with one sorted merge (O(N log N)) */
+    int loaded = 0;
+    void** batch = csv_load_students_in(records, filename, &loaded, NULL);
+    if (batch == NULL) return;
+
+    int inserted = oa_insert_batch(db, batch, loaded);
+    for (int i = inserted; i < loaded; i++) {
+        Student* rejected = (Student*)batch[i];
+        printf("Couldn't insert %s (duplicate id or out of memory)\n", rejected->name);
     }
-    fclose(file);
+    free(batch);
     printf("Students loading complete.\n");
 }
 
-void load_products(LinkedList* db, const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("Error: Couldn't open the file %s\n", filename);
-        return;
-    }
+void load_products(LinkedList* db, RecordArena* records, const char* filename) {
     printf("Loading products from %s...\n", filename);
 
-    char line_buffer[256];
-    while (fgets(line_buffer, sizeof(line_buffer), file) != NULL) {
-        long id;
-        char name[100];
-        float price, cost;
-        long int stock;
-
-        int items_matched = sscanf(line_buffer, " %ld ,%[^,] ,%f ,%f ,%ld ",
-                                   &id, name, &price, &cost, &stock);
-
-        if (items_matched == 5) {
-            Product* newProduct = product_create(id, name, price, cost, stock);
-            if (newProduct != NULL) {
-                int result = list_insert_sorted(db, newProduct);
-                if (result == 0) {
-                    printf("Memory error %s\n", name);
-                    free(newProduct);
-                }
-            }
-        }
+    int loaded = 0;
+    void** batch = csv_load_products_in(records, filename, &loaded, NULL);
+    if (batch == NULL) return;
+
+    int inserted = list_insert_batch(db, batch, loaded);
+    for (int i = inserted; i < loaded; i++) {
+        Product* rejected = (Product*)batch[i];
+        printf("Memory error %s\n", rejected->name);
     }
-    fclose(file);
+    free(batch);
     printf("Products loading complete.\n");
 }
 
+/* The students themselves belong to the RecordArena: only the array is freed */
 void cleanup_students(OrderedArray* db) {
     if (db == NULL) return;
-    for (int i = 0; i < db->counter; i++) {
-        if (db->data[i] != NULL) {
-            student_free(db->data[i]);
-        }
-    }
     oa_free(db);
     printf("Students database freed.\n");
 }
 
+/* Same for the products: only the nodes are freed */
 void cleanup_products(LinkedList* db) {
     if (db == NULL) return;
-
-    Node* current = db->head;
-    while (current != NULL) {
-        if (current->data != NULL) {
-            product_free(current->data);
-        }
-        current = current->next;
-    }
     list_free(db);
     printf("Products database freed.\n");
 }
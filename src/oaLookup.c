@@ -0,0 +1,262 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include "oaLookup.h"
+
+/*
+ * oaLookup.c
+ *
+ * Read-optimized lookup engine for an OrderedArray. oal_build copies the
+ * array's keys into a contiguous long long array, so searches never chase
+ * element pointers or call a CompareFunc, and offers three kernels:
+ *
+ * - BRANCHLESS: binary search where every step is a conditional move,
+ *   so random keys cause no branch mispredictions.
+ * - EYTZINGER:  keys stored in BFS order (children of k at 2k and 2k+1).
+ *   The next levels of a search are contiguous, so they are prefetched
+ *   while the current level is compared.
+ * - SIMD:       branchless narrowing down to OAL_BLOCK keys, then one
+ *   vectorized pass (AVX2 or SSE4.2, picked at runtime) that counts the
+ *   keys smaller than the target.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH: O(log n), with fewer mispredictions and cache misses than
+ *           oa_find_binary.
+ * - UPDATE: Not supported. The snapshot must be rebuilt (O(n)) after the
+ *           array changes.
+ * - MEMORY: 16 bytes per element (key + element pointer), 32 with the
+ *           Eytzinger copy.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OAL_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define OAL_PREFETCH(address) __builtin_prefetch((const void*)(address))
+#else
+#define OAL_PREFETCH(address) ((void)0)
+#endif
+
+
+/**
+ * @brief (Private) Branch-free lower bound over 'count' sorted keys.
+ *
+ * Every iteration halves the range with a conditional move instead of a
+ * jump. Stops once the range is at most 'stop' keys long.
+ *
+ * @return The first key of the remaining range.
+ */
+static const long long* _oal_narrow(const long long* base, int count, long long key, int stop){
+    while(count > stop){
+        int half = count / 2;
+        base = (base[half] < key) ? base + half : base;
+        count -= half;
+    }
+    return base;
+}
+
+static void* _oal_find_branchless(OALookup* lookup, long key){
+    if(lookup->count == 0) return NULL;
+    const long long* base = _oal_narrow(lookup->keys, lookup->count, key, 1);
+    int index = (int)(base - lookup->keys) + (*base < key);
+    if(index < lookup->count && lookup->keys[index] == key) return lookup->values[index];
+    return NULL;
+}
+
+static void* _oal_find_eytzinger(OALookup* lookup, long key){
+    const long long* keys = lookup->eytz_keys;
+    size_t n = (size_t)lookup->count;
+    size_t k = 1;
+    while(k <= n){
+        /* 8 keys per cache line: the line holding the node 3 levels down */
+        OAL_PREFETCH((uintptr_t)keys + k * 8 * sizeof(long long));
+        k = 2 * k + (size_t)(keys[k] < key);
+    }
+    /* Undo the trailing right turns (and the last left turn) */
+#if defined(__GNUC__)
+    k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+#else
+    while(k & 1) k >>= 1;
+    k >>= 1;
+#endif
+    if(k != 0 && keys[k] == key) return lookup->eytz_values[k];
+    return NULL;
+}
+
+/**
+ * @brief (Private) Portable version of the SIMD kernel's final block scan.
+ */
+static void* _oal_find_block_scalar(OALookup* lookup, long key){
+    if(lookup->count == 0) return NULL;
+    const long long* base = _oal_narrow(lookup->keys, lookup->count, key, OAL_BLOCK);
+    int less = 0;
+    for(int i = 0; i < OAL_BLOCK; i++) less += base[i] < key;
+    int index = (int)(base - lookup->keys) + less;
+    if(index < lookup->count && lookup->keys[index] == key) return lookup->values[index];
+    return NULL;
+}
+
+#ifdef OAL_X86_DISPATCH
+__attribute__((target("sse4.2")))
+static void* _oal_find_block_sse42(OALookup* lookup, long key){
+    if(lookup->count == 0) return NULL;
+    const long long* base = _oal_narrow(lookup->keys, lookup->count, key, OAL_BLOCK);
+    __m128i target = _mm_set1_epi64x(key);
+    int less = 0;
+    for(int i = 0; i < OAL_BLOCK; i += 2){
+        __m128i block = _mm_loadu_si128((const __m128i*)(base + i));
+        __m128i smaller = _mm_cmpgt_epi64(target, block);
+        less += __builtin_popcount((unsigned)_mm_movemask_pd(_mm_castsi128_pd(smaller)));
+    }
+    int index = (int)(base - lookup->keys) + less;
+    if(index < lookup->count && lookup->keys[index] == key) return lookup->values[index];
+    return NULL;
+}
+
+__attribute__((target("avx2")))
+static void* _oal_find_block_avx2(OALookup* lookup, long key){
+    if(lookup->count == 0) return NULL;
+    const long long* base = _oal_narrow(lookup->keys, lookup->count, key, OAL_BLOCK);
+    __m256i target = _mm256_set1_epi64x(key);
+    int less = 0;
+    for(int i = 0; i < OAL_BLOCK; i += 4){
+        __m256i block = _mm256_loadu_si256((const __m256i*)(base + i));
+        __m256i smaller = _mm256_cmpgt_epi64(target, block);
+        less += __builtin_popcount((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(smaller)));
+    }
+    int index = (int)(base - lookup->keys) + less;
+    if(index < lookup->count && lookup->keys[index] == key) return lookup->values[index];
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Detects the best SIMD instruction set supported by this CPU.
+ *
+ * @return OAL_SIMD_AVX2, OAL_SIMD_SSE42, or OAL_SIMD_SCALAR when neither
+ * is available (or the compiler cannot target them).
+ */
+SimdLevel oal_cpu_simd_level(void){
+#ifdef OAL_X86_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return OAL_SIMD_AVX2;
+    if(__builtin_cpu_supports("sse4.2")) return OAL_SIMD_SSE42;
+#endif
+    return OAL_SIMD_SCALAR;
+}
+
+/**
+ * @brief Returns a printable name for a lookup kind.
+ */
+const char* oal_kind_name(LookupKind kind){
+    switch(kind){
+    case OAL_BRANCHLESS: return "branchless";
+    case OAL_EYTZINGER: return "eytzinger";
+    case OAL_SIMD: return "simd";
+    default: return "auto";
+    }
+}
+
+/**
+ * @brief (Private) Copies sorted keys into BFS order (in-order walk of the implicit tree).
+ *
+ * @return The next unread position of the sorted input.
+ */
+static int _oal_eytzinger_fill(OALookup* lookup, int i, size_t k){
+    if(k <= (size_t)lookup->count){
+        i = _oal_eytzinger_fill(lookup, i, 2 * k);
+        lookup->eytz_keys[k] = lookup->keys[i];
+        lookup->eytz_values[k] = lookup->values[i];
+        i++;
+        i = _oal_eytzinger_fill(lookup, i, 2 * k + 1);
+    }
+    return i;
+}
+
+/**
+ * @brief Builds a read-only lookup snapshot of an OrderedArray.
+ *
+ * The keys are taken from the array itself in keyed mode, otherwise from
+ * 'key_func' applied to every element; either way the key order must
+ * match the array's order (e.g. student_get_id with student_compare_by_id).
+ *
+ * @param arr The array to snapshot.
+ * @param key_func Extracts an element's key (may be NULL for keyed arrays).
+ * @param kind The kernel to use, or OAL_AUTO.
+ * @return A pointer to the new OALookup, or NULL on invalid arguments
+ * or if memory fails.
+ */
+OALookup* oal_build(OrderedArray* arr, KeyFunc key_func, LookupKind kind){
+    if(arr == NULL || (arr->keys == NULL && key_func == NULL)) return NULL;
+    OALookup* lookup = (OALookup*)calloc(1, sizeof(OALookup));
+    if(lookup == NULL) return NULL;
+    int n = arr->counter;
+    lookup->count = n;
+    lookup->simd = oal_cpu_simd_level();
+    lookup->keys = (long long*)malloc(((size_t)n + OAL_BLOCK) * sizeof(long long));
+    lookup->values = (void**)malloc(((size_t)n + 1) * sizeof(void*));
+    if(lookup->keys == NULL || lookup->values == NULL){
+        oal_free(lookup);
+        return NULL;
+    }
+    for(int i = 0; i < n; i++){
+        lookup->keys[i] = arr->keys != NULL ? arr->keys[i] : key_func(arr->data[i]);
+        lookup->values[i] = arr->data[i];
+    }
+    /* Sentinels: the block scan may read past the last key */
+    for(int i = 0; i < OAL_BLOCK; i++) lookup->keys[n + i] = LLONG_MAX;
+
+    if(kind == OAL_AUTO){
+        if(n >= OAL_EYTZINGER_THRESHOLD) kind = OAL_EYTZINGER;
+        else kind = lookup->simd != OAL_SIMD_SCALAR ? OAL_SIMD : OAL_BRANCHLESS;
+    }
+    lookup->kind = kind;
+    if(kind == OAL_EYTZINGER){
+        lookup->eytz_keys = (long long*)malloc(((size_t)n + 1) * sizeof(long long));
+        lookup->eytz_values = (void**)malloc(((size_t)n + 1) * sizeof(void*));
+        if(lookup->eytz_keys == NULL || lookup->eytz_values == NULL){
+            oal_free(lookup);
+            return NULL;
+        }
+        lookup->eytz_keys[0] = LLONG_MIN;
+        lookup->eytz_values[0] = NULL;
+        _oal_eytzinger_fill(lookup, 0, 1);
+        lookup->find = _oal_find_eytzinger;
+    }
+    else if(kind == OAL_SIMD){
+        lookup->find = _oal_find_block_scalar;
+#ifdef OAL_X86_DISPATCH
+        if(lookup->simd == OAL_SIMD_AVX2) lookup->find = _oal_find_block_avx2;
+        else if(lookup->simd == OAL_SIMD_SSE42) lookup->find = _oal_find_block_sse42;
+#endif
+    }
+    else lookup->find = _oal_find_branchless;
+    return lookup;
+}
+
+/**
+ * @brief Frees the lookup snapshot (not the array or its elements).
+ */
+void oal_free(OALookup* lookup){
+    if(lookup == NULL) return;
+    free(lookup->keys);
+    free(lookup->values);
+    free(lookup->eytz_keys);
+    free(lookup->eytz_values);
+    free(lookup);
+}
+
+/**
+ * @brief Finds an element by key with the snapshot's kernel.
+ *
+ * @param lookup The snapshot built by oal_build.
+ * @param key The key to search for.
+ * @return A pointer to the element if found, or NULL otherwise.
+ */
+void* oal_find(OALookup* lookup, long key){
+    if(lookup == NULL) return NULL;
+    return lookup->find(lookup, key);
+}
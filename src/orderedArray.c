@@ -1,17 +1,65 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
 #include "orderedArray.h"
+#include "hashIndex.h"
+#include "lookupCache.h"
+#include "secondaryIndex.h"
+#include "containerStats.h"
+
+#if defined(__GNUC__)
+#define OA_PREFETCH(address) __builtin_prefetch((const void*)(address))
+#else
+#define OA_PREFETCH(address) ((void)0)
+#endif
+
+/*Binary searches interleaved by oa_find_batch*/
+#define OA_BATCH_LANES 8
 
 /*
  * orderedArray.c
  *
- * Implements a generic, fixed-capacity ordered array
+ * Implements a generic ordered array. Fixed-capacity by default, with an
+ * opt-in geometric growth policy (oa_set_growth).
  *
  * TRADE-OFF ANALYSIS:
  * - SEARCH: O(log n) - Uses binary search (_oa_find_index).
- * - INSERT: O(n) - Must perform a linear shift to make space.
- * - REMOVE: O(n) - Must perform a linear shift to close gaps.
+ * - INSERT: O(n) - Must perform a linear shift to make space (one memmove).
+ * - REMOVE: O(n) - Must perform a linear shift to close gaps (one memmove).
+ * - BATCH:  O(m log m + n) - oa_insert_batch/oa_remove_batch sort the batch
+ *           and merge it with the array in a single linear pass.
+ *           oa_append_sorted takes an already sorted run in O(m).
+ *           oa_find_batch runs OA_BATCH_LANES binary searches in lockstep,
+ *           so their cache misses overlap instead of being paid one by one.
+ * - RANGE:  O(log n + k) - oa_range and oa_lower_bound binary-search the
+ *           start, then walk k consecutive slots (OACursor moves both ways).
  * - MEMORY: Static (Fixed-capacity). Simple, but limited.
+ *           When growable: capacity doubles on demand, so inserts are
+ *           amortized O(1) in reallocation cost.
+ *
+ * KEYED MODE (oa_create_keyed): the array also keeps each element's long
+ * key in a parallel 'keys' array. Searches compare those keys directly,
+ * without the indirect CompareFunc call and without touching the
+ * elements, which are only dereferenced once a match is found.
+ *
+ * HASH INDEX (oa_attach_hash_index): an optional HashIndex from each
+ * element's key to the element, kept in step by every insert and remove.
+ * Exact-key finds become O(1) expected; ordered operations (cursors,
+ * ranges) still use the sorted array.
+ *
+ * LOOKUP CACHE (oa_attach_lookup_cache): an optional LookupCache of
+ * recently found elements in front of oa_find_binary and oa_find_key. Hot
+ * keys skip the binary search; removes invalidate their key.
+ *
+ * SECONDARY INDEXES (oa_add_index): optional B+-trees of the same
+ * elements ordered by other fields (gpa, price, stock, name), kept in
+ * step by every insert and remove. oa_index_range and oa_index_top answer
+ * "stock < 10" or "top 10 by gpa" in O(log n + k) instead of a scan.
+ *
+ * STATS (-DTRADEOFFS_STATS): counts comparisons, shifted slots,
+ * allocations and bytes in use, and times every find, insert, remove and
+ * batch call (oa_stats). Normal builds compile the hooks away.
  */
 
 
@@ -29,7 +77,10 @@
  * @return The index of the element (if *pFound = 1)
  * @return The index where the element *should be inserted* (if *pFound = 0)
  */
+static int _oa_find_key_index(OrderedArray* arr, long key, int* pFound);
+
 static int _oa_find_index(OrderedArray* arr, void* data_to_find, int* pFound){
+    if(arr->keys != NULL) return _oa_find_key_index(arr, arr->key_of(data_to_find), pFound);
     if(arr->counter == 0){
         *pFound = 0;
         return 0;
@@ -39,6 +90,7 @@ static int _oa_find_index(OrderedArray* arr, void* data_to_find, int* pFound){
     int mid;
     while (low <= high){
         mid = (low + high) / 2;
+        CS_ADD(arr->stats, comparisons, 1);
         int comparison = arr->compare(data_to_find, arr->data[mid]);
         if (comparison == 0) {
             *pFound = 1;
@@ -55,6 +107,159 @@ static int _oa_find_index(OrderedArray* arr, void* data_to_find, int* pFound){
     return low;
 }
 
+/**
+ * @brief (Private) Keyed-mode version of _oa_find_index.
+ *
+ * Same contract, but the binary search runs over the contiguous 'keys'
+ * array with plain integer comparisons.
+ *
+ * @param arr A keyed array.
+ * @param key The key to search for.
+ * @param pFound [out] Will be set to 1 if found, 0 otherwise.
+ * @return The index of the element, or where it *should be inserted*.
+ */
+static int _oa_find_key_index(OrderedArray* arr, long key, int* pFound){
+    const long* keys = arr->keys;
+    int low = 0;
+    int high = arr->counter - 1;
+    while(low <= high){
+        int mid = (low + high) / 2;
+        CS_ADD(arr->stats, comparisons, 1);
+        if(keys[mid] == key){
+            *pFound = 1;
+            return mid;
+        }
+        else if(keys[mid] < key) low = mid + 1;
+        else high = mid - 1;
+    }
+    *pFound = 0;
+    return low;
+}
+
+/**
+ * @brief (Private) Compares 'data' against the element at 'index'.
+ *
+ * In keyed mode uses the precomputed 'key' of 'data' and the stored key,
+ * so the element itself is not touched.
+ *
+ * @return < 0, 0 or > 0 like a CompareFunc(data, arr->data[index]).
+ */
+static int _oa_compare_at(OrderedArray* arr, void* data, long key, int index){
+    CS_ADD(arr->stats, comparisons, 1);
+    if(arr->keys != NULL) return (key > arr->keys[index]) - (key < arr->keys[index]);
+    return arr->compare(data, arr->data[index]);
+}
+
+/**
+ * @brief (Private) Compares two elements with the array's ordering.
+ */
+static int _oa_compare_items(OrderedArray* arr, void* a, void* b){
+    CS_ADD(arr->stats, comparisons, 1);
+    if(arr->keys != NULL){
+        long key_a = arr->key_of(a);
+        long key_b = arr->key_of(b);
+        return (key_a > key_b) - (key_a < key_b);
+    }
+    return arr->compare(a, b);
+}
+
+/**
+ * @brief (Private) Resizes the internal arrays to exactly 'new_capacity'.
+ *
+ * @param arr The array to resize.
+ * @param new_capacity The new capacity (must be >= counter and > 0).
+ * @return 1 on success, 0 if realloc fails (the capacity is left untouched).
+ */
+static int _oa_resize(OrderedArray* arr, int new_capacity){
+    void** new_data = (void**)realloc(arr->data, (size_t)new_capacity * sizeof(void*));
+    if(new_data == NULL) return 0;
+    arr->data = new_data;
+    int keys_resized = 0;
+    if(arr->keys != NULL){
+        long* new_keys = (long*)realloc(arr->keys, (size_t)new_capacity * sizeof(long));
+        /* A failed shrink keeps the bigger block, which is still valid */
+        if(new_keys == NULL && new_capacity > arr->capacity) return 0;
+        if(new_keys != NULL){
+            arr->keys = new_keys;
+            keys_resized = 1;
+        }
+    }
+    CS_ADD(arr->stats, allocations, 1 + keys_resized);
+    CS_ADD(arr->stats, bytes_in_use, (long long)(new_capacity - arr->capacity)
+                                     * (long long)(sizeof(void*) + (keys_resized ? sizeof(long) : 0)));
+    (void)keys_resized;     /*Only read by the stats hooks*/
+    arr->capacity = new_capacity;
+    return 1;
+}
+
+/**
+ * @brief (Private) Makes room for at least 'needed' elements, doubling the capacity.
+ *
+ * Geometric growth keeps the total copying cost of N inserts at O(N),
+ * i.e. amortized O(1) per insert.
+ *
+ * @param arr The array to grow.
+ * @param needed The minimum capacity required.
+ * @return 1 on success, 0 if the array is not growable or memory fails.
+ */
+static int _oa_grow(OrderedArray* arr, int needed){
+    if(!arr->growable) return 0;
+    int new_capacity = arr->capacity > 0 ? arr->capacity : 1;
+    while(new_capacity < needed){
+        if(new_capacity > INT_MAX / 2) {
+            new_capacity = INT_MAX;
+            break;
+        }
+        new_capacity *= 2;
+    }
+    return _oa_resize(arr, new_capacity);
+}
+
+/**
+ * @brief (Private) Applies the shrink-on-remove policy after removals.
+ *
+ * @param arr The array that just lost elements.
+ */
+static void _oa_maybe_shrink(OrderedArray* arr){
+    if(arr->growable && arr->shrink_threshold > 0.0f
+       && arr->counter < (float)arr->capacity * arr->shrink_threshold){
+        int new_capacity = arr->counter * 2;
+        if(new_capacity < arr->min_capacity) new_capacity = arr->min_capacity;
+        if(new_capacity < 1) new_capacity = 1;
+        if(new_capacity < arr->capacity) _oa_resize(arr, new_capacity);
+    }
+}
+
+/**
+ * @brief (Private) Stable bottom-up merge sort of an array of elements.
+ *
+ * @param arr The array whose ordering is used.
+ * @param items The elements to sort (sorted in place).
+ * @param tmp Scratch buffer with room for 'count' pointers.
+ * @param count Number of elements.
+ */
+static void _oa_merge_sort(OrderedArray* arr, void** items, void** tmp, int count){
+    void** src = items;
+    void** dst = tmp;
+    for(int width = 1; width < count; width *= 2){
+        for(int lo = 0; lo < count; lo += 2 * width){
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo, j = mid, k = lo;
+            while(i < mid && j < hi){
+                if(_oa_compare_items(arr, src[j], src[i]) < 0) dst[k++] = src[j++];
+                else dst[k++] = src[i++];
+            }
+            while(i < mid) dst[k++] = src[i++];
+            while(j < hi) dst[k++] = src[j++];
+        }
+        void** swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if(src != items) memcpy(items, src, (size_t)count * sizeof(void*));
+}
+
 /**
  * @brief Creates a new OrderedArray instance.
  *
@@ -76,6 +281,51 @@ OrderedArray* oa_create(int capacity, CompareFunc compare_func){
     arr->capacity = capacity;
     arr->counter = 0;
     arr->compare = compare_func;
+    arr->growable = 0;
+    arr->min_capacity = capacity;
+    arr->shrink_threshold = 0.0f;
+    arr->keys = NULL;
+    arr->key_of = NULL;
+    arr->index = NULL;
+    arr->cache = NULL;
+    arr->secondary = NULL;
+#ifdef TRADEOFFS_STATS
+    arr->stats = cs_create();
+    if(arr->stats == NULL){
+        free(arr->data);
+        free(arr);
+        return NULL;
+    }
+    CS_ADD(arr->stats, allocations, 2);
+    CS_ADD(arr->stats, bytes_in_use, (long long)(sizeof(OrderedArray) + (size_t)capacity * sizeof(void*)));
+#endif
+    return arr;
+}
+
+/**
+ * @brief Creates a new OrderedArray in keyed mode.
+ *
+ * Every element's key (as returned by 'key_func', e.g. student_get_id) is
+ * stored inline in a parallel 'keys' array. All searches, inserts and
+ * removals compare those keys directly instead of calling a CompareFunc,
+ * and never dereference an element until it has been found.
+ *
+ * @param capacity The maximum number of elements the array can hold.
+ * @param key_func A function pointer that extracts an element's key.
+ * @return A pointer to the new OrderedArray, or NULL if memory fails.
+ */
+OrderedArray* oa_create_keyed(int capacity, KeyFunc key_func){
+    if(key_func == NULL) return NULL;
+    OrderedArray* arr = oa_create(capacity, NULL);
+    if(arr == NULL) return NULL;
+    arr->keys = (long*)malloc((size_t)capacity * sizeof(long));
+    if(arr->keys == NULL){
+        oa_free(arr);
+        return NULL;
+    }
+    arr->key_of = key_func;
+    CS_ADD(arr->stats, allocations, 1);
+    CS_ADD(arr->stats, bytes_in_use, (long long)((size_t)capacity * sizeof(long)));
     return arr;
 }
 
@@ -91,25 +341,214 @@ OrderedArray* oa_create(int capacity, CompareFunc compare_func){
 void oa_free(OrderedArray* arr){
     if(arr == NULL) return;
     free(arr->data);
+    free(arr->keys);
+    hi_free(arr->index);
+    lc_free(arr->cache);
+    sx_free(arr->secondary);
+#ifdef TRADEOFFS_STATS
+    cs_free(arr->stats);
+#endif
     free(arr);
 }
 
+/**
+ * @brief (Private) Body of oa_find_binary (the public function times it).
+ */
+static void* _oa_find_binary(OrderedArray* arr, void* data_to_find){
+    void* found = arr->cache != NULL ? lc_find(arr->cache, arr->cache->key_of(data_to_find)) : NULL;
+    if(found != NULL) return found;
+    if(arr->index != NULL) found = hi_find(arr->index, arr->index->key_of(data_to_find));
+    else{
+        int found_status = 0;
+        int index = _oa_find_index(arr, data_to_find, &found_status);
+        if(found_status == 1) found = arr->data[index];
+    }
+    if(found != NULL && arr->cache != NULL) lc_store(arr->cache, found);
+    return found;
+}
+
 /**
  * @brief Finds an element in the array using binary search.
  *
  * This is a public wrapper for the _oa_find_index helper function.
+ * With a hash index attached, the index answers instead, in O(1). With a
+ * lookup cache attached, a cached key is answered before either.
  *
  * @param arr The array to search in.
  * @param data_to_find A "template" data object to search for.
  * @return A pointer to the data if found, or NULL otherwise.
  */
 void* oa_find_binary(OrderedArray* arr, void* data_to_find){
+    CS_TIMER_START(started);
+    void* found = _oa_find_binary(arr, data_to_find);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_FIND, started);
+    return found;
+}
+
+/**
+ * @brief (Private) Body of oa_find_key (the public function times it).
+ */
+static void* _oa_find_key(OrderedArray* arr, long key){
+    if(arr == NULL) return NULL;
+    void* found = arr->cache != NULL ? lc_find(arr->cache, key) : NULL;
+    if(found != NULL) return found;
+    if(arr->index != NULL) found = hi_find(arr->index, key);
+    else if(arr->keys != NULL){
+        int found_status = 0;
+        int index = _oa_find_key_index(arr, key, &found_status);
+        if(found_status) found = arr->data[index];
+    }
+    if(found != NULL && arr->cache != NULL) lc_store(arr->cache, found);
+    return found;
+}
+
+/**
+ * @brief Finds an element by key in a keyed array (no template needed).
+ *
+ * @param arr A keyed array (see oa_create_keyed), or one with a hash index
+ * or a lookup cache.
+ * @param key The key to search for.
+ * @return A pointer to the data if found, or NULL otherwise (also NULL
+ * if the array is neither keyed nor indexed and the key is not cached).
+ */
+void* oa_find_key(OrderedArray* arr, long key){
+    CS_TIMER_START(started);
+    void* found = _oa_find_key(arr, key);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_FIND, started);
+    return found;
+}
+
+/**
+ * @brief (Private) Body of oa_find_batch (the public function times it).
+ */
+static int _oa_find_batch(OrderedArray* arr, void** keys, int count, void** results){
+    if(arr == NULL || keys == NULL || results == NULL || count <= 0) return 0;
+    int found = 0;
+    if(arr->index != NULL){
+        for(int i = 0; i < count; i++){
+            results[i] = hi_find(arr->index, arr->index->key_of(keys[i]));
+            found += results[i] != NULL;
+        }
+        return found;
+    }
+    int n = arr->counter;
+    if(n == 0){
+        for(int i = 0; i < count; i++) results[i] = NULL;
+        return 0;
+    }
+    for(int first = 0; first < count; first += OA_BATCH_LANES){
+        int lanes = count - first < OA_BATCH_LANES ? count - first : OA_BATCH_LANES;
+        int base[OA_BATCH_LANES];
+        long key[OA_BATCH_LANES];
+        for(int l = 0; l < lanes; l++){
+            base[l] = 0;
+            key[l] = arr->keys != NULL ? arr->key_of(keys[first + l]) : 0;
+        }
+        for(int len = n; len > 1; len -= len / 2){
+            int half = len / 2;
+            for(int l = 0; l < lanes; l++){
+                /* Prefetch the slot, not the element: reading data[] to get the
+                   element's address would be the very miss the prefetch hides */
+                if(arr->keys != NULL) OA_PREFETCH(&arr->keys[base[l] + half]);
+                else OA_PREFETCH(&arr->data[base[l] + half]);
+            }
+            for(int l = 0; l < lanes; l++){
+                int step = _oa_compare_at(arr, keys[first + l], key[l], base[l] + half) > 0;
+                base[l] += step ? half : 0;
+            }
+        }
+        for(int l = 0; l < lanes; l++){
+            int index = base[l];
+            int comparison = _oa_compare_at(arr, keys[first + l], key[l], index);
+            if(comparison > 0 && index + 1 < n){
+                index++;
+                comparison = _oa_compare_at(arr, keys[first + l], key[l], index);
+            }
+            results[first + l] = comparison == 0 ? arr->data[index] : NULL;
+            found += comparison == 0;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Finds a batch of elements with interleaved binary searches.
+ *
+ * The keys are searched OA_BATCH_LANES at a time. All lanes take the same
+ * number of branch-free halving steps, and at each step the probes of
+ * every lane are prefetched before any of them is compared, so up to
+ * OA_BATCH_LANES cache misses are in flight at once instead of one. A
+ * keyed array prefetches the keys themselves; a plain one can only
+ * prefetch the pointer slots, and the CompareFunc still waits for each
+ * element.
+ * With a hash index attached, each key is one O(1) index lookup instead.
+ *
+ * @param arr The array to search in.
+ * @param keys "Template" data objects to search for (not modified).
+ * @param count Number of keys.
+ * @param results [out] Buffer with room for 'count' pointers; results[i]
+ * receives the element matching keys[i], or NULL if it is not present.
+ * @return The number of keys found.
+ */
+int oa_find_batch(OrderedArray* arr, void** keys, int count, void** results){
+    CS_TIMER_START(started);
+    int found = _oa_find_batch(arr, keys, count, results);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_BATCH, started);
+    return found;
+}
+
+/**
+ * @brief (Private) Adds elements to the hash index and the secondary indexes: all, or none.
+ *
+ * @return 1 on success, 0 if an index runs out of memory or rejects an
+ * element (the indexes are then left as they were).
+ */
+static int _oa_index_all(OrderedArray* arr, void** items, int count){
+    int indexed = 0;
+    while(arr->index != NULL && indexed < count && hi_insert(arr->index, items[indexed])) indexed++;
+    if(arr->index != NULL && indexed < count){
+        while(indexed-- > 0) hi_remove(arr->index, arr->index->key_of(items[indexed]));
+        return 0;
+    }
+    if(!sx_insert(arr->secondary, items, count)){
+        for(int i = 0; arr->index != NULL && i < count; i++) hi_remove(arr->index, arr->index->key_of(items[i]));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief (Private) Drops a removed element from the hash index, the cache and the secondary indexes.
+ */
+static void _oa_unindex(OrderedArray* arr, void* data){
+    if(arr->index != NULL) hi_remove(arr->index, arr->index->key_of(data));
+    if(arr->cache != NULL) lc_invalidate(arr->cache, arr->cache->key_of(data));
+    sx_remove(arr->secondary, data);
+}
+
+/**
+ * @brief (Private) Body of oa_insert_sorted (the public function times it).
+ */
+static int _oa_insert_sorted(OrderedArray* arr, void* data){
+    if(arr == NULL) return 0;
     int found_status = 0;
-    int index = _oa_find_index(arr, data_to_find, &found_status);
-    if(found_status == 1){
-        return arr->data[index];
+    long key = arr->keys != NULL ? arr->key_of(data) : 0;
+    int index_to_insert = arr->keys != NULL ? _oa_find_key_index(arr, key, &found_status)
+                                            : _oa_find_index(arr, data, &found_status);
+    if(found_status == 1) return 0;
+    if(arr->counter == arr->capacity && !_oa_grow(arr, arr->counter + 1)) return 0;
+    if(!_oa_index_all(arr, &data, 1)) return 0;
+    memmove(&arr->data[index_to_insert + 1], &arr->data[index_to_insert],
+            (size_t)(arr->counter - index_to_insert) * sizeof(void*));
+    CS_ADD(arr->stats, shifts, arr->counter - index_to_insert);
+    arr->data[index_to_insert] = data;
+    if(arr->keys != NULL){
+        memmove(&arr->keys[index_to_insert + 1], &arr->keys[index_to_insert],
+                (size_t)(arr->counter - index_to_insert) * sizeof(long));
+        arr->keys[index_to_insert] = key;
     }
-    else return NULL;
+    arr->counter++;
+    return 1;
 }
 
 /**
@@ -117,20 +556,42 @@ void* oa_find_binary(OrderedArray* arr, void* data_to_find){
  *
  * Finds the correct insertion point using binary search (O(log n))
  * and then shifts all subsequent elements to make space (O(n)).
+ * A growable array doubles its capacity instead of rejecting the insert.
  *
  * @param arr The array to insert into.
  * @param data The data to insert.
- * @return 1 on success, 0 on failure (array is full or data exists).
+ * @return 1 on success, 0 on failure (array is full, data exists, or an
+ * index runs out of memory or rejects it).
 */
 int oa_insert_sorted(OrderedArray* arr, void* data){
-    if(arr == NULL || arr->counter == arr->capacity) return 0;
+    CS_TIMER_START(started);
+    int inserted = _oa_insert_sorted(arr, data);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_INSERT, started);
+    return inserted;
+}
+
+/**
+ * @brief (Private) Body of oa_remove (the public function times it).
+ */
+static void* _oa_remove(OrderedArray* arr, void* data_to_remove) {
+    if (arr == NULL || arr->counter == 0) return NULL;
     int found_status = 0;
-    int index_to_insert = _oa_find_index(arr, data, &found_status);
-    if(found_status == 1) return 0;
-    for(int j = arr->counter; j > index_to_insert; j--) arr->data[j] = arr->data[j-1];
-    arr->data[index_to_insert] = data;
-    arr->counter++;
-    return 1;
+    int index_to_remove = _oa_find_index(arr, data_to_remove, &found_status);
+    if (found_status == 0) {
+        return NULL;
+    }
+    void* removed_data = arr->data[index_to_remove];
+    _oa_unindex(arr, removed_data);
+    memmove(&arr->data[index_to_remove], &arr->data[index_to_remove + 1],
+            (size_t)(arr->counter - index_to_remove - 1) * sizeof(void*));
+    if(arr->keys != NULL){
+        memmove(&arr->keys[index_to_remove], &arr->keys[index_to_remove + 1],
+                (size_t)(arr->counter - index_to_remove - 1) * sizeof(long));
+    }
+    CS_ADD(arr->stats, shifts, arr->counter - index_to_remove - 1);
+    arr->counter--;
+    _oa_maybe_shrink(arr);
+    return removed_data;
 }
 
 /**
@@ -138,25 +599,210 @@ int oa_insert_sorted(OrderedArray* arr, void* data){
  *
  * Finds the element using binary search (O(log n)) and then
  * shifts all subsequent elements to close the gap (O(n)).
+ * A growable array with a shrink threshold halves its memory once the
+ * counter drops below capacity * threshold.
  *
  * @param arr The array to remove from.
  * @param data_to_remove A "template" data object to find and remove.
  * @return The pointer to the removed data (so the caller can free it),
  * or NULL if the element was not found.
  */
-void* oa_remove(OrderedArray* arr, void* data_to_remove) {
-    if (arr == NULL || arr->counter == 0) return NULL;
-    int found_status = 0;
-    int index_to_remove = _oa_find_index(arr, data_to_remove, &found_status);
-    if (found_status == 0) {
-        return NULL;
+void* oa_remove(OrderedArray* arr, void* data_to_remove){
+    CS_TIMER_START(started);
+    void* removed = _oa_remove(arr, data_to_remove);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_REMOVE, started);
+    return removed;
+}
+
+/**
+ * @brief (Private) Body of oa_insert_batch (the public function times it).
+ */
+static int _oa_insert_batch(OrderedArray* arr, void** items, int count){
+    if(arr == NULL || items == NULL || count <= 0) return 0;
+    void** rejected = (void**)malloc((size_t)count * sizeof(void*));
+    if(rejected == NULL) return 0;
+    CS_ADD(arr->stats, allocations, 1);
+    CS_ADD(arr->stats, frees, 1);
+    _oa_merge_sort(arr, items, rejected, count);
+
+    int accepted = 0;
+    int rejected_count = 0;
+    int cursor = 0;
+    for(int i = 0; i < count; i++){
+        void* item = items[i];
+        long key = arr->keys != NULL ? arr->key_of(item) : 0;
+        int duplicate = accepted > 0 && _oa_compare_items(arr, item, items[accepted - 1]) == 0;
+        if(!duplicate){
+            while(cursor < arr->counter && _oa_compare_at(arr, item, key, cursor) > 0) cursor++;
+            duplicate = cursor < arr->counter && _oa_compare_at(arr, item, key, cursor) == 0;
+        }
+        if(duplicate) rejected[rejected_count++] = item;
+        else items[accepted++] = item;
     }
-    void* removed_data = arr->data[index_to_remove];
-    for (int j = index_to_remove; j < arr->counter - 1; j++) {
-        arr->data[j] = arr->data[j+1];
+
+    int fitting = accepted;
+    if(arr->counter + accepted > arr->capacity && !_oa_grow(arr, arr->counter + accepted)){
+        fitting = arr->capacity - arr->counter;
     }
-    arr->counter--;
-    return removed_data;
+    memcpy(&items[accepted], rejected, (size_t)rejected_count * sizeof(void*));
+    free(rejected);
+    /* An index out of memory inserts nothing, so array and indexes stay in step */
+    if(!_oa_index_all(arr, items, fitting)) fitting = 0;
+
+    int i = arr->counter - 1;
+    int j = fitting - 1;
+    int w = arr->counter + fitting - 1;
+    while(j >= 0){
+        long key = arr->keys != NULL ? arr->key_of(items[j]) : 0;
+        while(i >= 0 && _oa_compare_at(arr, items[j], key, i) < 0){
+            arr->data[w] = arr->data[i];
+            if(arr->keys != NULL) arr->keys[w] = arr->keys[i];
+            CS_ADD(arr->stats, shifts, 1);
+            w--;
+            i--;
+        }
+        arr->data[w] = items[j];
+        if(arr->keys != NULL) arr->keys[w] = key;
+        w--;
+        j--;
+    }
+    arr->counter += fitting;
+    return fitting;
+}
+
+/**
+ * @brief Inserts a batch of elements in a single merge pass.
+ *
+ * Sorts the batch (O(m log m)), drops elements whose key already exists
+ * in the array or earlier in the batch, and merges the rest into the
+ * array from the back in one linear pass (O(n + m)). Loading N unsorted
+ * rows this way costs O(N log N) instead of the O(N^2) of repeated
+ * oa_insert_sorted calls.
+ *
+ * The 'items' array is reordered: on return items[0 .. result) are the
+ * inserted elements (sorted) and items[result .. count) the rejected ones
+ * (duplicates, or no room left in a fixed-capacity array), so the caller
+ * can free them.
+ *
+ * @param arr The array to insert into.
+ * @param items The elements to insert.
+ * @param count Number of elements in 'items'.
+ * @return The number of elements inserted (0 also if memory fails).
+ */
+int oa_insert_batch(OrderedArray* arr, void** items, int count){
+    CS_TIMER_START(started);
+    int inserted = _oa_insert_batch(arr, items, count);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_BATCH, started);
+    return inserted;
+}
+
+/**
+ * @brief (Private) Body of oa_remove_batch (the public function times it).
+ */
+static int _oa_remove_batch(OrderedArray* arr, void** keys, int count, void** removed){
+    if(arr == NULL || keys == NULL || count <= 0 || arr->counter == 0) return 0;
+    void** sorted = (void**)malloc((size_t)count * 2 * sizeof(void*));
+    if(sorted == NULL) return 0;
+    CS_ADD(arr->stats, allocations, 1);
+    CS_ADD(arr->stats, frees, 1);
+    memcpy(sorted, keys, (size_t)count * sizeof(void*));
+    _oa_merge_sort(arr, sorted, sorted + count, count);
+
+    int removed_count = 0;
+    int j = 0;
+    int w = 0;
+    int r = 0;
+    long key = (arr->keys != NULL) ? arr->key_of(sorted[0]) : 0;
+    for(; r < arr->counter && j < count; r++){
+        while(j < count && _oa_compare_at(arr, sorted[j], key, r) < 0){
+            j++;
+            if(j < count && arr->keys != NULL) key = arr->key_of(sorted[j]);
+        }
+        if(j < count && _oa_compare_at(arr, sorted[j], key, r) == 0){
+            _oa_unindex(arr, arr->data[r]);
+            if(removed != NULL) removed[removed_count] = arr->data[r];
+            removed_count++;
+            j++;
+            if(j < count && arr->keys != NULL) key = arr->key_of(sorted[j]);
+            continue;
+        }
+        arr->data[w] = arr->data[r];
+        if(arr->keys != NULL) arr->keys[w] = arr->keys[r];
+        CS_ADD(arr->stats, shifts, w != r);
+        w++;
+    }
+    if(w != r){
+        CS_ADD(arr->stats, shifts, arr->counter - r);
+        memmove(&arr->data[w], &arr->data[r], (size_t)(arr->counter - r) * sizeof(void*));
+        if(arr->keys != NULL) memmove(&arr->keys[w], &arr->keys[r], (size_t)(arr->counter - r) * sizeof(long));
+    }
+    arr->counter -= removed_count;
+    free(sorted);
+    _oa_maybe_shrink(arr);
+    return removed_count;
+}
+
+/**
+ * @brief Removes a batch of elements in a single compaction pass.
+ *
+ * Sorts a copy of the keys (O(m log m)) and walks the array once,
+ * keeping the elements that do not match (O(n + m)), instead of paying
+ * one O(n) shift per removed element.
+ *
+ * @param arr The array to remove from.
+ * @param keys "Template" data objects to find and remove (not modified).
+ * @param count Number of keys.
+ * @param removed [out] Optional buffer with room for 'count' pointers that
+ * receives the removed elements (so the caller can free them). May be NULL.
+ * @return The number of elements removed (0 also if memory fails).
+ */
+int oa_remove_batch(OrderedArray* arr, void** keys, int count, void** removed){
+    CS_TIMER_START(started);
+    int removed_count = _oa_remove_batch(arr, keys, count, removed);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_BATCH, started);
+    return removed_count;
+}
+
+/**
+ * @brief (Private) Body of oa_append_sorted (the public function times it).
+ */
+static int _oa_append_sorted(OrderedArray* arr, void** items, int count){
+    if(arr == NULL || items == NULL || count <= 0 || count > INT_MAX - arr->counter) return 0;
+    void* previous = arr->counter > 0 ? arr->data[arr->counter - 1] : NULL;
+    for(int i = 0; i < count; i++){
+        if(previous != NULL && _oa_compare_items(arr, previous, items[i]) >= 0) return 0;
+        previous = items[i];
+    }
+    if(arr->counter + count > arr->capacity && !_oa_grow(arr, arr->counter + count)) return 0;
+    if(!_oa_index_all(arr, items, count)) return 0;
+    memcpy(&arr->data[arr->counter], items, (size_t)count * sizeof(void*));
+    if(arr->keys != NULL){
+        for(int i = 0; i < count; i++) arr->keys[arr->counter + i] = arr->key_of(items[i]);
+    }
+    arr->counter += count;
+    return count;
+}
+
+/**
+ * @brief Appends an already sorted run after the last element. O(m).
+ *
+ * The fast path for building an array from sorted, duplicate-free input
+ * (see bulk_build_oa): no search, no shifting, one copy. The run is
+ * checked in the same pass: it must be strictly increasing and start
+ * after the array's current last element. A growable array grows once to
+ * fit it; a fixed one must already have room.
+ *
+ * @param arr The array to append to.
+ * @param items The elements to append, in order (not modified).
+ * @param count Number of elements in 'items'.
+ * @return 'count' on success, or 0 if the run is out of order, has
+ * duplicates, does not fit, or memory fails (nothing is appended).
+ */
+int oa_append_sorted(OrderedArray* arr, void** items, int count){
+    CS_TIMER_START(started);
+    int appended = _oa_append_sorted(arr, items, count);
+    CS_TIMER_STOP(oa_stats(arr), CS_OP_BATCH, started);
+    return appended;
 }
 
 /**
@@ -184,4 +830,329 @@ void oa_print(OrderedArray* arr, PrintFunc print_func) {
     printf("-----End of Array-----\n");
 }
 
+/**
+ * @brief Positions a cursor on the first element.
+ *
+ * A cursor is an index into the array: any insert or remove invalidates it.
+ *
+ * @param arr The array to walk.
+ * @param cursor [out] The cursor to position.
+ * @return 1 if the cursor is on an element, 0 if the array is empty.
+ */
+int oa_begin(OrderedArray* arr, OACursor* cursor){
+    if(cursor == NULL) return 0;
+    cursor->arr = arr;
+    cursor->index = 0;
+    return arr != NULL && arr->counter > 0;
+}
+
+/**
+ * @brief Positions a cursor on the last element (for walking backwards).
+ *
+ * @param arr The array to walk.
+ * @param cursor [out] The cursor to position.
+ * @return 1 if the cursor is on an element, 0 if the array is empty.
+ */
+int oa_last(OrderedArray* arr, OACursor* cursor){
+    if(cursor == NULL) return 0;
+    cursor->arr = arr;
+    cursor->index = arr != NULL ? arr->counter - 1 : -1;
+    return cursor->index >= 0;
+}
 
+/**
+ * @brief Positions a cursor on the first element not ordered before 'key'. O(log n).
+ *
+ * @param arr The array to walk.
+ * @param key A "template" element holding the key, or NULL for the first element.
+ * @param cursor [out] The cursor to position. Past the end if every element is smaller.
+ * @return 1 if the cursor is on an element, 0 if it is past the end.
+ */
+int oa_lower_bound(OrderedArray* arr, void* key, OACursor* cursor){
+    if(cursor == NULL) return 0;
+    cursor->arr = arr;
+    cursor->index = 0;
+    if(arr == NULL) return 0;
+    if(key != NULL && arr->counter > 0){
+        int found_status = 0;
+        cursor->index = _oa_find_index(arr, key, &found_status);
+    }
+    return cursor->index < arr->counter;
+}
+
+/**
+ * @brief Returns the element under the cursor, or NULL if it is out of range.
+ */
+void* oa_cursor_get(OACursor* cursor){
+    if(cursor == NULL || cursor->arr == NULL) return NULL;
+    if(cursor->index < 0 || cursor->index >= cursor->arr->counter) return NULL;
+    return cursor->arr->data[cursor->index];
+}
+
+/**
+ * @brief Moves the cursor to the next element.
+ *
+ * @param cursor The cursor to move. Stepping past either end stops one
+ * position outside, so 'prev' after the end comes back to the last element.
+ * @return 1 if the cursor is on an element, 0 otherwise.
+ */
+int oa_cursor_next(OACursor* cursor){
+    if(cursor == NULL || cursor->arr == NULL) return 0;
+    if(cursor->index < cursor->arr->counter) cursor->index++;
+    return cursor->index < cursor->arr->counter;
+}
+
+/**
+ * @brief Moves the cursor to the previous element.
+ *
+ * @param cursor The cursor to move.
+ * @return 1 if the cursor is on an element, 0 otherwise.
+ */
+int oa_cursor_prev(OACursor* cursor){
+    if(cursor == NULL || cursor->arr == NULL) return 0;
+    if(cursor->index >= 0) cursor->index--;
+    if(cursor->index >= cursor->arr->counter) cursor->index = cursor->arr->counter - 1;
+    return cursor->index >= 0;
+}
+
+/**
+ * @brief Visits, in order, every element in the range [low, high).
+ *
+ * Both ends are found by binary search, so the scan costs O(log n + k)
+ * for k visited elements instead of a pass over the whole array.
+ *
+ * @param arr The array to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int oa_range(OrderedArray* arr, void* low, void* high, VisitFunc visit, void* context){
+    if(arr == NULL || visit == NULL || arr->counter == 0) return 0;
+    int found_status = 0;
+    int first = low != NULL ? _oa_find_index(arr, low, &found_status) : 0;
+    int end = high != NULL ? _oa_find_index(arr, high, &found_status) : arr->counter;
+    int visited = 0;
+    for(int i = first; i < end; i++){
+        visited++;
+        if(!visit(arr->data[i], context)) break;
+    }
+    return visited;
+}
+
+/**
+ * @brief Configures the growth policy of the array.
+ *
+ * By default an OrderedArray keeps the capacity given to oa_create and
+ * rejects inserts once full. A growable array doubles its capacity when
+ * full and, if 'shrink_threshold' > 0, halves its memory once
+ * counter < capacity * shrink_threshold (0.25 is a good value; it should be
+ * below 0.5 to avoid grow/shrink thrashing). It never shrinks below the
+ * capacity passed to oa_create.
+ *
+ * @param arr The array to configure.
+ * @param growable 1 to enable geometric growth, 0 for fixed capacity.
+ * @param shrink_threshold Fill ratio that triggers shrinking (0 disables it).
+ * @return 1 on success, 0 on invalid arguments.
+ */
+int oa_set_growth(OrderedArray* arr, int growable, float shrink_threshold){
+    if(arr == NULL || shrink_threshold < 0.0f || shrink_threshold >= 1.0f) return 0;
+    arr->growable = growable ? 1 : 0;
+    arr->shrink_threshold = shrink_threshold;
+    return 1;
+}
+
+/**
+ * @brief Ensures the array can hold at least 'min_capacity' elements.
+ *
+ * Works for fixed and growable arrays alike. Reserving before a bulk load
+ * avoids the intermediate reallocations of geometric growth.
+ *
+ * @param arr The array to enlarge.
+ * @param min_capacity The capacity required.
+ * @return 1 on success (or if already large enough), 0 if memory fails.
+ */
+int oa_reserve(OrderedArray* arr, int min_capacity){
+    if(arr == NULL) return 0;
+    if(min_capacity <= arr->capacity) return 1;
+    return _oa_resize(arr, min_capacity);
+}
+
+/**
+ * @brief Releases unused capacity so memory matches the live counter.
+ *
+ * @param arr The array to shrink.
+ * @return 1 on success, 0 if memory fails.
+ */
+int oa_shrink_to_fit(OrderedArray* arr){
+    if(arr == NULL) return 0;
+    int new_capacity = arr->counter > 0 ? arr->counter : 1;
+    if(new_capacity == arr->capacity) return 1;
+    return _oa_resize(arr, new_capacity);
+}
+
+/**
+ * @brief Attaches a hash index for O(1) exact-key lookups.
+ *
+ * Builds a HashIndex over the current elements. From then on every insert
+ * and remove (single and batch) keeps it up to date, and oa_find_binary,
+ * oa_find_key and oa_find_batch answer from it instead of searching. The
+ * array still serves ordered walks and ranges. Keys must be unique and
+ * agree with the array's ordering (equal elements <=> equal keys).
+ *
+ * @param arr The array to index. An existing index is rebuilt.
+ * @param key_func Extracts an element's key, or NULL to reuse the
+ * array's own (keyed mode).
+ * @return 1 on success, 0 if there is no key function, two elements
+ * share a key, or memory fails (the array is left without an index).
+ */
+int oa_attach_hash_index(OrderedArray* arr, KeyFunc key_func){
+    if(arr == NULL) return 0;
+    oa_detach_hash_index(arr);
+    if(key_func == NULL) key_func = arr->key_of;
+    HashIndex* index = hi_create(arr->counter, key_func);
+    if(index == NULL) return 0;
+    for(int i = 0; i < arr->counter; i++){
+        if(!hi_insert(index, arr->data[i])){
+            hi_free(index);
+            return 0;
+        }
+    }
+    arr->index = index;
+    return 1;
+}
+
+/**
+ * @brief Drops the array's hash index (finds go back to binary search).
+ */
+void oa_detach_hash_index(OrderedArray* arr){
+    if(arr == NULL) return;
+    hi_free(arr->index);
+    arr->index = NULL;
+}
+
+/**
+ * @brief Attaches a lookup cache of recently found elements.
+ *
+ * oa_find_binary and oa_find_key then look the key up in a small
+ * LookupCache first and only search the array on a miss, caching what
+ * they find. oa_remove and oa_remove_batch invalidate the removed keys.
+ * Worth it for skewed workloads where a few keys take most lookups; the
+ * cache's hits/misses counters show how well it does. Keys must agree
+ * with the array's ordering (equal elements <=> equal keys). Finds update
+ * the cache, so concurrent readers need exclusive access.
+ *
+ * @param arr The array to cache. An existing cache is replaced.
+ * @param slots Cached elements (<= 0: LC_DEFAULT_SLOTS).
+ * @param key_func Extracts an element's key, or NULL to reuse the
+ * array's own (keyed mode).
+ * @return 1 on success, 0 if there is no key function or memory fails.
+ */
+int oa_attach_lookup_cache(OrderedArray* arr, int slots, KeyFunc key_func){
+    if(arr == NULL) return 0;
+    oa_detach_lookup_cache(arr);
+    arr->cache = lc_create(slots, key_func != NULL ? key_func : arr->key_of);
+    return arr->cache != NULL;
+}
+
+/**
+ * @brief Drops the array's lookup cache.
+ */
+void oa_detach_lookup_cache(OrderedArray* arr){
+    if(arr == NULL) return;
+    lc_free(arr->cache);
+    arr->cache = NULL;
+}
+
+/**
+ * @brief Adds a secondary ordered index over another field.
+ *
+ * Builds a B+-tree of the current elements ordered by 'compare_func'
+ * (e.g. student_compare_by_gpa, product_compare_by_stock). From then on
+ * every insert and remove (single and batch) keeps it up to date. The
+ * comparator must break ties (by id) so no two elements compare equal,
+ * and the fields it reads must not be changed in place while indexed
+ * (remove the element, change it, insert it again).
+ *
+ * @param arr The array to index.
+ * @param compare_func The index's ordering.
+ * @return The index's slot (for oa_index_range, oa_index_top and
+ * oa_drop_index), or -1 if SX_MAX_INDEXES are already in use, two
+ * elements compare equal, or memory fails.
+ */
+int oa_add_index(OrderedArray* arr, CompareFunc compare_func){
+    if(arr == NULL || compare_func == NULL) return -1;
+    if(arr->secondary == NULL && (arr->secondary = sx_create()) == NULL) return -1;
+    return sx_add(arr->secondary, compare_func, arr->data, arr->counter);
+}
+
+/**
+ * @brief Drops the secondary index in 'slot'.
+ *
+ * @return 1 if there was an index there, 0 otherwise.
+ */
+int oa_drop_index(OrderedArray* arr, int slot){
+    if(arr == NULL || !sx_drop(arr->secondary, slot)) return 0;
+    if(sx_count(arr->secondary) == 0){
+        sx_free(arr->secondary);
+        arr->secondary = NULL;
+    }
+    return 1;
+}
+
+/**
+ * @brief Visits, in a secondary index's order, every element in the range [low, high).
+ *
+ * Bounds are templates for the index's comparator: with a tie-breaking
+ * comparator, a template with id = LONG_MIN (e.g. stock = 10) bounds
+ * every element with that value, so low = NULL, high = {stock 10,
+ * LONG_MIN} visits exactly the products with stock < 10. O(log n + k).
+ *
+ * @param arr The array to scan.
+ * @param slot The index, as returned by oa_add_index.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int oa_index_range(OrderedArray* arr, int slot, void* low, void* high, VisitFunc visit, void* context){
+    if(arr == NULL) return 0;
+    return sx_range(arr->secondary, slot, low, high, visit, context);
+}
+
+/**
+ * @brief Returns the k largest elements of a secondary index, largest first.
+ *
+ * E.g. the top 10 students by GPA, in O(log n + k) and without copying
+ * or sorting the array.
+ *
+ * @param arr The array to read.
+ * @param slot The index, as returned by oa_add_index.
+ * @param k Number of elements wanted.
+ * @param results [out] Buffer with room for 'k' pointers.
+ * @return The number of elements written (fewer than k if the array is smaller).
+ */
+int oa_index_top(OrderedArray* arr, int slot, int k, void** results){
+    if(arr == NULL) return 0;
+    return sx_top(arr->secondary, slot, k, results);
+}
+
+/**
+ * @brief Returns the array's cost counters and latency histograms.
+ *
+ * Only stats builds (-DTRADEOFFS_STATS) collect them. Use cs_snapshot to
+ * copy them, cs_reset to clear them and cs_dump_json to export them.
+ *
+ * @param arr The array to query.
+ * @return Its ContainerStats, or NULL in normal builds.
+ */
+ContainerStats* oa_stats(OrderedArray* arr){
+#ifdef TRADEOFFS_STATS
+    return arr != NULL ? arr->stats : NULL;
+#else
+    (void)arr;
+    return NULL;
+#endif
+}
@@ -2,12 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include "product.h"
+#include "recordArena.h"
 
 /**
  * @brief Creates a new Product instance on the heap.
  *
- * Allocates memory for a Product structure and initializes it
- * with the provided values.
+ * Allocates the Product structure and a copy of its name with a single
+ * malloc (the name is stored right after the struct, sized to fit), and
+ * initializes it with the provided values.
  *
  * @param id The product's unique ID
  * @param name The product's name.
@@ -18,14 +20,44 @@
  * memory allocation fails.
  */
 Product* product_create(long int id, const char* name, float price, float cost, long int stock){
-    Product* A = (Product *)malloc(sizeof(Product));
+    size_t length = strlen(name) + 1;
+    Product* A = (Product *)malloc(sizeof(Product) + length);
     if(A == NULL) return NULL;
 
     A->id = id;
     A->price = price;
     A->cost = cost;
     A->stock = stock;
-    strcpy(A->name, name);
+    A->name = memcpy(A + 1, name, length);
+    return A;
+}
+
+/**
+ * @brief Creates a new Product instance in a RecordArena.
+ *
+ * The struct is carved out of the arena and the name is interned there,
+ * so products sharing a name share its bytes. Do not call product_free
+ * on it: ra_free releases it with the rest of the arena.
+ *
+ * @param arena The arena that owns the database's records.
+ * @param id The product's unique ID
+ * @param name The product's name.
+ * @param price The product's selling price.
+ * @param cost The product's cost
+ * @param stock The product's available stock quantity.
+ * @return A pointer to the newly created Product, or NULL if
+ * memory allocation fails.
+ */
+Product* product_create_in(struct RecordArena* arena, long int id, const char* name, float price, float cost, long int stock){
+    const char* interned = ra_intern(arena, name);
+    Product* A = interned != NULL ? (Product*)ra_alloc(arena, sizeof(Product)) : NULL;
+    if(A == NULL) return NULL;
+
+    A->id = id;
+    A->price = price;
+    A->cost = cost;
+    A->stock = stock;
+    A->name = interned;
     return A;
 }
 
@@ -82,3 +114,64 @@ int product_compare_by_id(void* productA, void* productB){
     }
     else return 1;
 }
+
+/**
+ * @brief Compares two Product instances by price, then by ID.
+ *
+ * Ordering for a secondary index (oa_add_index, list_add_index): the ID
+ * breaks ties, so two different products never compare equal. A
+ * template with id = LONG_MIN is a bound just below every product with
+ * that price.
+ *
+ * @param productA A void pointer to the first Product.
+ * @param productB A void pointer to the second Product.
+ * @return < 0, 0 or > 0 as A sorts before, with or after B.
+ */
+int product_compare_by_price(void* productA, void* productB){
+    Product* A = (Product*)productA;
+    Product* B = (Product*)productB;
+    if(A->price != B->price) return A->price < B->price ? -1 : 1;
+    return product_compare_by_id(productA, productB);
+}
+
+/**
+ * @brief Compares two Product instances by stock, then by ID.
+ *
+ * @param productA A void pointer to the first Product.
+ * @param productB A void pointer to the second Product.
+ * @return < 0, 0 or > 0 as A sorts before, with or after B.
+ */
+int product_compare_by_stock(void* productA, void* productB){
+    Product* A = (Product*)productA;
+    Product* B = (Product*)productB;
+    if(A->stock != B->stock) return A->stock < B->stock ? -1 : 1;
+    return product_compare_by_id(productA, productB);
+}
+
+/**
+ * @brief Compares two Product instances by name, then by ID.
+ *
+ * @param productA A void pointer to the first Product.
+ * @param productB A void pointer to the second Product.
+ * @return < 0, 0 or > 0 as A sorts before, with or after B.
+ */
+int product_compare_by_name(void* productA, void* productB){
+    Product* A = (Product*)productA;
+    Product* B = (Product*)productB;
+    int order = strcmp(A->name, B->name);
+    if(order != 0) return order;
+    return product_compare_by_id(productA, productB);
+}
+
+/**
+ * @brief Returns the ID of a Product.
+ *
+ * This function is compatible with the 'KeyFunc' typedef
+ * (long (*)(void*)) used by the keyed mode of the data structures.
+ *
+ * @param data A void pointer to the Product instance.
+ * @return The product's ID.
+ */
+long product_get_id(void* data){
+    return ((Product*)data)->id;
+}
@@ -0,0 +1,182 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "recordArena.h"
+
+/*
+ * recordArena.c
+ *
+ * Implements a bump allocator for records and an intern pool for their
+ * names. student_create_in / product_create_in carve each record out of
+ * the current block instead of calling malloc, and store its name once:
+ * every record named "Ana" points at the same interned "Ana", sized to
+ * the name instead of a fixed buffer.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - ALLOC:   O(1) - Bump a pointer; one malloc per RA_DEFAULT_BLOCK bytes
+ *            instead of one per record.
+ * - INTERN:  O(length) expected - Hash the name, probe the table; a name
+ *            seen before costs no memory at all.
+ * - RELEASE: O(blocks) - ra_free returns every record and name with one
+ *            free per block, without visiting a single record.
+ * - MEMORY:  No malloc header per record and no unused name bytes. The
+ *            price: a record can't be freed on its own. Records removed
+ *            from a container stay in the arena until it is released, so
+ *            an arena suits a database loaded once and dropped as a whole.
+ */
+
+
+/**
+ * @brief (Private) Carves 'size' bytes aligned to 'align' (a power of two) out of the current block.
+ *
+ * Opens a new block when the current one is full. A request larger than
+ * the block size gets a block of its own, filed behind the current one
+ * so the rest of the current block is still used.
+ *
+ * @return The memory, or NULL if malloc fails.
+ */
+static void* _ra_take(RecordArena* arena, size_t size, size_t align){
+    ArenaBlock* block = arena->blocks;
+    size_t start = block != NULL ? (block->used + align - 1) & ~(align - 1) : 0;
+    if(block == NULL || start > block->size || size > block->size - start){
+        size_t capacity = size > arena->block_size ? size : arena->block_size;
+        if(capacity > SIZE_MAX - sizeof(ArenaBlock)) return NULL;
+        block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + capacity);
+        if(block == NULL) return NULL;
+        block->size = capacity;
+        if(size > arena->block_size && arena->blocks != NULL){
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        }
+        else{
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+        arena->bytes_reserved += capacity;
+        start = 0;
+    }
+    block->used = start + size;
+    arena->bytes_used += size;
+    return (unsigned char*)block->data + start;
+}
+
+/**
+ * @brief (Private) FNV-1a hash of 'length' bytes.
+ */
+static size_t _ra_hash(const char* name, size_t length){
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < length; i++){
+        hash ^= (unsigned char)name[i];
+        hash *= 1099511628211ULL;
+    }
+    return (size_t)hash;
+}
+
+/**
+ * @brief (Private) Doubles the intern table and re-inserts every name.
+ *
+ * @return 1 on success, 0 if memory fails (the table is left as it was).
+ */
+static int _ra_grow_names(RecordArena* arena){
+    size_t slots = arena->name_slots * 2;
+    const char** names = (const char**)calloc(slots, sizeof(const char*));
+    if(names == NULL) return 0;
+    for(size_t i = 0; i < arena->name_slots; i++){
+        const char* name = arena->names[i];
+        if(name == NULL) continue;
+        size_t slot = _ra_hash(name, strlen(name)) & (slots - 1);
+        while(names[slot] != NULL) slot = (slot + 1) & (slots - 1);
+        names[slot] = name;
+    }
+    free((void*)arena->names);
+    arena->names = names;
+    arena->name_slots = slots;
+    return 1;
+}
+
+/**
+ * @brief Creates an empty arena.
+ *
+ * @param block_size Bytes per block (0: RA_DEFAULT_BLOCK). Blocks are
+ * only allocated when the first record or name needs one.
+ * @return A pointer to the new arena, or NULL if memory fails.
+ */
+RecordArena* ra_create(size_t block_size){
+    RecordArena* arena = (RecordArena*)calloc(1, sizeof(RecordArena));
+    if(arena == NULL) return NULL;
+    arena->names = (const char**)calloc(RA_INITIAL_NAMES, sizeof(const char*));
+    if(arena->names == NULL){
+        free(arena);
+        return NULL;
+    }
+    arena->name_slots = RA_INITIAL_NAMES;
+    arena->block_size = block_size > 0 ? block_size : RA_DEFAULT_BLOCK;
+    return arena;
+}
+
+/**
+ * @brief Releases every record and name of the arena, then the arena.
+ *
+ * Any container still pointing at the records must not be used
+ * afterwards (free it first, without freeing its elements).
+ */
+void ra_free(RecordArena* arena){
+    if(arena == NULL) return;
+    ArenaBlock* block = arena->blocks;
+    while(block != NULL){
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free((void*)arena->names);
+    free(arena);
+}
+
+/**
+ * @brief Allocates memory for one record, aligned for any type of that size.
+ *
+ * A type's alignment always divides its size, so the alignment used is
+ * the largest power of two dividing 'size' (at most that of max_align_t):
+ * a 24-byte Student takes 24 bytes, not 32.
+ *
+ * @param arena The arena to allocate from.
+ * @param size Bytes needed (e.g. sizeof(Student)).
+ * @return The memory (uninitialized, valid until ra_free), or NULL if
+ * memory fails.
+ */
+void* ra_alloc(RecordArena* arena, size_t size){
+    if(arena == NULL || size == 0) return NULL;
+    size_t align = _Alignof(max_align_t);
+    while(size % align != 0) align /= 2;
+    return _ra_take(arena, size, align);
+}
+
+/**
+ * @brief Returns the arena's copy of a name, storing it on first use.
+ *
+ * @param arena The arena that owns the names.
+ * @param name The NUL-terminated name to intern.
+ * @return The interned name (equal names give the same pointer), or
+ * NULL if memory fails.
+ */
+const char* ra_intern(RecordArena* arena, const char* name){
+    if(arena == NULL || name == NULL) return NULL;
+    if((arena->name_count + 1) * 4 > arena->name_slots * 3 && !_ra_grow_names(arena)) return NULL;
+    size_t length = strlen(name);
+    size_t mask = arena->name_slots - 1;
+    size_t slot = _ra_hash(name, length) & mask;
+    while(arena->names[slot] != NULL){
+        if(strcmp(arena->names[slot], name) == 0){
+            arena->intern_hits++;
+            return arena->names[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    char* copy = (char*)_ra_take(arena, length + 1, 1);
+    if(copy == NULL) return NULL;
+    memcpy(copy, name, length + 1);
+    arena->names[slot] = copy;
+    arena->name_count++;
+    return copy;
+}
@@ -0,0 +1,384 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "recordStore.h"
+
+/*
+ * recordStore.c
+ *
+ * Columnar (struct-of-arrays) storage for Students and Products. Each
+ * field lives in its own contiguous array and the names share one string
+ * pool, so a scan over gpa, price or stock reads 4-8 bytes per row from a
+ * dense array instead of ~128 bytes per record scattered across the heap,
+ * and the loops can be auto-vectorized.
+ *
+ * Rows are identified by a handle, the address of their slot in the id
+ * column (&id[row]). A handle is a plain void*, so the existing containers
+ * can index a store with store_compare_by_id / store_get_id, and a
+ * pointer to a long holding an id works as a search template.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SCAN:   O(n) over dense columns (the point of the layout).
+ * - ACCESS: O(1) by row or handle, but reading a whole record touches
+ *           one cache line per column.
+ * - MEMORY: Fixed capacity chosen at creation, so handles never move.
+ *           Rows are append-only; containers drop handles, not rows.
+ */
+
+#define STORE_INITIAL_NAMES 4096
+
+
+/**
+ * @brief (Private) Allocates the string pool.
+ *
+ * @return 1 on success, 0 if memory fails.
+ */
+static int _store_pool_init(NamePool* pool, size_t capacity){
+    pool->chars = (char*)malloc(capacity);
+    pool->used = 0;
+    pool->capacity = pool->chars != NULL ? capacity : 0;
+    return pool->chars != NULL;
+}
+
+/**
+ * @brief (Private) Copies a name into the pool, doubling it when full.
+ *
+ * The pool may move, which is why rows keep offsets and not pointers.
+ *
+ * @param offset [out] Where the name starts in the pool.
+ * @return 1 on success, 0 if memory fails.
+ */
+static int _store_pool_add(NamePool* pool, const char* name, size_t* offset){
+    size_t length = strlen(name) + 1;
+    if(pool->used + length > pool->capacity){
+        size_t new_capacity = pool->capacity > 0 ? pool->capacity : STORE_INITIAL_NAMES;
+        while(new_capacity < pool->used + length) new_capacity *= 2;
+        char* new_chars = (char*)realloc(pool->chars, new_capacity);
+        if(new_chars == NULL) return 0;
+        pool->chars = new_chars;
+        pool->capacity = new_capacity;
+    }
+    memcpy(pool->chars + pool->used, name, length);
+    *offset = pool->used;
+    pool->used += length;
+    return 1;
+}
+
+/**
+ * @brief (Private) Sums a float column with independent accumulators.
+ *
+ * Separate partial sums break the dependency chain of a single running
+ * total, so the additions can be pipelined or vectorized without
+ * relaxed floating-point flags.
+ */
+static double _store_sum_floats(const float* values, int count){
+    double partial[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        for(int lane = 0; lane < 8; lane++) partial[lane] += values[i + lane];
+    }
+    double total = 0.0;
+    for(; i < count; i++) total += values[i];
+    for(int lane = 0; lane < 8; lane++) total += partial[lane];
+    return total;
+}
+
+/**
+ * @brief Returns the id of a row handle.
+ *
+ * This function is compatible with the 'KeyFunc' typedef
+ * (long (*)(void*)) used by the keyed mode of the data structures.
+ *
+ * @param handle A handle from sstore_handle/pstore_handle (or a pointer to a long).
+ * @return The row's ID.
+ */
+long store_get_id(void* handle){
+    return *(const long*)handle;
+}
+
+/**
+ * @brief Compares two row handles by their ID.
+ *
+ * This function is compatible with the 'CompareFunc' typedef
+ * (int (*)(void*, void*)) used by the generic data structures.
+ *
+ * @return < 0, 0 or > 0 as A's ID is smaller, equal or greater than B's.
+ */
+int store_compare_by_id(void* handleA, void* handleB){
+    long a = *(const long*)handleA;
+    long b = *(const long*)handleB;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Creates an empty StudentStore.
+ *
+ * @param capacity The maximum number of rows (fixed, so handles stay valid).
+ * @return A pointer to the new StudentStore, or NULL if memory fails.
+ */
+StudentStore* sstore_create(int capacity){
+    if(capacity <= 0) return NULL;
+    StudentStore* store = (StudentStore*)calloc(1, sizeof(StudentStore));
+    if(store == NULL) return NULL;
+    store->id = (long*)malloc((size_t)capacity * sizeof(long));
+    store->gpa = (float*)malloc((size_t)capacity * sizeof(float));
+    store->name_offset = (size_t*)malloc((size_t)capacity * sizeof(size_t));
+    if(store->id == NULL || store->gpa == NULL || store->name_offset == NULL
+       || !_store_pool_init(&store->names, STORE_INITIAL_NAMES)){
+        sstore_free(store);
+        return NULL;
+    }
+    store->capacity = capacity;
+    return store;
+}
+
+/**
+ * @brief Frees the store, its columns and its names.
+ *
+ * Handles into the store become invalid.
+ */
+void sstore_free(StudentStore* store){
+    if(store == NULL) return;
+    free(store->id);
+    free(store->gpa);
+    free(store->name_offset);
+    free(store->names.chars);
+    free(store);
+}
+
+/**
+ * @brief Appends a student as a new row.
+ *
+ * @return The new row number, or -1 if the store is full or memory fails.
+ */
+int sstore_append(StudentStore* store, long id, const char* name, float gpa){
+    if(store == NULL || name == NULL || store->counter == store->capacity) return -1;
+    int row = store->counter;
+    if(!_store_pool_add(&store->names, name, &store->name_offset[row])) return -1;
+    store->id[row] = id;
+    store->gpa[row] = gpa;
+    store->counter++;
+    return row;
+}
+
+/**
+ * @brief Returns the handle of a row, to be stored in a container.
+ *
+ * @return The handle, or NULL if 'row' is out of range.
+ */
+void* sstore_handle(StudentStore* store, int row){
+    if(store == NULL || row < 0 || row >= store->counter) return NULL;
+    return &store->id[row];
+}
+
+/**
+ * @brief Converts a handle back to its row number.
+ *
+ * @return The row, or -1 if the handle does not belong to this store.
+ */
+int sstore_row(StudentStore* store, void* handle){
+    if(store == NULL || handle == NULL) return -1;
+    uintptr_t first = (uintptr_t)store->id;
+    uintptr_t address = (uintptr_t)handle;
+    if(address < first || (address - first) % sizeof(long) != 0) return -1;
+    uintptr_t row = (address - first) / sizeof(long);
+    return row < (uintptr_t)store->counter ? (int)row : -1;
+}
+
+/**
+ * @brief Returns the name of a row (valid until the next append).
+ */
+const char* sstore_name(StudentStore* store, int row){
+    if(store == NULL || row < 0 || row >= store->counter) return NULL;
+    return store->names.chars + store->name_offset[row];
+}
+
+/**
+ * @brief Prints a row in the same format as student_print.
+ */
+void sstore_print(StudentStore* store, int row){
+    if(store == NULL || row < 0 || row >= store->counter) return;
+    printf("Student's data:\n");
+    printf("    id: %ld\n", store->id[row]);
+    printf("    Name: %s\n", sstore_name(store, row));
+    printf("    GPA: %.2f\n", store->gpa[row]);
+}
+
+/**
+ * @brief Averages the gpa column.
+ *
+ * @return The average, or 0 if the store is empty.
+ */
+double sstore_average_gpa(StudentStore* store){
+    if(store == NULL || store->counter == 0) return 0.0;
+    return _store_sum_floats(store->gpa, store->counter) / store->counter;
+}
+
+/**
+ * @brief Collects the rows whose gpa is above 'threshold'.
+ *
+ * Branch-free: every row is written and the cursor only advances on a
+ * match, so the loop does not mispredict on unsorted data.
+ *
+ * @param rows [out] Buffer with room for store->counter rows.
+ * @return The number of matching rows written to 'rows' (in row order).
+ */
+int sstore_filter_gpa_above(StudentStore* store, float threshold, int* rows){
+    if(store == NULL || rows == NULL) return 0;
+    const float* gpa = store->gpa;
+    int matches = 0;
+    for(int i = 0; i < store->counter; i++){
+        rows[matches] = i;
+        matches += gpa[i] > threshold;
+    }
+    return matches;
+}
+
+/**
+ * @brief Creates an empty ProductStore.
+ *
+ * @param capacity The maximum number of rows (fixed, so handles stay valid).
+ * @return A pointer to the new ProductStore, or NULL if memory fails.
+ */
+ProductStore* pstore_create(int capacity){
+    if(capacity <= 0) return NULL;
+    ProductStore* store = (ProductStore*)calloc(1, sizeof(ProductStore));
+    if(store == NULL) return NULL;
+    store->id = (long*)malloc((size_t)capacity * sizeof(long));
+    store->price = (float*)malloc((size_t)capacity * sizeof(float));
+    store->cost = (float*)malloc((size_t)capacity * sizeof(float));
+    store->stock = (long*)malloc((size_t)capacity * sizeof(long));
+    store->name_offset = (size_t*)malloc((size_t)capacity * sizeof(size_t));
+    if(store->id == NULL || store->price == NULL || store->cost == NULL || store->stock == NULL
+       || store->name_offset == NULL || !_store_pool_init(&store->names, STORE_INITIAL_NAMES)){
+        pstore_free(store);
+        return NULL;
+    }
+    store->capacity = capacity;
+    return store;
+}
+
+/**
+ * @brief Frees the store, its columns and its names.
+ *
+ * Handles into the store become invalid.
+ */
+void pstore_free(ProductStore* store){
+    if(store == NULL) return;
+    free(store->id);
+    free(store->price);
+    free(store->cost);
+    free(store->stock);
+    free(store->name_offset);
+    free(store->names.chars);
+    free(store);
+}
+
+/**
+ * @brief Appends a product as a new row.
+ *
+ * @return The new row number, or -1 if the store is full or memory fails.
+ */
+int pstore_append(ProductStore* store, long id, const char* name, float price, float cost, long stock){
+    if(store == NULL || name == NULL || store->counter == store->capacity) return -1;
+    int row = store->counter;
+    if(!_store_pool_add(&store->names, name, &store->name_offset[row])) return -1;
+    store->id[row] = id;
+    store->price[row] = price;
+    store->cost[row] = cost;
+    store->stock[row] = stock;
+    store->counter++;
+    return row;
+}
+
+/**
+ * @brief Returns the handle of a row, to be stored in a container.
+ *
+ * @return The handle, or NULL if 'row' is out of range.
+ */
+void* pstore_handle(ProductStore* store, int row){
+    if(store == NULL || row < 0 || row >= store->counter) return NULL;
+    return &store->id[row];
+}
+
+/**
+ * @brief Converts a handle back to its row number.
+ *
+ * @return The row, or -1 if the handle does not belong to this store.
+ */
+int pstore_row(ProductStore* store, void* handle){
+    if(store == NULL || handle == NULL) return -1;
+    uintptr_t first = (uintptr_t)store->id;
+    uintptr_t address = (uintptr_t)handle;
+    if(address < first || (address - first) % sizeof(long) != 0) return -1;
+    uintptr_t row = (address - first) / sizeof(long);
+    return row < (uintptr_t)store->counter ? (int)row : -1;
+}
+
+/**
+ * @brief Returns the name of a row (valid until the next append).
+ */
+const char* pstore_name(ProductStore* store, int row){
+    if(store == NULL || row < 0 || row >= store->counter) return NULL;
+    return store->names.chars + store->name_offset[row];
+}
+
+/**
+ * @brief Prints a row in the same format as product_print.
+ */
+void pstore_print(ProductStore* store, int row){
+    if(store == NULL || row < 0 || row >= store->counter) return;
+    printf("Product's data: \n");
+    printf("    id: %ld\n", store->id[row]);
+    printf("    Name: %s\n", pstore_name(store, row));
+    printf("    Price: %.2f\n", store->price[row]);
+    printf("    Cost: %.2f\n", store->cost[row]);
+    printf("    Available stock: %ld\n", store->stock[row]);
+}
+
+/**
+ * @brief Sums the stock column.
+ */
+long long pstore_sum_stock(ProductStore* store){
+    if(store == NULL) return 0;
+    const long* stock = store->stock;
+    long long total = 0;
+    for(int i = 0; i < store->counter; i++) total += stock[i];
+    return total;
+}
+
+/**
+ * @brief Computes sum(price * stock) over every row.
+ */
+double pstore_inventory_value(ProductStore* store){
+    if(store == NULL) return 0.0;
+    double partial[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    double total = 0.0;
+    int i = 0;
+    for(; i + 8 <= store->counter; i += 8){
+        for(int lane = 0; lane < 8; lane++){
+            partial[lane] += (double)store->price[i + lane] * (double)store->stock[i + lane];
+        }
+    }
+    for(; i < store->counter; i++) total += (double)store->price[i] * (double)store->stock[i];
+    for(int lane = 0; lane < 8; lane++) total += partial[lane];
+    return total;
+}
+
+/**
+ * @brief Collects the rows whose stock is below 'threshold' (restock candidates).
+ *
+ * @param rows [out] Buffer with room for store->counter rows.
+ * @return The number of matching rows written to 'rows' (in row order).
+ */
+int pstore_filter_stock_below(ProductStore* store, long threshold, int* rows){
+    if(store == NULL || rows == NULL) return 0;
+    const long* stock = store->stock;
+    int matches = 0;
+    for(int i = 0; i < store->counter; i++){
+        rows[matches] = i;
+        matches += stock[i] < threshold;
+    }
+    return matches;
+}
@@ -0,0 +1,216 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "secondaryIndex.h"
+
+/*
+ * secondaryIndex.c
+ *
+ * Secondary ordered indexes for OrderedArray and LinkedList
+ * (oa_add_index, list_add_index). A container orders its elements by one
+ * CompareFunc (the id); each secondary index is a BPlusTree holding the
+ * same element pointers ordered by another one (gpa, price, stock,
+ * name), kept in step by every insert and remove of the container.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - QUERY:  O(log n + k) - sx_range visits the k elements of a range of
+ *           the index, sx_top the k largest, instead of a full scan and a
+ *           sort per query.
+ * - UPDATE: O(i log n) - Every insert and remove of the container also
+ *           updates each of its i indexes.
+ * - BUILD:  O(n log n) - sx_add sorts the current elements once and
+ *           bulk-loads the tree.
+ * - MEMORY: About 8-16 bytes per element per index (B+-tree leaves hold
+ *           pointers only).
+ */
+
+
+/**
+ * @brief (Private) Stable merge sort of 'items' by 'compare' ('tmp' has room for 'count').
+ */
+static void _sx_sort(void** items, void** tmp, int count, CompareFunc compare){
+    if(count < 2) return;
+    int half = count / 2;
+    _sx_sort(items, tmp, half, compare);
+    _sx_sort(items + half, tmp, count - half, compare);
+    int i = 0, j = half, k = 0;
+    while(i < half && j < count){
+        if(compare(items[j], items[i]) < 0) tmp[k++] = items[j++];
+        else tmp[k++] = items[i++];
+    }
+    while(i < half) tmp[k++] = items[i++];
+    while(j < count) tmp[k++] = items[j++];
+    memcpy(items, tmp, (size_t)count * sizeof(void*));
+}
+
+/**
+ * @brief Creates an empty set of indexes.
+ *
+ * @return A pointer to the new set, or NULL if memory fails.
+ */
+SecondaryIndexes* sx_create(void){
+    return (SecondaryIndexes*)calloc(1, sizeof(SecondaryIndexes));
+}
+
+/**
+ * @brief Frees every index and the set (not the indexed elements).
+ */
+void sx_free(SecondaryIndexes* set){
+    if(set == NULL) return;
+    for(int slot = 0; slot < SX_MAX_INDEXES; slot++) bpt_free(set->trees[slot]);
+    free(set);
+}
+
+/**
+ * @brief Adds an index over the container's current elements.
+ *
+ * @param set The set to add to.
+ * @param compare_func The index's ordering. It must be total: elements
+ * that compare equal are rejected (break ties by id).
+ * @param items The container's elements, in any order (not modified).
+ * @param count Number of elements.
+ * @return The new index's slot, or -1 if every slot is taken, two
+ * elements compare equal, or memory fails.
+ */
+int sx_add(SecondaryIndexes* set, CompareFunc compare_func, void** items, int count){
+    if(set == NULL || compare_func == NULL || count < 0 || (count > 0 && items == NULL)) return -1;
+    int slot = 0;
+    while(slot < SX_MAX_INDEXES && set->trees[slot] != NULL) slot++;
+    if(slot == SX_MAX_INDEXES){
+        fprintf(stderr, "Error: a container can't have more than %d secondary indexes\n", SX_MAX_INDEXES);
+        return -1;
+    }
+    BPlusTree* tree = bpt_create(compare_func);
+    void** sorted = (void**)malloc(((size_t)count * 2 + 1) * sizeof(void*));
+    if(tree == NULL || sorted == NULL){
+        bpt_free(tree);
+        free(sorted);
+        return -1;
+    }
+    memcpy(sorted, items, (size_t)count * sizeof(void*));
+    _sx_sort(sorted, sorted + count, count, compare_func);
+    int loaded = bpt_bulk_load(tree, sorted, count);
+    free(sorted);
+    if(!loaded){
+        fprintf(stderr, "Error: couldn't build the index (elements comparing equal, or out of memory)\n");
+        bpt_free(tree);
+        return -1;
+    }
+    set->trees[slot] = tree;
+    return slot;
+}
+
+/**
+ * @brief Drops the index in 'slot'.
+ *
+ * @return 1 if there was an index there, 0 otherwise.
+ */
+int sx_drop(SecondaryIndexes* set, int slot){
+    if(set == NULL || slot < 0 || slot >= SX_MAX_INDEXES || set->trees[slot] == NULL) return 0;
+    bpt_free(set->trees[slot]);
+    set->trees[slot] = NULL;
+    return 1;
+}
+
+/**
+ * @brief Number of indexes in the set.
+ */
+int sx_count(SecondaryIndexes* set){
+    int count = 0;
+    for(int slot = 0; set != NULL && slot < SX_MAX_INDEXES; slot++) count += set->trees[slot] != NULL;
+    return count;
+}
+
+/**
+ * @brief Adds elements to every index: all of them, or none.
+ *
+ * @param set The set to update.
+ * @param items The elements the container is inserting.
+ * @param count Number of elements.
+ * @return 1 on success, 0 if an index rejects an element (it compares
+ * equal to one already indexed) or memory fails; the indexes are then
+ * left as they were.
+ */
+int sx_insert(SecondaryIndexes* set, void** items, int count){
+    if(set == NULL) return 1;
+    for(int slot = 0; slot < SX_MAX_INDEXES; slot++){
+        BPlusTree* tree = set->trees[slot];
+        if(tree == NULL) continue;
+        int inserted = 0;
+        while(inserted < count && bpt_insert(tree, items[inserted])) inserted++;
+        if(inserted == count) continue;
+        /* Undo this index, then every index before it */
+        while(inserted-- > 0) bpt_remove(tree, items[inserted]);
+        while(slot-- > 0){
+            for(int i = 0; set->trees[slot] != NULL && i < count; i++) bpt_remove(set->trees[slot], items[i]);
+        }
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Removes an element (the container's own pointer) from every index.
+ */
+void sx_remove(SecondaryIndexes* set, void* data){
+    if(set == NULL) return;
+    for(int slot = 0; slot < SX_MAX_INDEXES; slot++){
+        if(set->trees[slot] != NULL) bpt_remove(set->trees[slot], data);
+    }
+}
+
+/**
+ * @brief Visits, in the index's order, every element in the range [low, high).
+ *
+ * Bounds are templates compared with the index's CompareFunc. With a
+ * tie-breaking comparator, a bound with the smallest possible id (e.g.
+ * stock = 10, id = LONG_MIN) stands for "every element with stock >= 10".
+ *
+ * @param set The container's indexes.
+ * @param slot The index to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited (0 also for an empty slot).
+ */
+int sx_range(SecondaryIndexes* set, int slot, void* low, void* high, VisitFunc visit, void* context){
+    if(set == NULL || slot < 0 || slot >= SX_MAX_INDEXES) return 0;
+    return bpt_range(set->trees[slot], low, high, visit, context);
+}
+
+/*State of one sx_top scan*/
+typedef struct{
+    void** results;
+    int wanted;
+    int found;
+}SxTop;
+
+/**
+ * @brief (Private) Collects elements until 'wanted' are found.
+ */
+static int _sx_collect(void* data, void* context){
+    SxTop* top = (SxTop*)context;
+    top->results[top->found++] = data;
+    return top->found < top->wanted;
+}
+
+/**
+ * @brief Returns the k largest elements of an index, largest first.
+ *
+ * Walks the leaf chain backwards from the last element: O(log n + k).
+ * (For the k smallest, use sx_range with a visitor that stops after k.)
+ *
+ * @param set The container's indexes.
+ * @param slot The index to read.
+ * @param k Number of elements wanted.
+ * @param results [out] Buffer with room for 'k' pointers.
+ * @return The number of elements written (fewer than k if the container
+ * is smaller; 0 for an empty slot).
+ */
+int sx_top(SecondaryIndexes* set, int slot, int k, void** results){
+    if(set == NULL || slot < 0 || slot >= SX_MAX_INDEXES || k <= 0 || results == NULL) return 0;
+    SxTop top = {results, k, 0};
+    bpt_range_reverse(set->trees[slot], NULL, NULL, _sx_collect, &top);
+    return top.found;
+}
@@ -0,0 +1,225 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "skipList.h"
+
+/*
+ * skipList.c
+ *
+ * Implements a generic, dynamic ordered skip list: a sorted linked list
+ * where every node also carries a random number of "express lane"
+ * pointers that skip over many nodes at once.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH:   O(log n) expected - Descends the express lanes (sl_find).
+ * - INSERT:   O(log n) expected - Same descent, then O(level) re-wiring.
+ * - REMOVE:   O(log n) expected - Same descent, then O(level) re-wiring.
+ * - RANGE:    O(log n + k)      - Descend to 'low', then walk level 0.
+ * - MEMORY:   Dynamic. No capacity limit; on average 1.33 pointers per
+ *             node on top of the plain list (p = 1/4).
+ */
+
+
+/**
+ * @brief (Private) Draws the height of a new node.
+ *
+ * Each extra level is kept with probability 1/4 (xorshift64 generator,
+ * so runs are reproducible).
+ *
+ * @param list The list whose generator is used.
+ * @return A level in [1, SKIPLIST_MAX_LEVEL].
+ */
+static int _sl_random_level(SkipList* list){
+    unsigned long long x = list->rng_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    list->rng_state = x;
+    int level = 1;
+    while((x & 3) == 0 && level < SKIPLIST_MAX_LEVEL){
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+/**
+ * @brief (Private) Allocates a node with 'level' forward pointers.
+ */
+static SkipNode* _sl_node_create(void* data, int level){
+    SkipNode* node = (SkipNode*)malloc(sizeof(SkipNode) + (size_t)level * sizeof(SkipNode*));
+    if(node == NULL) return NULL;
+    node->data = data;
+    node->level = level;
+    for(int i = 0; i < level; i++) node->forward[i] = NULL;
+    return node;
+}
+
+/**
+ * @brief (Private) Finds the last node on each level that is < 'data'.
+ *
+ * This is the core of the module: every operation descends from the top
+ * level, moving right while the next element is smaller than 'data'.
+ *
+ * @param list The list to search in.
+ * @param data A "template" data object to search for.
+ * @param update [out] Optional. Receives the predecessor on every level.
+ * @return The level-0 predecessor (its forward[0] is the first node >= data).
+ */
+static SkipNode* _sl_find_predecessor(SkipList* list, void* data, SkipNode** update){
+    SkipNode* current = list->head;
+    for(int i = list->level - 1; i >= 0; i--){
+        while(current->forward[i] != NULL && list->compare(current->forward[i]->data, data) < 0){
+            current = current->forward[i];
+        }
+        if(update != NULL) update[i] = current;
+    }
+    return current;
+}
+
+/**
+ * @brief Creates a new, empty SkipList instance.
+ *
+ * @param compare_func A function pointer used to compare elements.
+ * @return A pointer to the new SkipList, or NULL if memory fails.
+ */
+SkipList* sl_create(CompareFunc compare_func){
+    SkipList* list = (SkipList*)malloc(sizeof(SkipList));
+    if(list == NULL) return NULL;
+    list->head = _sl_node_create(NULL, SKIPLIST_MAX_LEVEL);
+    if(list->head == NULL){
+        free(list);
+        return NULL;
+    }
+    list->level = 1;
+    list->counter = 0;
+    list->compare = compare_func;
+    list->rng_state = 0x2545F4914F6CDD1Dull;
+    return list;
+}
+
+/**
+ * @brief Frees all memory associated with the SkipList.
+ *
+ * Note: This does NOT free the actual data pointed to by the nodes.
+ * That is the caller's responsibility.
+ *
+ * @param list The SkipList to free.
+ */
+void sl_free(SkipList* list){
+    if(list == NULL) return;
+    SkipNode* current = list->head;
+    while(current != NULL){
+        SkipNode* next = current->forward[0];
+        free(current);
+        current = next;
+    }
+    free(list);
+}
+
+/**
+ * @brief Finds an element in the list (expected O(log n)).
+ *
+ * @param list The list to search in.
+ * @param data_to_find A "template" data object to search for.
+ * @return A pointer to the data if found, or NULL otherwise.
+ */
+void* sl_find(SkipList* list, void* data_to_find){
+    if(list == NULL || list->counter == 0) return NULL;
+    SkipNode* candidate = _sl_find_predecessor(list, data_to_find, NULL)->forward[0];
+    if(candidate != NULL && list->compare(data_to_find, candidate->data) == 0) return candidate->data;
+    return NULL;
+}
+
+/**
+ * @brief Inserts a data element into the list, maintaining sort order.
+ *
+ * Like list_insert_sorted, duplicates are allowed; the new element is
+ * placed before any equal ones.
+ *
+ * @param list The list to insert into.
+ * @param data The data to insert.
+ * @return 1 on success, 0 on failure (list is NULL or malloc fails).
+ */
+int sl_insert_sorted(SkipList* list, void* data){
+    if(list == NULL) return 0;
+    SkipNode* update[SKIPLIST_MAX_LEVEL];
+    _sl_find_predecessor(list, data, update);
+    int level = _sl_random_level(list);
+    SkipNode* newNode = _sl_node_create(data, level);
+    if(newNode == NULL) return 0;
+    if(level > list->level){
+        for(int i = list->level; i < level; i++) update[i] = list->head;
+        list->level = level;
+    }
+    for(int i = 0; i < level; i++){
+        newNode->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = newNode;
+    }
+    list->counter++;
+    return 1;
+}
+
+/**
+ * @brief Removes a data element from the list.
+ *
+ * @param list The list to remove from.
+ * @param data_to_remove A "template" data object to find and remove.
+ * @return The pointer to the removed data (so the caller can free it),
+ * or NULL if the element was not found.
+ */
+void* sl_remove(SkipList* list, void* data_to_remove){
+    if(list == NULL || list->counter == 0) return NULL;
+    SkipNode* update[SKIPLIST_MAX_LEVEL];
+    SkipNode* target = _sl_find_predecessor(list, data_to_remove, update)->forward[0];
+    if(target == NULL || list->compare(data_to_remove, target->data) != 0) return NULL;
+    for(int i = 0; i < target->level; i++){
+        update[i]->forward[i] = target->forward[i];
+    }
+    while(list->level > 1 && list->head->forward[list->level - 1] == NULL) list->level--;
+    void* removed_data = target->data;
+    free(target);
+    list->counter--;
+    return removed_data;
+}
+
+/**
+ * @brief Prints all elements in the list to the console, in order.
+ *
+ * @param list The list to print.
+ * @param print_func The function that knows how to print a single element.
+ */
+void sl_print(SkipList* list, PrintFunc print_func){
+    if(list == NULL || print_func == NULL) return;
+    SkipNode* current = list->head->forward[0];
+    while(current != NULL){
+        print_func(current->data);
+        current = current->forward[0];
+    }
+}
+
+/**
+ * @brief Visits, in order, every element in the range [low, high).
+ *
+ * Descends to 'low' in expected O(log n) and then walks level 0, so the
+ * whole scan costs O(log n + k) for k visited elements.
+ *
+ * @param list The list to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int sl_range(SkipList* list, void* low, void* high, VisitFunc visit, void* context){
+    if(list == NULL || visit == NULL) return 0;
+    SkipNode* current = low != NULL ? _sl_find_predecessor(list, low, NULL)->forward[0]
+                                    : list->head->forward[0];
+    int visited = 0;
+    while(current != NULL){
+        if(high != NULL && list->compare(current->data, high) >= 0) break;
+        visited++;
+        if(!visit(current->data, context)) break;
+        current = current->forward[0];
+    }
+    return visited;
+}
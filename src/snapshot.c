@@ -0,0 +1,495 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "snapshot.h"
+#include "student.h"
+#include "product.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SNAP_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * snapshot.c
+ *
+ * Binary snapshots of the Student and Product containers. A snapshot is
+ * a 64-byte header followed by fixed-width records already sorted by id,
+ * then the names they point to, so opening one is a single mmap plus a
+ * header check: nothing is parsed, allocated or inserted, and lookups
+ * binary-search the mapped records in place. The header carries a magic
+ * string, a format version, a byte order tag, the record type and size,
+ * the size of the name area and a checksum of the whole file after the
+ * header (checked on open only when asked, since it reads the whole file).
+ *
+ * Writers go through a temporary file renamed over the target at the
+ * end, so a reader never sees a half-written snapshot.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - OPEN:   O(1) without verification, O(n) sequential read with it.
+ * - SEARCH: O(log n) over the mapped records.
+ * - UPDATE: Read-only. Write a new snapshot after changing the containers.
+ */
+
+#define SNAP_FNV_OFFSET 14695981039346656037ULL
+#define SNAP_FNV_PRIME 1099511628211ULL
+#define SNAP_LANES 4
+
+_Static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must stay 64 bytes");
+_Static_assert(sizeof(SnapStudent) % 8 == 0 && sizeof(SnapProduct) % 8 == 0, "records must be whole words");
+
+/*
+ * Checksum: FNV-1a over the records' 64-bit words, spread round-robin over
+ * SNAP_LANES independent hashes that are folded together at the end. The
+ * lanes have no dependency on each other, so verification runs at memory
+ * speed instead of one multiply per byte.
+ */
+typedef struct{
+    uint64_t lane[SNAP_LANES];
+    uint64_t words;
+}SnapChecksum;
+
+static void _snap_checksum_init(SnapChecksum* sum){
+    for(int i = 0; i < SNAP_LANES; i++) sum->lane[i] = SNAP_FNV_OFFSET + (uint64_t)i;
+    sum->words = 0;
+}
+
+/*'size' must be a multiple of 8 (both record sizes and the name area are)*/
+static void _snap_checksum_add(SnapChecksum* sum, const void* data, size_t size){
+    const unsigned char* bytes = (const unsigned char*)data;
+    size_t words = size / sizeof(uint64_t);
+    size_t i = 0;
+    while(i < words && (sum->words & (SNAP_LANES - 1)) != 0){
+        uint64_t word;
+        memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(word));
+        uint64_t* lane = &sum->lane[sum->words & (SNAP_LANES - 1)];
+        *lane = (*lane ^ word) * SNAP_FNV_PRIME;
+        sum->words++;
+        i++;
+    }
+    for(; i + SNAP_LANES <= words; i += SNAP_LANES){
+        for(int l = 0; l < SNAP_LANES; l++){
+            uint64_t word;
+            memcpy(&word, bytes + (i + (size_t)l) * sizeof(uint64_t), sizeof(word));
+            sum->lane[l] = (sum->lane[l] ^ word) * SNAP_FNV_PRIME;
+        }
+        sum->words += SNAP_LANES;
+    }
+    for(; i < words; i++){
+        uint64_t word;
+        memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(word));
+        uint64_t* lane = &sum->lane[sum->words & (SNAP_LANES - 1)];
+        *lane = (*lane ^ word) * SNAP_FNV_PRIME;
+        sum->words++;
+    }
+}
+
+static uint64_t _snap_checksum_final(const SnapChecksum* sum){
+    uint64_t hash = SNAP_FNV_OFFSET;
+    for(int i = 0; i < SNAP_LANES; i++) hash = (hash ^ sum->lane[i]) * SNAP_FNV_PRIME;
+    return (hash ^ sum->words) * SNAP_FNV_PRIME;
+}
+
+typedef struct{
+    FILE* file;
+    char* temp_path;
+    const char* path;
+    SnapshotHeader header;
+    SnapChecksum checksum;
+    int64_t last_id;
+    uint64_t names_reserved;    /*Name bytes promised by the records*/
+    uint64_t names_written;
+    unsigned char tail[8];  /*Name bytes not checksummed yet (less than a word)*/
+    size_t tail_used;
+    int failed;
+}SnapWriter;
+
+/**
+ * @brief (Private) Starts writing a snapshot into "<filename>.tmp".
+ *
+ * @return 1 on success, 0 if the file cannot be created or memory fails.
+ */
+static int _snap_begin(SnapWriter* writer, const char* filename, SnapshotType type, size_t record_size){
+    memset(writer, 0, sizeof(SnapWriter));
+    writer->path = filename;
+    writer->temp_path = (char*)malloc(strlen(filename) + 5);
+    if(writer->temp_path == NULL) return 0;
+    strcpy(writer->temp_path, filename);
+    strcat(writer->temp_path, ".tmp");
+    writer->file = fopen(writer->temp_path, "wb");
+    if(writer->file == NULL){
+        free(writer->temp_path);
+        return 0;
+    }
+    memcpy(writer->header.magic, SNAP_MAGIC, sizeof(writer->header.magic));
+    writer->header.version = SNAP_VERSION;
+    writer->header.endian_tag = SNAP_ENDIAN_TAG;
+    writer->header.record_type = (uint32_t)type;
+    writer->header.record_size = (uint32_t)record_size;
+    _snap_checksum_init(&writer->checksum);
+    /* Placeholder, rewritten with the final count and checksum */
+    if(fwrite(&writer->header, sizeof(SnapshotHeader), 1, writer->file) != 1) writer->failed = 1;
+    return 1;
+}
+
+/**
+ * @brief (Private) Appends one record. Ids must not decrease.
+ */
+static void _snap_put(SnapWriter* writer, const void* record, int64_t id){
+    if(writer->failed) return;
+    if(writer->header.count > 0 && id < writer->last_id){
+        writer->failed = 1;
+        return;
+    }
+    writer->last_id = id;
+    if(fwrite(record, writer->header.record_size, 1, writer->file) != 1){
+        writer->failed = 1;
+        return;
+    }
+    _snap_checksum_add(&writer->checksum, record, writer->header.record_size);
+    writer->header.count++;
+}
+
+/**
+ * @brief (Private) Reserves room for a name in the name area (first pass).
+ *
+ * @param offset [out] Where the name will start.
+ * @param length [out] Its length without the terminator.
+ */
+static void _snap_reserve_name(SnapWriter* writer, const char* name, uint64_t* offset, uint32_t* length){
+    size_t size = strlen(name);
+    if(size >= UINT32_MAX){
+        writer->failed = 1;
+        return;
+    }
+    *offset = writer->names_reserved;
+    *length = (uint32_t)size;
+    writer->names_reserved += size + 1;
+}
+
+/**
+ * @brief (Private) Appends raw bytes to the name area, checksumming them a word at a time.
+ */
+static void _snap_put_bytes(SnapWriter* writer, const void* data, size_t size){
+    if(writer->failed) return;
+    if(fwrite(data, 1, size, writer->file) != size){
+        writer->failed = 1;
+        return;
+    }
+    writer->names_written += size;
+    const unsigned char* bytes = (const unsigned char*)data;
+    while(size > 0){
+        size_t take = sizeof(writer->tail) - writer->tail_used;
+        if(take > size) take = size;
+        memcpy(writer->tail + writer->tail_used, bytes, take);
+        writer->tail_used += take;
+        bytes += take;
+        size -= take;
+        if(writer->tail_used == sizeof(writer->tail)){
+            _snap_checksum_add(&writer->checksum, writer->tail, sizeof(writer->tail));
+            writer->tail_used = 0;
+        }
+    }
+}
+
+/**
+ * @brief (Private) Appends one name and its terminator (second pass, same order as the records).
+ */
+static void _snap_put_name(SnapWriter* writer, const char* name){
+    _snap_put_bytes(writer, name, strlen(name) + 1);
+}
+
+/**
+ * @brief (Private) Pads the name area to whole words, finalizes the header and renames the file into place.
+ *
+ * @return 1 on success, 0 on any write error (the temporary file is removed).
+ */
+static int _snap_end(SnapWriter* writer){
+    static const unsigned char zeros[8] = {0};
+    /* The names written must be the ones the records point to */
+    if(writer->names_written != writer->names_reserved) writer->failed = 1;
+    if(writer->tail_used > 0) _snap_put_bytes(writer, zeros, sizeof(zeros) - writer->tail_used);
+    writer->header.names_size = writer->names_written;
+    if(!writer->failed){
+        writer->header.checksum = _snap_checksum_final(&writer->checksum);
+        if(fseek(writer->file, 0, SEEK_SET) != 0
+           || fwrite(&writer->header, sizeof(SnapshotHeader), 1, writer->file) != 1){
+            writer->failed = 1;
+        }
+    }
+    if(fclose(writer->file) != 0) writer->failed = 1;
+    if(!writer->failed && rename(writer->temp_path, writer->path) != 0) writer->failed = 1;
+    if(writer->failed) remove(writer->temp_path);
+    free(writer->temp_path);
+    return !writer->failed;
+}
+
+/**
+ * @brief Writes the students of an OrderedArray to a snapshot file.
+ *
+ * The array must be ordered by id (student_compare_by_id, or keyed mode
+ * with student_get_id); the write fails otherwise. Names are stored whole,
+ * whatever their length.
+ *
+ * @param filename The snapshot to create (replaced atomically if it exists).
+ * @param arr An OrderedArray of Student*.
+ * @return 1 on success, 0 on failure.
+ */
+int snap_write_students(const char* filename, OrderedArray* arr){
+    if(filename == NULL || arr == NULL) return 0;
+    SnapWriter writer;
+    if(!_snap_begin(&writer, filename, SNAP_STUDENTS, sizeof(SnapStudent))) return 0;
+    SnapStudent record;
+    for(int i = 0; i < arr->counter; i++){
+        Student* student = (Student*)arr->data[i];
+        memset(&record, 0, sizeof(record));
+        record.id = student->id;
+        record.gpa = student->gpa;
+        _snap_reserve_name(&writer, student->name, &record.name_offset, &record.name_length);
+        _snap_put(&writer, &record, record.id);
+    }
+    for(int i = 0; i < arr->counter; i++) _snap_put_name(&writer, ((Student*)arr->data[i])->name);
+    return _snap_end(&writer);
+}
+
+/**
+ * @brief Writes the products of a LinkedList to a snapshot file.
+ *
+ * The list must be ordered by id (product_compare_by_id, or keyed mode
+ * with product_get_id); the write fails otherwise. Names are stored whole,
+ * whatever their length.
+ *
+ * @param filename The snapshot to create (replaced atomically if it exists).
+ * @param list A LinkedList of Product*.
+ * @return 1 on success, 0 on failure.
+ */
+int snap_write_products(const char* filename, LinkedList* list){
+    if(filename == NULL || list == NULL) return 0;
+    SnapWriter writer;
+    if(!_snap_begin(&writer, filename, SNAP_PRODUCTS, sizeof(SnapProduct))) return 0;
+    SnapProduct record;
+    for(Node* node = list->head; node != NULL; node = node->next){
+        Product* product = (Product*)node->data;
+        memset(&record, 0, sizeof(record));
+        record.id = product->id;
+        record.stock = product->stock;
+        record.price = product->price;
+        record.cost = product->cost;
+        _snap_reserve_name(&writer, product->name, &record.name_offset, &record.name_length);
+        _snap_put(&writer, &record, record.id);
+    }
+    for(Node* node = list->head; node != NULL; node = node->next) _snap_put_name(&writer, ((Product*)node->data)->name);
+    return _snap_end(&writer);
+}
+
+/**
+ * @brief (Private) Maps the file read-only, or reads it into a heap buffer.
+ *
+ * @return 1 on success, 0 if the file cannot be opened or read.
+ */
+static int _snap_map(Snapshot* snap, const char* filename){
+#ifdef SNAP_HAVE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return 0;
+    struct stat info;
+    if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0){
+        void* map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED){
+            close(fd);
+            snap->base = map;
+            snap->size = (size_t)info.st_size;
+            snap->mapped = 1;
+            return 1;
+        }
+    }
+    close(fd);
+#endif
+    FILE* file = fopen(filename, "rb");
+    if(file == NULL) return 0;
+    long size = -1;
+    if(fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    if(size <= 0 || fseek(file, 0, SEEK_SET) != 0){
+        fclose(file);
+        return 0;
+    }
+    snap->base = malloc((size_t)size);
+    if(snap->base == NULL || fread(snap->base, 1, (size_t)size, file) != (size_t)size){
+        free(snap->base);
+        snap->base = NULL;
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+    snap->size = (size_t)size;
+    snap->mapped = 0;
+    return 1;
+}
+
+/**
+ * @brief Opens a snapshot for in-place queries.
+ *
+ * Checks the magic string, version, byte order, record type and size,
+ * and that the file holds exactly 'count' records and the name area.
+ * With 'verify' it also recomputes the checksum, which reads every
+ * record and name.
+ *
+ * @param filename The snapshot file.
+ * @param type The record type expected (SNAP_STUDENTS or SNAP_PRODUCTS).
+ * @param verify 1 to check the checksum, 0 to trust the file.
+ * @return A pointer to the open Snapshot, or NULL if the file is missing,
+ * invalid or corrupted, or if memory fails.
+ */
+Snapshot* snap_open(const char* filename, SnapshotType type, int verify){
+    if(filename == NULL) return NULL;
+    Snapshot* snap = (Snapshot*)calloc(1, sizeof(Snapshot));
+    if(snap == NULL) return NULL;
+    if(!_snap_map(snap, filename)){
+        free(snap);
+        return NULL;
+    }
+    const SnapshotHeader* header = (const SnapshotHeader*)snap->base;
+    size_t expected = type == SNAP_STUDENTS ? sizeof(SnapStudent) : sizeof(SnapProduct);
+    int valid = snap->size >= sizeof(SnapshotHeader)
+                && memcmp(header->magic, SNAP_MAGIC, sizeof(header->magic)) == 0
+                && header->version == SNAP_VERSION
+                && header->endian_tag == SNAP_ENDIAN_TAG
+                && header->record_type == (uint32_t)type
+                && header->record_size == expected
+                && header->names_size % 8 == 0
+                && header->count <= (snap->size - sizeof(SnapshotHeader)) / expected
+                && snap->size - sizeof(SnapshotHeader) - header->count * expected == header->names_size;
+    if(valid){
+        snap->header = header;
+        snap->records = (const unsigned char*)snap->base + sizeof(SnapshotHeader);
+        snap->count = (size_t)header->count;
+        snap->record_size = expected;
+        snap->names = (const char*)snap->records + snap->count * expected;
+        snap->names_size = (size_t)header->names_size;
+    }
+    if(!valid || (verify && !snap_verify(snap))){
+        snap_close(snap);
+        return NULL;
+    }
+    return snap;
+}
+
+/**
+ * @brief Unmaps the snapshot. Records obtained from it become invalid.
+ */
+void snap_close(Snapshot* snap){
+    if(snap == NULL) return;
+#ifdef SNAP_HAVE_MMAP
+    if(snap->mapped) munmap(snap->base, snap->size);
+    else free(snap->base);
+#else
+    free(snap->base);
+#endif
+    free(snap);
+}
+
+/**
+ * @brief Recomputes the records' checksum and compares it with the header.
+ *
+ * @return 1 if they match, 0 otherwise.
+ */
+int snap_verify(Snapshot* snap){
+    if(snap == NULL || snap->header == NULL) return 0;
+    SnapChecksum sum;
+    _snap_checksum_init(&sum);
+    _snap_checksum_add(&sum, snap->records, snap->count * snap->record_size);
+    _snap_checksum_add(&sum, snap->names, snap->names_size);
+    return _snap_checksum_final(&sum) == snap->header->checksum;
+}
+
+/**
+ * @brief (Private) Binary search for the first record with 'id' (ids are at offset 0).
+ */
+static const void* _snap_find(Snapshot* snap, long id){
+    size_t low = 0;
+    size_t high = snap->count;
+    while(low < high){
+        size_t mid = low + (high - low) / 2;
+        int64_t mid_id = *(const int64_t*)(snap->records + mid * snap->record_size);
+        if(mid_id < id) low = mid + 1;
+        else high = mid;
+    }
+    if(low < snap->count && *(const int64_t*)(snap->records + low * snap->record_size) == id){
+        return snap->records + low * snap->record_size;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns the record at 'index' (in id order) of a student snapshot.
+ *
+ * @return The record, or NULL if out of range or not a student snapshot.
+ */
+const SnapStudent* snap_student_at(Snapshot* snap, size_t index){
+    if(snap == NULL || snap->header->record_type != SNAP_STUDENTS || index >= snap->count) return NULL;
+    return (const SnapStudent*)(snap->records + index * snap->record_size);
+}
+
+/**
+ * @brief Returns the record at 'index' (in id order) of a product snapshot.
+ *
+ * @return The record, or NULL if out of range or not a product snapshot.
+ */
+const SnapProduct* snap_product_at(Snapshot* snap, size_t index){
+    if(snap == NULL || snap->header->record_type != SNAP_PRODUCTS || index >= snap->count) return NULL;
+    return (const SnapProduct*)(snap->records + index * snap->record_size);
+}
+
+/**
+ * @brief Finds a student by id directly in the mapped file.
+ *
+ * @return The record, or NULL if not found.
+ */
+const SnapStudent* snap_find_student(Snapshot* snap, long id){
+    if(snap == NULL || snap->header->record_type != SNAP_STUDENTS) return NULL;
+    return (const SnapStudent*)_snap_find(snap, id);
+}
+
+/**
+ * @brief Finds a product by id directly in the mapped file (the first one if ids repeat).
+ *
+ * @return The record, or NULL if not found.
+ */
+const SnapProduct* snap_find_product(Snapshot* snap, long id){
+    if(snap == NULL || snap->header->record_type != SNAP_PRODUCTS) return NULL;
+    return (const SnapProduct*)_snap_find(snap, id);
+}
+
+/**
+ * @brief (Private) Name at 'offset' in the name area, if it fits and is terminated where the record says.
+ */
+static const char* _snap_name(Snapshot* snap, uint64_t offset, uint32_t length){
+    if(offset >= snap->names_size || length >= snap->names_size - offset) return NULL;
+    if(snap->names[offset + length] != '\0') return NULL;
+    return snap->names + offset;
+}
+
+/**
+ * @brief Returns the name of a record of a student snapshot, read in place.
+ *
+ * @return The NUL-terminated name, valid until snap_close, or NULL if the
+ * record does not point inside the name area (a corrupted file).
+ */
+const char* snap_student_name(Snapshot* snap, const SnapStudent* record){
+    if(snap == NULL || record == NULL || snap->header->record_type != SNAP_STUDENTS) return NULL;
+    return _snap_name(snap, record->name_offset, record->name_length);
+}
+
+/**
+ * @brief Returns the name of a record of a product snapshot, read in place.
+ *
+ * @return The NUL-terminated name, valid until snap_close, or NULL if the
+ * record does not point inside the name area (a corrupted file).
+ */
+const char* snap_product_name(Snapshot* snap, const SnapProduct* record){
+    if(snap == NULL || record == NULL || snap->header->record_type != SNAP_PRODUCTS) return NULL;
+    return _snap_name(snap, record->name_offset, record->name_length);
+}
@@ -2,12 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include "student.h"
+#include "recordArena.h"
 
 /**
  * @brief Creates a new Student instance on the heap.
  *
- * Allocates memory for a Student structure and initializes it
- * with the provided values.
+ * Allocates the Student structure and a copy of its name with a single
+ * malloc (the name is stored right after the struct, sized to fit), and
+ * initializes it with the provided values.
  *
  * @param id The student's unique ID.
  * @param name The student's name.
@@ -16,11 +18,36 @@
  * memory allocation fails.
  */
 Student* student_create(long int id, const char* name, float gpa){
-    Student* A = (Student *)malloc(sizeof(Student));
+    size_t length = strlen(name) + 1;
+    Student* A = (Student *)malloc(sizeof(Student) + length);
     if(A == NULL) return NULL;
     A->id = id;
     A->gpa = gpa;
-    strcpy(A->name, name);
+    A->name = memcpy(A + 1, name, length);
+    return A;
+}
+
+/**
+ * @brief Creates a new Student instance in a RecordArena.
+ *
+ * The struct is carved out of the arena and the name is interned there,
+ * so students sharing a name share its bytes. Do not call student_free
+ * on it: ra_free releases it with the rest of the arena.
+ *
+ * @param arena The arena that owns the database's records.
+ * @param id The student's unique ID.
+ * @param name The student's name.
+ * @param gpa The student's Grade Point Average.
+ * @return A pointer to the newly created Student, or NULL if
+ * memory allocation fails.
+ */
+Student* student_create_in(struct RecordArena* arena, long int id, const char* name, float gpa){
+    const char* interned = ra_intern(arena, name);
+    Student* A = interned != NULL ? (Student*)ra_alloc(arena, sizeof(Student)) : NULL;
+    if(A == NULL) return NULL;
+    A->id = id;
+    A->gpa = gpa;
+    A->name = interned;
     return A;
 }
 
@@ -75,3 +102,50 @@ int student_compare_by_id(void* studentA, void* studentB){
     }
     else return 1;
 }
+
+/**
+ * @brief Compares two Student instances by GPA, then by ID.
+ *
+ * Ordering for a secondary index (oa_add_index, list_add_index): the ID
+ * breaks ties, so two different students never compare equal. A
+ * template with id = LONG_MIN is a bound just below every student with
+ * that GPA.
+ *
+ * @param studentA A void pointer to the first Student.
+ * @param studentB A void pointer to the second Student.
+ * @return < 0, 0 or > 0 as A sorts before, with or after B.
+ */
+int student_compare_by_gpa(void* studentA, void* studentB){
+    Student* A = (Student*)studentA;
+    Student* B = (Student*)studentB;
+    if(A->gpa != B->gpa) return A->gpa < B->gpa ? -1 : 1;
+    return student_compare_by_id(studentA, studentB);
+}
+
+/**
+ * @brief Compares two Student instances by name, then by ID.
+ *
+ * @param studentA A void pointer to the first Student.
+ * @param studentB A void pointer to the second Student.
+ * @return < 0, 0 or > 0 as A sorts before, with or after B.
+ */
+int student_compare_by_name(void* studentA, void* studentB){
+    Student* A = (Student*)studentA;
+    Student* B = (Student*)studentB;
+    int order = strcmp(A->name, B->name);
+    if(order != 0) return order;
+    return student_compare_by_id(studentA, studentB);
+}
+
+/**
+ * @brief Returns the ID of a Student.
+ *
+ * This function is compatible with the 'KeyFunc' typedef
+ * (long (*)(void*)) used by the keyed mode of the data structures.
+ *
+ * @param data A void pointer to the Student instance.
+ * @return The student's ID.
+ */
+long student_get_id(void* data){
+    return ((Student*)data)->id;
+}
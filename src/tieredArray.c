@@ -0,0 +1,342 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "tieredArray.h"
+
+/*
+ * tieredArray.c
+ *
+ * Implements a generic ordered array stored as a tiered vector: a row of
+ * fixed-size sorted blocks, each one a ring buffer. It keeps the
+ * OrderedArray interface (binary search with the CompareFunc, unique
+ * elements, O(1) access by position) but bounds how much an insert or
+ * remove has to move.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH: O(log n) - Binary search over positions. Position i is found
+ *           in O(1) (block i / B, slot heads[block] + i % B), at the cost
+ *           of one extra memory access per probe compared with a flat array.
+ * - INSERT: O(sqrt n) - Inside the target block, at most B / 2 pointers
+ *           move (whichever side of the insertion point is shorter). The
+ *           element pushed out of the block's end goes to the front of the
+ *           next block, which pushes out its own last element, and so on:
+ *           O(1) per block thanks to the rings, n / B blocks. With B kept
+ *           near sqrt(n) that is O(sqrt n) moves, against n / 2 for
+ *           OrderedArray.
+ * - REMOVE: O(sqrt n) - The mirror image: close the gap in the block, then
+ *           every later block hands its first element to the previous one.
+ * - MEMORY: One block of slots plus one int (ring head) per B elements.
+ *           B doubles (one O(n) rebuild) whenever n exceeds 2 * B^2, so
+ *           rebuilds are amortized O(1) per insert. Blocks are never given
+ *           back on removal, like a fixed-capacity OrderedArray.
+ */
+
+
+/**
+ * @brief (Private) Returns the slot holding the element at 'index'.
+ */
+static void** _ta_at(TieredArray* ta, int index){
+    int block = index >> ta->block_shift;
+    int mask = ta->block_size - 1;
+    return ta->storage + ((size_t)block << ta->block_shift) + ((ta->heads[block] + (index & mask)) & mask);
+}
+
+/**
+ * @brief (Private) Finds an element or its insertion point using binary search.
+ *
+ * @param ta The array to search in.
+ * @param data_to_find A "template" element holding the key.
+ * @param pFound [out] Set to 1 if found, 0 otherwise.
+ * @return The index of the element, or the index where it should be inserted.
+ */
+static int _ta_find_index(TieredArray* ta, void* data_to_find, int* pFound){
+    int low = 0;
+    int high = ta->counter - 1;
+    while(low <= high){
+        int mid = (low + high) / 2;
+        int comparison = ta->compare(data_to_find, *_ta_at(ta, mid));
+        if(comparison == 0){
+            *pFound = 1;
+            return mid;
+        }
+        else if(comparison < 0) high = mid - 1;
+        else low = mid + 1;
+    }
+    *pFound = 0;
+    return low;
+}
+
+/**
+ * @brief (Private) Re-lays out every element in blocks of 'block_size'.
+ *
+ * @return 1 on success, 0 if memory fails (the array is left unchanged).
+ */
+static int _ta_rebuild(TieredArray* ta, int block_size, int block_count){
+    void** storage = (void**)malloc((size_t)block_count * (size_t)block_size * sizeof(void*));
+    int* heads = (int*)calloc((size_t)block_count, sizeof(int));
+    if(storage == NULL || heads == NULL){
+        free(storage);
+        free(heads);
+        return 0;
+    }
+    for(int i = 0; i < ta->counter; i++) storage[i] = *_ta_at(ta, i);
+    free(ta->storage);
+    free(ta->heads);
+    ta->storage = storage;
+    ta->heads = heads;
+    ta->block_size = block_size;
+    ta->block_shift = 0;
+    while((1 << ta->block_shift) < block_size) ta->block_shift++;
+    ta->block_count = block_count;
+    return 1;
+}
+
+/**
+ * @brief (Private) Makes room for one more element.
+ *
+ * Doubles the block size once n > 2 * B^2 (keeping B near sqrt(n)),
+ * otherwise doubles the number of blocks when they are all full.
+ *
+ * @return 1 on success, 0 if memory fails.
+ */
+static int _ta_reserve_one(TieredArray* ta){
+    long needed = (long)ta->counter + 1;
+    long block_size = ta->block_size;
+    if(needed > 2 * block_size * block_size){
+        int new_size = ta->block_size * 2;
+        return _ta_rebuild(ta, new_size, 2 * (int)((needed + new_size - 1) / new_size));
+    }
+    if(needed <= (long)ta->block_count * block_size) return 1;
+    int block_count = ta->block_count * 2;
+    void** storage = (void**)realloc(ta->storage, (size_t)block_count * (size_t)ta->block_size * sizeof(void*));
+    if(storage == NULL) return 0;
+    ta->storage = storage;
+    int* heads = (int*)realloc(ta->heads, (size_t)block_count * sizeof(int));
+    if(heads == NULL) return 0;
+    for(int b = ta->block_count; b < block_count; b++) heads[b] = 0;
+    ta->heads = heads;
+    ta->block_count = block_count;
+    return 1;
+}
+
+/**
+ * @brief (Private) Inserts 'data' at 'offset' of a block holding 'count' < B elements.
+ *
+ * Shifts whichever side of 'offset' is shorter: the tail one slot right,
+ * or the head one slot left into the free slot before the ring's start.
+ */
+static void _ta_block_insert(TieredArray* ta, int block, int count, int offset, void* data){
+    void** slots = ta->storage + ((size_t)block << ta->block_shift);
+    int mask = ta->block_size - 1;
+    int head = ta->heads[block];
+    if(offset < count - offset){
+        head = (head - 1) & mask;
+        for(int i = 0; i < offset; i++) slots[(head + i) & mask] = slots[(head + i + 1) & mask];
+        ta->heads[block] = head;
+    }
+    else{
+        for(int i = count; i > offset; i--) slots[(head + i) & mask] = slots[(head + i - 1) & mask];
+    }
+    slots[(head + offset) & mask] = data;
+}
+
+/**
+ * @brief (Private) Removes the element at 'offset' of a block holding 'count' elements.
+ *
+ * Closes the gap from the shorter side.
+ *
+ * @return The removed element.
+ */
+static void* _ta_block_remove(TieredArray* ta, int block, int count, int offset){
+    void** slots = ta->storage + ((size_t)block << ta->block_shift);
+    int mask = ta->block_size - 1;
+    int head = ta->heads[block];
+    void* removed = slots[(head + offset) & mask];
+    if(offset < count - 1 - offset){
+        for(int i = offset; i > 0; i--) slots[(head + i) & mask] = slots[(head + i - 1) & mask];
+        ta->heads[block] = (head + 1) & mask;
+    }
+    else{
+        for(int i = offset; i < count - 1; i++) slots[(head + i) & mask] = slots[(head + i + 1) & mask];
+    }
+    return removed;
+}
+
+
+/**
+ * @brief Creates a new, empty TieredArray.
+ *
+ * The array always grows on demand; 'expected_size' only picks the
+ * initial block size and number of blocks so that no rebuild is needed
+ * up to that size.
+ *
+ * @param expected_size Number of elements expected (may be 0).
+ * @param compare_func The function used to order the elements.
+ * @return A pointer to the new TieredArray, or NULL if memory fails.
+ */
+TieredArray* ta_create(int expected_size, CompareFunc compare_func){
+    if(compare_func == NULL) return NULL;
+    TieredArray* ta = (TieredArray*)malloc(sizeof(TieredArray));
+    if(ta == NULL) return NULL;
+    int block_size = TA_MIN_BLOCK;
+    while(2L * block_size * block_size < (long)expected_size) block_size *= 2;
+    int block_count = expected_size > 0 ? (expected_size + block_size - 1) / block_size : 1;
+    ta->storage = NULL;
+    ta->heads = NULL;
+    ta->counter = 0;
+    ta->compare = compare_func;
+    if(!_ta_rebuild(ta, block_size, block_count)){
+        free(ta);
+        return NULL;
+    }
+    return ta;
+}
+
+/**
+ * @brief Frees the array's memory (not the elements).
+ *
+ * @param ta The array to free.
+ */
+void ta_free(TieredArray* ta){
+    if(ta == NULL) return;
+    free(ta->storage);
+    free(ta->heads);
+    free(ta);
+}
+
+/**
+ * @brief Finds an element using binary search. O(log n).
+ *
+ * @param ta The array to search in.
+ * @param data_to_find A "template" element holding the key.
+ * @return A pointer to the data if found, or NULL otherwise.
+ */
+void* ta_find(TieredArray* ta, void* data_to_find){
+    if(ta == NULL || ta->counter == 0) return NULL;
+    int found_status = 0;
+    int index = _ta_find_index(ta, data_to_find, &found_status);
+    return found_status ? *_ta_at(ta, index) : NULL;
+}
+
+/**
+ * @brief Returns the element at position 'index' in sort order. O(1).
+ *
+ * @param ta The array to read.
+ * @param index Position, from 0 to counter - 1.
+ * @return The element, or NULL if 'index' is out of range.
+ */
+void* ta_get(TieredArray* ta, int index){
+    if(ta == NULL || index < 0 || index >= ta->counter) return NULL;
+    return *_ta_at(ta, index);
+}
+
+/**
+ * @brief Inserts an element in order. O(log n) search + O(sqrt n) moves.
+ *
+ * @param ta The array to insert into.
+ * @param data The element to insert.
+ * @return 1 on success, 0 if an equal element is present or memory fails.
+ */
+int ta_insert_sorted(TieredArray* ta, void* data){
+    if(ta == NULL) return 0;
+    int found_status = 0;
+    int index = _ta_find_index(ta, data, &found_status);
+    if(found_status == 1) return 0;
+    if(!_ta_reserve_one(ta)) return 0;
+    int size = ta->block_size;
+    int last = ta->counter >> ta->block_shift;       /*Block that receives the new last position*/
+    int last_count = ta->counter - (last << ta->block_shift);
+    int block = index >> ta->block_shift;
+    int offset = index & (size - 1);
+    if(last_count == 0) ta->heads[last] = 0;
+    if(block == last){
+        _ta_block_insert(ta, last, last_count, offset, data);
+    }
+    else{
+        /* full block: drop its last element, insert, then pass the carry along */
+        void* carry = *_ta_at(ta, (block << ta->block_shift) + size - 1);
+        _ta_block_insert(ta, block, size - 1, offset, data);
+        for(int b = block + 1; b < last; b++){
+            void** slots = ta->storage + ((size_t)b << ta->block_shift);
+            int head = (ta->heads[b] - 1) & (size - 1);
+            void* next_carry = slots[head];
+            slots[head] = carry;
+            ta->heads[b] = head;
+            carry = next_carry;
+        }
+        _ta_block_insert(ta, last, last_count, 0, carry);
+    }
+    ta->counter++;
+    return 1;
+}
+
+/**
+ * @brief Removes an element. O(log n) search + O(sqrt n) moves.
+ *
+ * @param ta The array to remove from.
+ * @param data_to_remove A "template" element holding the key.
+ * @return The removed element (to be freed by the caller), or NULL.
+ */
+void* ta_remove(TieredArray* ta, void* data_to_remove){
+    if(ta == NULL || ta->counter == 0) return NULL;
+    int found_status = 0;
+    int index = _ta_find_index(ta, data_to_remove, &found_status);
+    if(found_status == 0) return NULL;
+    int size = ta->block_size;
+    int mask = size - 1;
+    int last = (ta->counter - 1) >> ta->block_shift;
+    int last_count = ta->counter - (last << ta->block_shift);
+    int block = index >> ta->block_shift;
+    void* removed;
+    if(block == last){
+        removed = _ta_block_remove(ta, last, last_count, index & mask);
+    }
+    else{
+        removed = _ta_block_remove(ta, block, size, index & mask);
+        /* every later block hands its first element to the previous one */
+        for(int b = block; b < last; b++){
+            void** slots = ta->storage + ((size_t)b << ta->block_shift);
+            void** next_slots = slots + size;
+            slots[(ta->heads[b] + size - 1) & mask] = next_slots[ta->heads[b + 1]];
+            ta->heads[b + 1] = (ta->heads[b + 1] + 1) & mask;
+        }
+    }
+    ta->counter--;
+    return removed;
+}
+
+/**
+ * @brief Prints all elements in the array to the console.
+ *
+ * @param ta The array to print.
+ * @param print_func The function that knows how to print a single element.
+ */
+void ta_print(TieredArray* ta, PrintFunc print_func){
+    if(ta == NULL || print_func == NULL) return;
+    printf("\n-----Tiered Array----- (Blocks: %d x %d, Count: %d)\n", ta->block_count, ta->block_size, ta->counter);
+    if(ta->counter == 0) printf("Empty array.\n");
+    for(int i = 0; i < ta->counter; i++) print_func(*_ta_at(ta, i));
+    printf("-----End of Array-----\n");
+}
+
+/**
+ * @brief Visits, in order, every element in the range [low, high). O(log n + k).
+ *
+ * @param ta The array to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int ta_range(TieredArray* ta, void* low, void* high, VisitFunc visit, void* context){
+    if(ta == NULL || visit == NULL || ta->counter == 0) return 0;
+    int found_status = 0;
+    int first = low != NULL ? _ta_find_index(ta, low, &found_status) : 0;
+    int end = high != NULL ? _ta_find_index(ta, high, &found_status) : ta->counter;
+    int visited = 0;
+    for(int i = first; i < end; i++){
+        visited++;
+        if(!visit(*_ta_at(ta, i), context)) break;
+    }
+    return visited;
+}
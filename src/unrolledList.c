@@ -0,0 +1,297 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "unrolledList.h"
+
+#if defined(__GNUC__)
+#define UL_PREFETCH(address) __builtin_prefetch((const void*)(address))
+#else
+#define UL_PREFETCH(address) ((void)0)
+#endif
+
+/*
+ * unrolledList.c
+ *
+ * Implements a generic ordered unrolled linked list: a singly-linked list
+ * whose nodes each hold a small sorted array of up to UL_NODE_CAPACITY
+ * elements. It offers the LinkedList interface (sorted insert, duplicates
+ * allowed and inserted before their equals, find, remove of the first
+ * match, range scans) with far fewer nodes to chase.
+ *
+ * TRADE-OFF ANALYSIS:
+ * - SEARCH: O(n / B + log B) - A node is skipped with a single comparison
+ *           against its last element, so a search follows about n / B
+ *           pointers (B = elements per node) instead of n, then
+ *           binary-searches one node.
+ * - INSERT: O(n / B + B) - Same walk, then a shift inside one node. A full
+ *           node is split in two halves, also when appending past either
+ *           end, so every node but a lone one stays at least half full.
+ * - REMOVE: O(n / B + B) - Same walk and shift. A node that falls below
+ *           half full merges with its successor (the last node: with its
+ *           predecessor), or borrows from it if both do not fit in one
+ *           node. Empty nodes are freed.
+ * - RANGE:  O(n / B + k) - ul_range walks nodes to 'low', then scans
+ *           elements in place.
+ * - MEMORY: Dynamic. One malloc per node, not per element: 128 bytes per
+ *           node, i.e. 9 to 18 bytes per element instead of LinkedList's 24.
+ */
+
+
+/**
+ * @brief (Private) Allocates an empty node.
+ *
+ * @return The node, or NULL if memory fails.
+ */
+static ULNode* _ul_new_node(UnrolledList* list){
+    ULNode* node = (ULNode*)malloc(sizeof(ULNode));
+    if(node == NULL) return NULL;
+    node->next = NULL;
+    node->count = 0;
+    list->node_count++;
+    return node;
+}
+
+/**
+ * @brief (Private) Finds the node that holds 'data' or where it belongs.
+ *
+ * Skips every node whose last element is smaller than 'data', comparing
+ * only that last element, and prefetches the next node meanwhile.
+ *
+ * @param list The list to search in.
+ * @param data A "template" element holding the key.
+ * @param pPrevious [out] Optional. Receives the node before the result (NULL for the head).
+ * @return The first node whose last element is >= 'data', the last node
+ * if there is none, or NULL if the list is empty.
+ */
+static ULNode* _ul_find_node(UnrolledList* list, void* data, ULNode** pPrevious){
+    ULNode* previous = NULL;
+    ULNode* node = list->head;
+    while(node != NULL && node->next != NULL){
+        UL_PREFETCH(node->next);
+        if(list->compare(data, node->items[node->count - 1]) <= 0) break;
+        previous = node;
+        node = node->next;
+    }
+    if(pPrevious != NULL) *pPrevious = previous;
+    return node;
+}
+
+/**
+ * @brief (Private) Binary search inside one node.
+ *
+ * @return The first position whose element is >= 'data' (node->count if none).
+ */
+static int _ul_lower_bound(UnrolledList* list, ULNode* node, void* data){
+    int low = 0;
+    int high = node->count;
+    while(low < high){
+        int mid = (low + high) / 2;
+        if(list->compare(data, node->items[mid]) > 0) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief (Private) Refills a node that dropped below half capacity from a neighbour.
+ *
+ * Uses its successor, or its predecessor for the last node. Merges the
+ * two when they fit in one node, otherwise moves elements over until the
+ * two are balanced. Only a lone node may stay below half.
+ *
+ * @param previous The node before 'node' (NULL for the head).
+ */
+static void _ul_rebalance(UnrolledList* list, ULNode* node, ULNode* previous){
+    if(node->count >= UL_NODE_CAPACITY / 2) return;
+    ULNode* next = node->next;
+    if(next == NULL){
+        if(previous == NULL) return;
+        if(previous->count + node->count <= UL_NODE_CAPACITY){
+            memcpy(&previous->items[previous->count], node->items, (size_t)node->count * sizeof(void*));
+            previous->count += node->count;
+            previous->next = NULL;
+            free(node);
+            list->node_count--;
+            return;
+        }
+        int moved = (previous->count - node->count) / 2;
+        memmove(&node->items[moved], node->items, (size_t)node->count * sizeof(void*));
+        memcpy(node->items, &previous->items[previous->count - moved], (size_t)moved * sizeof(void*));
+        previous->count -= moved;
+        node->count += moved;
+        return;
+    }
+    if(node->count + next->count <= UL_NODE_CAPACITY){
+        memcpy(&node->items[node->count], next->items, (size_t)next->count * sizeof(void*));
+        node->count += next->count;
+        node->next = next->next;
+        free(next);
+        list->node_count--;
+        return;
+    }
+    int moved = (next->count - node->count) / 2;
+    memcpy(&node->items[node->count], next->items, (size_t)moved * sizeof(void*));
+    memmove(next->items, &next->items[moved], (size_t)(next->count - moved) * sizeof(void*));
+    node->count += moved;
+    next->count -= moved;
+}
+
+/**
+ * @brief Creates a new, empty UnrolledList instance.
+ *
+ * @param compare_func A function pointer used to compare elements.
+ * @return A pointer to the new UnrolledList, or NULL if memory fails.
+ */
+UnrolledList* ul_create(CompareFunc compare_func){
+    UnrolledList* list = (UnrolledList*)malloc(sizeof(UnrolledList));
+    if(list == NULL) return NULL;
+    list->head = NULL;
+    list->counter = 0;
+    list->node_count = 0;
+    list->compare = compare_func;
+    return list;
+}
+
+/**
+ * @brief Frees every node and the list itself.
+ *
+ * Note: This does NOT free the actual data pointed to by the nodes.
+ * That is the caller's responsibility.
+ *
+ * @param list The UnrolledList to free.
+ */
+void ul_free(UnrolledList* list){
+    if(list == NULL) return;
+    ULNode* node = list->head;
+    while(node != NULL){
+        ULNode* next = node->next;
+        free(node);
+        node = next;
+    }
+    free(list);
+}
+
+/**
+ * @brief Inserts a data element into the list, maintaining sort order.
+ *
+ * Like list_insert_sorted, duplicates are allowed and the new element
+ * goes before the elements that compare equal to it. A full node is split
+ * in two halves first, wherever the element goes, so no node is left
+ * less than half full.
+ *
+ * @param list The list to insert into.
+ * @param data The data to insert.
+ * @return 1 on success, 0 on failure (list is NULL or malloc fails).
+ */
+int ul_insert_sorted(UnrolledList* list, void* data){
+    if(list == NULL) return 0;
+    ULNode* node = _ul_find_node(list, data, NULL);
+    if(node == NULL){
+        node = _ul_new_node(list);
+        if(node == NULL) return 0;
+        list->head = node;
+    }
+    int index = _ul_lower_bound(list, node, data);
+    if(node->count == UL_NODE_CAPACITY){
+        ULNode* fresh = _ul_new_node(list);
+        if(fresh == NULL) return 0;
+        int half = UL_NODE_CAPACITY / 2;
+        memcpy(fresh->items, &node->items[half], (size_t)(UL_NODE_CAPACITY - half) * sizeof(void*));
+        fresh->count = UL_NODE_CAPACITY - half;
+        node->count = half;
+        fresh->next = node->next;
+        node->next = fresh;
+        if(index > half){
+            node = fresh;
+            index -= half;
+        }
+    }
+    memmove(&node->items[index + 1], &node->items[index], (size_t)(node->count - index) * sizeof(void*));
+    node->items[index] = data;
+    node->count++;
+    list->counter++;
+    return 1;
+}
+
+/**
+ * @brief Removes the first element equal to 'data_to_remove'.
+ *
+ * @param list The list to remove from.
+ * @param data_to_remove A "template" data object to find and remove.
+ * @return The pointer to the removed data (so the caller can free it),
+ * or NULL if the element was not found.
+ */
+void* ul_remove(UnrolledList* list, void* data_to_remove){
+    if(list == NULL) return NULL;
+    ULNode* previous = NULL;
+    ULNode* node = _ul_find_node(list, data_to_remove, &previous);
+    if(node == NULL) return NULL;
+    int index = _ul_lower_bound(list, node, data_to_remove);
+    if(index == node->count || list->compare(data_to_remove, node->items[index]) != 0) return NULL;
+    void* removed_data = node->items[index];
+    memmove(&node->items[index], &node->items[index + 1], (size_t)(node->count - index - 1) * sizeof(void*));
+    node->count--;
+    list->counter--;
+    if(node->count == 0){
+        if(previous != NULL) previous->next = node->next;
+        else list->head = node->next;
+        free(node);
+        list->node_count--;
+    }
+    else _ul_rebalance(list, node, previous);
+    return removed_data;
+}
+
+/**
+ * @brief Finds an element, comparing one element per node on the way.
+ *
+ * @param list The list to search in.
+ * @param data_to_find A "template" data object to search for.
+ * @return A pointer to the data if found, or NULL otherwise.
+ */
+void* ul_find(UnrolledList* list, void* data_to_find){
+    if(list == NULL) return NULL;
+    ULNode* node = _ul_find_node(list, data_to_find, NULL);
+    if(node == NULL) return NULL;
+    int index = _ul_lower_bound(list, node, data_to_find);
+    if(index < node->count && list->compare(data_to_find, node->items[index]) == 0) return node->items[index];
+    return NULL;
+}
+
+/**
+ * @brief Prints all elements in the list to the console, in order.
+ *
+ * @param list The list to print.
+ * @param print_func The function that knows how to print a single element.
+ */
+void ul_print(UnrolledList* list, PrintFunc print_func){
+    if(list == NULL || print_func == NULL) return;
+    for(ULNode* node = list->head; node != NULL; node = node->next){
+        for(int i = 0; i < node->count; i++) print_func(node->items[i]);
+    }
+}
+
+/**
+ * @brief Visits, in order, every element in the range [low, high).
+ *
+ * @param list The list to scan.
+ * @param low Inclusive lower bound template, or NULL to start at the first element.
+ * @param high Exclusive upper bound template, or NULL to run to the end.
+ * @param visit Called for each element; returning 0 stops the scan early.
+ * @param context Passed through to 'visit' untouched.
+ * @return The number of elements visited.
+ */
+int ul_range(UnrolledList* list, void* low, void* high, VisitFunc visit, void* context){
+    if(list == NULL || visit == NULL) return 0;
+    ULNode* node = low != NULL ? _ul_find_node(list, low, NULL) : list->head;
+    int index = (node != NULL && low != NULL) ? _ul_lower_bound(list, node, low) : 0;
+    int visited = 0;
+    for(; node != NULL; node = node->next, index = 0){
+        for(; index < node->count; index++){
+            if(high != NULL && list->compare(node->items[index], high) >= 0) return visited;
+            visited++;
+            if(!visit(node->items[index], context)) return visited;
+        }
+    }
+    return visited;
+}